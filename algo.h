@@ -0,0 +1,571 @@
+#ifndef MYTINYSTL_ALGO_H_
+#define MYTINYSTL_ALGO_H_
+
+// 这个头文件包含了 mystl 的排序算法 : is_sorted, sort, partial_sort, nth_element
+//
+// sort 使用 pattern-defeating quicksort (pdqsort)：
+// - 小区间 (少于 ESortInsertionThreshold 个元素) 使用插入排序
+// - 大区间用三数取中 (超过 ESortNintherThreshold 个元素时用九数取中) 选择枢轴
+// - 划分后如果区间已经有序 (没有发生交换)，尝试有限次数的插入排序，
+//   使有序、逆序等输入接近线性时间
+// - 与左侧枢轴相等的元素一次性划到左边，大量重复元素时也是线性时间
+// - 划分严重不平衡时打乱几个元素破坏输入的模式，不平衡次数超过 log2(n) 后改用堆排序，
+//   最坏情况为 O(n log n)
+// - 内置类型配合默认比较函数时使用无分支划分：先把需要交换的位置记到偏移缓冲区中，
+//   再批量交换，比较结果不影响分支预测
+//
+// sort 不是稳定排序。sort 根据 iterator_category 分派：随机访问迭代器就地排序，
+// 其他前向迭代器先移动到 vector 中排序，再移动回原区间。
+// partial_sort、nth_element 要求随机访问迭代器。
+
+#include <functional>
+
+#include "algobase.h"
+#include "heap_algo.h"
+#include "iterator.h"
+#include "simd.h"
+#include "util.h"
+#include "vector.h"
+
+namespace mystl {
+
+// clang-format off
+enum {
+    ESortInsertionThreshold   = 24,  // 小于这个长度的区间使用插入排序
+    ESortNintherThreshold     = 128, // 大于这个长度的区间使用九数取中
+    ESortPartialInsertLimit   = 8,   // 尝试插入排序时最多允许移动的元素个数
+    ESortBlockSize            = 64   // 无分支划分每一块的元素个数
+};
+// clang-format on
+
+/*****************************************************************************************/
+// is_sorted
+// 检查 [first, last) 是否按 comp 非降序排列
+/*****************************************************************************************/
+template <class ForwardIter, class Compare>
+MYSTL_CONSTEXPR20 bool is_sorted(ForwardIter first, ForwardIter last, Compare comp) {
+    if (first == last)
+        return true;
+    ForwardIter next = first;
+    while (++next != last) {
+        if (comp(*next, *first))
+            return false;
+        first = next;
+    }
+    return true;
+}
+
+template <class ForwardIter>
+MYSTL_CONSTEXPR20 bool is_sorted(ForwardIter first, ForwardIter last) {
+    return mystl::is_sorted(first, last, value_less());
+}
+
+/*****************************************************************************************/
+// sort 的辅助函数
+/*****************************************************************************************/
+
+// 内置算术类型配合默认的比较函数时使用无分支划分
+template <class Compare, class T>
+struct sort_is_branchless
+    : public m_bool_constant<std::is_arithmetic<T>::value &&
+                             (std::is_same<Compare, value_less>::value ||
+                                 std::is_same<Compare, std::less<T>>::value ||
+                                 std::is_same<Compare, std::greater<T>>::value
+#if __cplusplus >= 201402L
+                                 || std::is_same<Compare, std::less<>>::value ||
+                                 std::is_same<Compare, std::greater<>>::value
+#endif
+                                 )> {};
+
+template <class Size>
+MYSTL_CONSTEXPR20 int sort_log2(Size n) {
+    int k = 0;
+    while (n >>= 1) {
+        ++k;
+    }
+    return k;
+}
+
+// 插入排序
+template <class RandomIter, class Compare>
+MYSTL_CONSTEXPR20 void insertion_sort(RandomIter first, RandomIter last, Compare comp) {
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    if (first == last)
+        return;
+    for (RandomIter cur = first + 1; cur != last; ++cur) {
+        RandomIter hole = cur;
+        RandomIter prev = cur - 1;
+        if (comp(*hole, *prev)) {
+            value_type value(mystl::move(*hole));
+            do {
+                *hole-- = mystl::move(*prev);
+            } while (hole != first && comp(value, *--prev));
+            *hole = mystl::move(value);
+        }
+    }
+}
+
+// 插入排序，要求 first 之前存在一个不大于区间内任何元素的元素，省去边界检查
+template <class RandomIter, class Compare>
+MYSTL_CONSTEXPR20 void unguarded_insertion_sort(
+    RandomIter first, RandomIter last, Compare comp) {
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    if (first == last)
+        return;
+    for (RandomIter cur = first + 1; cur != last; ++cur) {
+        RandomIter hole = cur;
+        RandomIter prev = cur - 1;
+        if (comp(*hole, *prev)) {
+            value_type value(mystl::move(*hole));
+            do {
+                *hole-- = mystl::move(*prev);
+            } while (comp(value, *--prev));
+            *hole = mystl::move(value);
+        }
+    }
+}
+
+// 尝试插入排序，移动的元素超过 ESortPartialInsertLimit 个时放弃并返回 false
+template <class RandomIter, class Compare>
+MYSTL_CONSTEXPR20 bool partial_insertion_sort(
+    RandomIter first, RandomIter last, Compare comp) {
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    if (first == last)
+        return true;
+    size_t moved = 0;
+    for (RandomIter cur = first + 1; cur != last; ++cur) {
+        RandomIter hole = cur;
+        RandomIter prev = cur - 1;
+        if (comp(*hole, *prev)) {
+            value_type value(mystl::move(*hole));
+            do {
+                *hole-- = mystl::move(*prev);
+            } while (hole != first && comp(value, *--prev));
+            *hole = mystl::move(value);
+            moved += static_cast<size_t>(cur - hole);
+        }
+        if (moved > static_cast<size_t>(ESortPartialInsertLimit))
+            return false;
+    }
+    return true;
+}
+
+template <class RandomIter, class Compare>
+MYSTL_CONSTEXPR20 void sort2(RandomIter a, RandomIter b, Compare comp) {
+    if (comp(*b, *a))
+        mystl::iter_swap(a, b);
+}
+
+// 排好 *a, *b, *c 三个元素，中位数放在 b
+template <class RandomIter, class Compare>
+MYSTL_CONSTEXPR20 void sort3(RandomIter a, RandomIter b, RandomIter c, Compare comp) {
+    mystl::sort2(a, b, comp);
+    mystl::sort2(b, c, comp);
+    mystl::sort2(a, b, comp);
+}
+
+// 选择枢轴并放到 *first：三数取中，长区间为九数取中
+template <class RandomIter, class Compare>
+MYSTL_CONSTEXPR20 void sort_choose_pivot(RandomIter first, RandomIter last, Compare comp) {
+    using distance = typename iterator_traits<RandomIter>::difference_type;
+    const distance len = last - first;
+    const distance half = len / 2;
+    if (len > static_cast<distance>(ESortNintherThreshold)) {
+        mystl::sort3(first, first + half, last - 1, comp);
+        mystl::sort3(first + 1, first + (half - 1), last - 2, comp);
+        mystl::sort3(first + 2, first + (half + 1), last - 3, comp);
+        mystl::sort3(first + (half - 1), first + half, first + (half + 1), comp);
+        mystl::iter_swap(first, first + half);
+    } else {
+        mystl::sort3(first + half, first, last - 1, comp);
+    }
+}
+
+// 以 *first 为枢轴划分，小于枢轴的元素在左边，其余在右边。
+// 返回枢轴的最终位置，以及划分前区间是否已经划分好 (没有发生交换)
+template <class RandomIter, class Compare>
+MYSTL_CONSTEXPR20 pair<RandomIter, bool> partition_right(
+    RandomIter first, RandomIter last, Compare comp) {
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    value_type pivot(mystl::move(*first));
+    RandomIter lo = first;
+    RandomIter hi = last;
+
+    // 枢轴是三数取中的结果，右侧一定存在不小于枢轴的元素，左侧找的时候不需要边界检查
+    while (comp(*++lo, pivot)) {}
+    if (lo - 1 == first) {
+        while (lo < hi && !comp(*--hi, pivot)) {}
+    } else {
+        while (!comp(*--hi, pivot)) {}
+    }
+
+    const bool already_partitioned = lo >= hi;
+    while (lo < hi) {
+        mystl::iter_swap(lo, hi);
+        while (comp(*++lo, pivot)) {}
+        while (!comp(*--hi, pivot)) {}
+    }
+
+    RandomIter pivot_pos = lo - 1;
+    *first = mystl::move(*pivot_pos);
+    *pivot_pos = mystl::move(pivot);
+    return pair<RandomIter, bool>(pivot_pos, already_partitioned);
+}
+
+// 按 offsets_l、offsets_r 记录的位置两两交换 num 对元素。
+// 左右两边个数相同时逐对交换，否则用一个临时变量做循环移动，每个元素只移动一次
+template <class RandomIter>
+MYSTL_CONSTEXPR20 void swap_offsets(RandomIter first, RandomIter last,
+    const unsigned char* offsets_l, const unsigned char* offsets_r, size_t num,
+    bool use_swaps) {
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    if (use_swaps) {
+        for (size_t i = 0; i < num; ++i) {
+            mystl::iter_swap(first + offsets_l[i], last - offsets_r[i]);
+        }
+    } else if (num > 0) {
+        RandomIter l = first + offsets_l[0];
+        RandomIter r = last - offsets_r[0];
+        value_type tmp(mystl::move(*l));
+        *l = mystl::move(*r);
+        for (size_t i = 1; i < num; ++i) {
+            l = first + offsets_l[i];
+            *r = mystl::move(*l);
+            r = last - offsets_r[i];
+            *l = mystl::move(*r);
+        }
+        *r = mystl::move(tmp);
+    }
+}
+
+// partition_right 的无分支版本 (BlockQuicksort)：
+// 每次从左右两端各扫描一块，把需要交换的元素的偏移量写进缓冲区，
+// 写入位置总是前进 0 或 1，比较结果只参与算术运算而不决定跳转
+template <class RandomIter, class Compare>
+pair<RandomIter, bool> partition_right_branchless(
+    RandomIter first, RandomIter last, Compare comp) {
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    value_type pivot(mystl::move(*first));
+    RandomIter lo = first;
+    RandomIter hi = last;
+
+    while (comp(*++lo, pivot)) {}
+    if (lo - 1 == first) {
+        while (lo < hi && !comp(*--hi, pivot)) {}
+    } else {
+        while (!comp(*--hi, pivot)) {}
+    }
+
+    const bool already_partitioned = lo >= hi;
+    if (!already_partitioned) {
+        mystl::iter_swap(lo, hi);
+        ++lo;
+
+        alignas(simd::ECacheLineSize) unsigned char offsets_l[ESortBlockSize];
+        alignas(simd::ECacheLineSize) unsigned char offsets_r[ESortBlockSize];
+        const size_t block = static_cast<size_t>(ESortBlockSize);
+
+        RandomIter base_l = lo;
+        RandomIter base_r = hi;
+        size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+        while (lo < hi) {
+            // 缓冲区用完的一侧扫描新的一块，剩余不足两块时两侧平分
+            const size_t unknown = static_cast<size_t>(hi - lo);
+            const size_t left_split = num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+            const size_t right_split = num_r == 0 ? (unknown - left_split) : 0;
+
+            const size_t scan_l = left_split < block ? left_split : block;
+            for (size_t i = 0; i < scan_l; ++i) {
+                offsets_l[num_l] = static_cast<unsigned char>(i);
+                num_l += !comp(*lo, pivot);
+                ++lo;
+            }
+            const size_t scan_r = right_split < block ? right_split : block;
+            for (size_t i = 0; i < scan_r; ++i) {
+                offsets_r[num_r] = static_cast<unsigned char>(i + 1);
+                num_r += comp(*--hi, pivot);
+            }
+
+            const size_t num = num_l < num_r ? num_l : num_r;
+            mystl::swap_offsets(base_l, base_r, offsets_l + start_l, offsets_r + start_r, num,
+                num_l == num_r);
+            num_l -= num;
+            num_r -= num;
+            start_l += num;
+            start_r += num;
+            if (num_l == 0) {
+                start_l = 0;
+                base_l = lo;
+            }
+            if (num_r == 0) {
+                start_r = 0;
+                base_r = hi;
+            }
+        }
+
+        // 最多一侧还有没交换的元素，把它们交换到中间
+        if (num_l != 0) {
+            while (num_l--) {
+                mystl::iter_swap(base_l + offsets_l[start_l + num_l], --hi);
+            }
+            lo = hi;
+        }
+        if (num_r != 0) {
+            while (num_r--) {
+                mystl::iter_swap(base_r - offsets_r[start_r + num_r], lo);
+                ++lo;
+            }
+        }
+    }
+
+    RandomIter pivot_pos = lo - 1;
+    *first = mystl::move(*pivot_pos);
+    *pivot_pos = mystl::move(pivot);
+    return pair<RandomIter, bool>(pivot_pos, already_partitioned);
+}
+
+// 以 *first 为枢轴划分，不大于枢轴的元素在左边，大于枢轴的元素在右边，返回枢轴的最终位置。
+// 在枢轴与 *(first - 1) 相等时使用，左边的元素全部等于枢轴，之后不需要再处理
+template <class RandomIter, class Compare>
+MYSTL_CONSTEXPR20 RandomIter partition_left(RandomIter first, RandomIter last, Compare comp) {
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    value_type pivot(mystl::move(*first));
+    RandomIter lo = first;
+    RandomIter hi = last;
+
+    while (comp(pivot, *--hi)) {}
+    if (hi + 1 == last) {
+        while (lo < hi && !comp(pivot, *++lo)) {}
+    } else {
+        while (!comp(pivot, *++lo)) {}
+    }
+
+    while (lo < hi) {
+        mystl::iter_swap(lo, hi);
+        while (comp(pivot, *--hi)) {}
+        while (!comp(pivot, *++lo)) {}
+    }
+
+    RandomIter pivot_pos = hi;
+    *first = mystl::move(*pivot_pos);
+    *pivot_pos = mystl::move(pivot);
+    return pivot_pos;
+}
+
+// 划分严重不平衡时，把两侧靠近端点的几个元素与 1/4 处的元素交换，破坏导致不平衡的输入模式
+template <class RandomIter>
+MYSTL_CONSTEXPR20 void sort_break_patterns(
+    RandomIter first, RandomIter pivot_pos, RandomIter last) {
+    using distance = typename iterator_traits<RandomIter>::difference_type;
+    const distance l_size = pivot_pos - first;
+    const distance r_size = last - (pivot_pos + 1);
+    if (l_size >= static_cast<distance>(ESortInsertionThreshold)) {
+        mystl::iter_swap(first, first + l_size / 4);
+        mystl::iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+        if (l_size > static_cast<distance>(ESortNintherThreshold)) {
+            mystl::iter_swap(first + 1, first + (l_size / 4 + 1));
+            mystl::iter_swap(first + 2, first + (l_size / 4 + 2));
+            mystl::iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+            mystl::iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+        }
+    }
+    if (r_size >= static_cast<distance>(ESortInsertionThreshold)) {
+        mystl::iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+        mystl::iter_swap(last - 1, last - r_size / 4);
+        if (r_size > static_cast<distance>(ESortNintherThreshold)) {
+            mystl::iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+            mystl::iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+            mystl::iter_swap(last - 2, last - (1 + r_size / 4));
+            mystl::iter_swap(last - 3, last - (2 + r_size / 4));
+        }
+    }
+}
+
+// 按编译期选择的方式划分，常量求值时总是使用 partition_right
+template <class RandomIter, class Compare>
+MYSTL_CONSTEXPR20 pair<RandomIter, bool> sort_partition(
+    RandomIter first, RandomIter last, Compare comp, m_true_type) {
+    if (mystl::is_constant_evaluated())
+        return mystl::partition_right(first, last, comp);
+    return mystl::partition_right_branchless(first, last, comp);
+}
+
+template <class RandomIter, class Compare>
+MYSTL_CONSTEXPR20 pair<RandomIter, bool> sort_partition(
+    RandomIter first, RandomIter last, Compare comp, m_false_type) {
+    return mystl::partition_right(first, last, comp);
+}
+
+// pdqsort 的主循环，对左半部分递归、右半部分迭代。
+// leftmost 为 false 时 *(first - 1) 不大于区间内的任何元素
+template <class RandomIter, class Compare, class Branchless>
+MYSTL_CONSTEXPR20 void pdqsort_loop(RandomIter first, RandomIter last, Compare comp,
+    int bad_allowed, bool leftmost, Branchless branchless) {
+    using distance = typename iterator_traits<RandomIter>::difference_type;
+    while (true) {
+        const distance len = last - first;
+        if (len < static_cast<distance>(ESortInsertionThreshold)) {
+            if (leftmost)
+                mystl::insertion_sort(first, last, comp);
+            else
+                mystl::unguarded_insertion_sort(first, last, comp);
+            return;
+        }
+
+        mystl::sort_choose_pivot(first, last, comp);
+
+        // 枢轴与左侧的元素相等，说明区间中可能有大量重复元素，把等于枢轴的元素全部划到左边跳过
+        if (!leftmost && !comp(*(first - 1), *first)) {
+            first = mystl::partition_left(first, last, comp) + 1;
+            continue;
+        }
+
+        const pair<RandomIter, bool> part = mystl::sort_partition(first, last, comp, branchless);
+        const RandomIter pivot_pos = part.first;
+        const distance l_size = pivot_pos - first;
+        const distance r_size = last - (pivot_pos + 1);
+
+        if (l_size < len / 8 || r_size < len / 8) {
+            if (--bad_allowed == 0) {
+                mystl::make_heap(first, last, comp);
+                mystl::sort_heap(first, last, comp);
+                return;
+            }
+            mystl::sort_break_patterns(first, pivot_pos, last);
+        } else if (part.second && mystl::partial_insertion_sort(first, pivot_pos, comp) &&
+                   mystl::partial_insertion_sort(pivot_pos + 1, last, comp)) {
+            // 划分时没有发生交换，两侧用少量的插入排序就已经有序
+            return;
+        }
+
+        mystl::pdqsort_loop(first, pivot_pos, comp, bad_allowed, leftmost, branchless);
+        first = pivot_pos + 1;
+        leftmost = false;
+    }
+}
+
+/*****************************************************************************************/
+// sort
+// 将 [first, last) 内的元素以递增的方式排序 (不稳定)
+/*****************************************************************************************/
+template <class RandomIter, class Compare>
+MYSTL_CONSTEXPR20 void sort_cat(
+    RandomIter first, RandomIter last, Compare comp, mystl::random_access_iterator_tag) {
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    if (last - first < 2)
+        return;
+    mystl::pdqsort_loop(first, last, comp, mystl::sort_log2(last - first), true,
+        sort_is_branchless<Compare, value_type>{});
+}
+
+// 非随机访问的前向迭代器：移动到连续空间中排序后再移动回来
+template <class ForwardIter, class Compare>
+void sort_cat(ForwardIter first, ForwardIter last, Compare comp, mystl::forward_iterator_tag) {
+    using value_type = typename iterator_traits<ForwardIter>::value_type;
+    vector<value_type> buf;
+    buf.reserve(static_cast<size_t>(mystl::distance(first, last)));
+    for (ForwardIter cur = first; cur != last; ++cur) {
+        buf.emplace_back(mystl::move(*cur));
+    }
+    mystl::sort_cat(buf.begin(), buf.end(), comp, mystl::random_access_iterator_tag{});
+    mystl::move(buf.begin(), buf.end(), first);
+}
+
+template <class ForwardIter, class Compare>
+MYSTL_CONSTEXPR20 void sort(ForwardIter first, ForwardIter last, Compare comp) {
+    mystl::sort_cat(first, last, comp, iterator_category(first));
+}
+
+template <class ForwardIter>
+MYSTL_CONSTEXPR20 void sort(ForwardIter first, ForwardIter last) {
+    mystl::sort(first, last, value_less());
+}
+
+/*****************************************************************************************/
+// partial_sort
+// 对整个序列做部分排序，保证较小的 middle - first 个元素以递增顺序置于 [first, middle) 内
+/*****************************************************************************************/
+template <class RandomIter, class Compare>
+MYSTL_CONSTEXPR20 void partial_sort(
+    RandomIter first, RandomIter middle, RandomIter last, Compare comp) {
+    static_assert(is_random_access_iterator<RandomIter>::value,
+        "partial_sort requires random access iterators");
+    if (first == middle)
+        return;
+    // [first, middle) 维护为最大堆，比堆顶小的元素与堆顶交换
+    mystl::make_heap(first, middle, comp);
+    for (RandomIter i = middle; i < last; ++i) {
+        if (comp(*i, *first))
+            mystl::pop_heap_aux(first, middle, i, comp);
+    }
+    mystl::sort_heap(first, middle, comp);
+}
+
+template <class RandomIter>
+MYSTL_CONSTEXPR20 void partial_sort(RandomIter first, RandomIter middle, RandomIter last) {
+    mystl::partial_sort(first, middle, last, value_less());
+}
+
+/*****************************************************************************************/
+// nth_element
+// 对序列重排，使得所有小于第 n 个元素的元素出现在它的前面，大于它的出现在它的后面
+/*****************************************************************************************/
+// 与 pdqsort 相同的枢轴选择和划分，每次只进入包含 nth 的一侧；
+// 不平衡次数超过 log2(n) 后改用 partial_sort
+template <class RandomIter, class Compare>
+MYSTL_CONSTEXPR20 void nth_element(
+    RandomIter first, RandomIter nth, RandomIter last, Compare comp) {
+    using distance = typename iterator_traits<RandomIter>::difference_type;
+    static_assert(is_random_access_iterator<RandomIter>::value,
+        "nth_element requires random access iterators");
+    if (first == last || nth == last)
+        return;
+    int bad_allowed = mystl::sort_log2(last - first);
+    bool leftmost = true;
+    while (last - first >= static_cast<distance>(ESortInsertionThreshold)) {
+        const distance len = last - first;
+        mystl::sort_choose_pivot(first, last, comp);
+
+        if (!leftmost && !comp(*(first - 1), *first)) {
+            // 左边划出的元素全部等于 *(first - 1)
+            const RandomIter pos = mystl::partition_left(first, last, comp);
+            if (nth <= pos)
+                return;
+            first = pos + 1;
+            continue;
+        }
+
+        const RandomIter pivot_pos = mystl::partition_right(first, last, comp).first;
+        if (pivot_pos == nth)
+            return;
+        const distance l_size = pivot_pos - first;
+        const distance r_size = last - (pivot_pos + 1);
+        if (l_size < len / 8 || r_size < len / 8) {
+            if (--bad_allowed == 0) {
+                mystl::partial_sort(first, nth + 1, last, comp);
+                return;
+            }
+            mystl::sort_break_patterns(first, pivot_pos, last);
+        }
+
+        if (nth < pivot_pos) {
+            last = pivot_pos;
+        } else {
+            first = pivot_pos + 1;
+            leftmost = false;
+        }
+    }
+    if (leftmost)
+        mystl::insertion_sort(first, last, comp);
+    else
+        mystl::unguarded_insertion_sort(first, last, comp);
+}
+
+template <class RandomIter>
+MYSTL_CONSTEXPR20 void nth_element(RandomIter first, RandomIter nth, RandomIter last) {
+    mystl::nth_element(first, nth, last, value_less());
+}
+
+} // namespace mystl
+
+#endif // !MYTINYSTL_ALGO_H_
@@ -5,7 +5,9 @@
 
 #include <cstring>
 
+#include "execution.h"
 #include "iterator.h"
+#include "simd.h"
 #include "util.h"
 
 namespace mystl {
@@ -25,13 +27,13 @@ namespace mystl {
 // 取二者中的较大值，语义相等时保证返回第一个参数
 /*****************************************************************************************/
 template <class T>
-const T& max(const T& lhs, const T& rhs) {
+MYSTL_CONSTEXPR20 const T& max(const T& lhs, const T& rhs) {
     return lhs < rhs ? rhs : lhs;
 }
 
 // 重载版本使用函数对象 comp 代替比较操作
 template <class T, class Compare>
-const T& max(const T& lhs, const T& rhs, Compare comp) {
+MYSTL_CONSTEXPR20 const T& max(const T& lhs, const T& rhs, Compare comp) {
     return comp(lhs, rhs) ? rhs : lhs;
 }
 
@@ -40,13 +42,13 @@ const T& max(const T& lhs, const T& rhs, Compare comp) {
 // 取二者中的较小值，语义相等时保证返回第一个参数
 /*****************************************************************************************/
 template <class T>
-const T& min(const T& lhs, const T& rhs) {
+MYSTL_CONSTEXPR20 const T& min(const T& lhs, const T& rhs) {
     return rhs < lhs ? rhs : lhs;
 }
 
 // 重载版本使用函数对象 comp 代替比较操作
 template <class T, class Compare>
-const T& min(const T& lhs, const T& rhs, Compare comp) {
+MYSTL_CONSTEXPR20 const T& min(const T& lhs, const T& rhs, Compare comp) {
     return comp(rhs, lhs) ? rhs : lhs;
 }
 
@@ -55,7 +57,7 @@ const T& min(const T& lhs, const T& rhs, Compare comp) {
 // 将两个迭代器所指对象对调
 /*****************************************************************************************/
 template <class FIter1, class FIter2>
-void iter_swap(FIter1 lhs, FIter2 rhs) {
+MYSTL_CONSTEXPR20 void iter_swap(FIter1 lhs, FIter2 rhs) {
     mystl::swap(*lhs, *rhs);
 }
 
@@ -65,7 +67,7 @@ void iter_swap(FIter1 lhs, FIter2 rhs) {
 /*****************************************************************************************/
 // input_iterator_tag 版本
 template <class InputIter, class OutputIter>
-OutputIter unchecked_copy_cat(
+MYSTL_CONSTEXPR20 OutputIter unchecked_copy_cat(
     InputIter first, InputIter last, OutputIter result, mystl::input_iterator_tag) {
     for (; first != last; ++first, ++result) {
         *result = *first;
@@ -75,8 +77,8 @@ OutputIter unchecked_copy_cat(
 
 // ramdom_access_iterator_tag 版本
 template <class RandomIter, class OutputIter>
-OutputIter unchecked_copy_cat(RandomIter first, RandomIter last, OutputIter result,
-    mystl::random_access_iterator_tag) {
+MYSTL_CONSTEXPR20 OutputIter unchecked_copy_cat(RandomIter first, RandomIter last,
+    OutputIter result, mystl::random_access_iterator_tag) {
     for (auto n = last - first; n > 0; --n, ++first, ++result) {
         *result = *first;
     }
@@ -84,16 +86,20 @@ OutputIter unchecked_copy_cat(RandomIter first, RandomIter last, OutputIter resu
 }
 
 template <class InputIter, class OutputIter>
-OutputIter unchecked_copy(InputIter first, InputIter last, OutputIter result) {
+MYSTL_CONSTEXPR20 OutputIter unchecked_copy(
+    InputIter first, InputIter last, OutputIter result) {
     return unchecked_copy_cat(first, last, result, iterator_category(first));
 }
 
 // 为 trivially_copy_assignable 类型提供特化版本
 template <class Tp, class Up>
+MYSTL_CONSTEXPR20
 typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
                             std::is_trivially_copy_assignable<Up>::value,
     Up*>::type
 unchecked_copy(Tp* first, Tp* last, Up* result) {
+    if (mystl::is_constant_evaluated())
+        return unchecked_copy_cat(first, last, result, mystl::random_access_iterator_tag{});
     const auto n = static_cast<size_t>(last - first);
     if (n != 0)
         std::memmove(result, first, n * sizeof(Up));
@@ -101,7 +107,7 @@ unchecked_copy(Tp* first, Tp* last, Up* result) {
 }
 
 template <class InputIter, class OutputIter>
-OutputIter copy(InputIter first, InputIter last, OutputIter result) {
+MYSTL_CONSTEXPR20 OutputIter copy(InputIter first, InputIter last, OutputIter result) {
     return unchecked_copy(first, last, result);
 }
 
@@ -111,7 +117,7 @@ OutputIter copy(InputIter first, InputIter last, OutputIter result) {
 /*****************************************************************************************/
 // unchecked_copy_backward_cat 的 bidirectional_iterator_tag 版本
 template <class BidirectionalIter1, class BidirectionalIter2>
-BidirectionalIter2 unchecked_copy_backward_cat(BidirectionalIter1 first,
+MYSTL_CONSTEXPR20 BidirectionalIter2 unchecked_copy_backward_cat(BidirectionalIter1 first,
     BidirectionalIter1 last, BidirectionalIter2 result,
     mystl::bidirectional_iterator_tag) {
     while (first != last)
@@ -121,7 +127,7 @@ BidirectionalIter2 unchecked_copy_backward_cat(BidirectionalIter1 first,
 
 // unchecked_copy_backward_cat 的 random_access_iterator_tag 版本
 template <class BidirectionalIter1, class BidirectionalIter2>
-BidirectionalIter2 unchecked_copy_backward_cat(BidirectionalIter1 first,
+MYSTL_CONSTEXPR20 BidirectionalIter2 unchecked_copy_backward_cat(BidirectionalIter1 first,
     BidirectionalIter1 last, BidirectionalIter2 result,
     mystl::random_access_iterator_tag) {
     for (auto n = last - first; n > 0; --n)
@@ -130,17 +136,22 @@ BidirectionalIter2 unchecked_copy_backward_cat(BidirectionalIter1 first,
 }
 
 template <class BidirectionalIter1, class BidirectionalIter2>
-BidirectionalIter2 unchecked_copy_backward(
+MYSTL_CONSTEXPR20 BidirectionalIter2 unchecked_copy_backward(
     BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result) {
     return unchecked_copy_backward_cat(first, last, result, iterator_category(first));
 }
 
 // 为 trivially_copy_assignable 类型提供特化版本
 template <class Tp, class Up>
+MYSTL_CONSTEXPR20
 typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
                             std::is_trivially_copy_assignable<Up>::value,
     Up*>::type
 unchecked_copy_backward(Tp* first, Tp* last, Up* result) {
+    if (mystl::is_constant_evaluated()) {
+        return unchecked_copy_backward_cat(
+            first, last, result, mystl::random_access_iterator_tag{});
+    }
     const auto n = static_cast<size_t>(last - first);
     if (n != 0) {
         result -= n;
@@ -150,7 +161,7 @@ unchecked_copy_backward(Tp* first, Tp* last, Up* result) {
 }
 
 template <class BidirectionalIter1, class BidirectionalIter2>
-BidirectionalIter2 copy_backward(
+MYSTL_CONSTEXPR20 BidirectionalIter2 copy_backward(
     BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result) {
     return unchecked_copy_backward(first, last, result);
 }
@@ -160,7 +171,7 @@ BidirectionalIter2 copy_backward(
 // 把[first, last)内满足一元操作 unary_pred 的元素拷贝到以 result 为起始的位置上
 /*****************************************************************************************/
 template <class InputIter, class OutputIter, class UnaryPredicate>
-OutputIter copy_if(
+MYSTL_CONSTEXPR20 OutputIter copy_if(
     InputIter first, InputIter last, OutputIter result, UnaryPredicate unary_pred) {
     for (; first != last; ++first) {
         if (unary_pred(*first))
@@ -175,7 +186,7 @@ OutputIter copy_if(
 // 返回一个 pair 分别指向拷贝结束的尾部
 /*****************************************************************************************/
 template <class InputIter, class Size, class OutputIter>
-mystl::pair<InputIter, OutputIter> unchecked_copy_n(
+MYSTL_CONSTEXPR20 mystl::pair<InputIter, OutputIter> unchecked_copy_n(
     InputIter first, Size n, OutputIter result, mystl::input_iterator_tag) {
     for (; n > 0; --n, ++first, ++result) {
         *result = *first;
@@ -184,14 +195,15 @@ mystl::pair<InputIter, OutputIter> unchecked_copy_n(
 }
 
 template <class RandomIter, class Size, class OutputIter>
-mystl::pair<RandomIter, OutputIter> unchecked_copy_n(
+MYSTL_CONSTEXPR20 mystl::pair<RandomIter, OutputIter> unchecked_copy_n(
     RandomIter first, Size n, OutputIter result, mystl::random_access_iterator_tag) {
     auto last = first + n;
     return mystl::pair<RandomIter, OutputIter>(last, mystl::copy(first, last, result));
 }
 
 template <class InputIter, class Size, class OutputIter>
-mystl::pair<InputIter, OutputIter> copy_n(InputIter first, Size n, OutputIter result) {
+MYSTL_CONSTEXPR20 mystl::pair<InputIter, OutputIter> copy_n(
+    InputIter first, Size n, OutputIter result) {
     return unchecked_copy_n(first, n, result, iterator_category(first));
 }
 
@@ -201,7 +213,7 @@ mystl::pair<InputIter, OutputIter> copy_n(InputIter first, Size n, OutputIter re
 /*****************************************************************************************/
 // input_iterator_tag 版本
 template <class InputIter, class OutputIter>
-OutputIter unchecked_move_cat(
+MYSTL_CONSTEXPR20 OutputIter unchecked_move_cat(
     InputIter first, InputIter last, OutputIter result, mystl::input_iterator_tag) {
     for (; first != last; ++first, ++result) {
         *result = mystl::move(*first);
@@ -211,8 +223,8 @@ OutputIter unchecked_move_cat(
 
 // ramdom_access_iterator_tag 版本
 template <class RandomIter, class OutputIter>
-OutputIter unchecked_move_cat(RandomIter first, RandomIter last, OutputIter result,
-    mystl::random_access_iterator_tag) {
+MYSTL_CONSTEXPR20 OutputIter unchecked_move_cat(RandomIter first, RandomIter last,
+    OutputIter result, mystl::random_access_iterator_tag) {
     for (auto n = last - first; n > 0; --n, ++first, ++result) {
         *result = mystl::move(*first);
     }
@@ -220,16 +232,20 @@ OutputIter unchecked_move_cat(RandomIter first, RandomIter last, OutputIter resu
 }
 
 template <class InputIter, class OutputIter>
-OutputIter unchecked_move(InputIter first, InputIter last, OutputIter result) {
+MYSTL_CONSTEXPR20 OutputIter unchecked_move(
+    InputIter first, InputIter last, OutputIter result) {
     return unchecked_move_cat(first, last, result, iterator_category(first));
 }
 
 // 为 trivially_copy_assignable 类型提供特化版本
 template <class Tp, class Up>
+MYSTL_CONSTEXPR20
 typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
                             std::is_trivially_move_assignable<Up>::value,
     Up*>::type
 unchecked_move(Tp* first, Tp* last, Up* result) {
+    if (mystl::is_constant_evaluated())
+        return unchecked_move_cat(first, last, result, mystl::random_access_iterator_tag{});
     const size_t n = static_cast<size_t>(last - first);
     if (n != 0)
         std::memmove(result, first, n * sizeof(Up));
@@ -237,7 +253,7 @@ unchecked_move(Tp* first, Tp* last, Up* result) {
 }
 
 template <class InputIter, class OutputIter>
-OutputIter move(InputIter first, InputIter last, OutputIter result) {
+MYSTL_CONSTEXPR20 OutputIter move(InputIter first, InputIter last, OutputIter result) {
     return unchecked_move(first, last, result);
 }
 
@@ -247,7 +263,7 @@ OutputIter move(InputIter first, InputIter last, OutputIter result) {
 /*****************************************************************************************/
 // bidirectional_iterator_tag 版本
 template <class BidirectionalIter1, class BidirectionalIter2>
-BidirectionalIter2 unchecked_move_backward_cat(BidirectionalIter1 first,
+MYSTL_CONSTEXPR20 BidirectionalIter2 unchecked_move_backward_cat(BidirectionalIter1 first,
     BidirectionalIter1 last, BidirectionalIter2 result,
     mystl::bidirectional_iterator_tag) {
     while (first != last)
@@ -257,25 +273,30 @@ BidirectionalIter2 unchecked_move_backward_cat(BidirectionalIter1 first,
 
 // random_access_iterator_tag 版本
 template <class RandomIter1, class RandomIter2>
-RandomIter2 unchecked_move_backward_cat(RandomIter1 first, RandomIter1 last,
-    RandomIter2 result, mystl::random_access_iterator_tag) {
+MYSTL_CONSTEXPR20 RandomIter2 unchecked_move_backward_cat(RandomIter1 first,
+    RandomIter1 last, RandomIter2 result, mystl::random_access_iterator_tag) {
     for (auto n = last - first; n > 0; --n)
         *--result = mystl::move(*--last);
     return result;
 }
 
 template <class BidirectionalIter1, class BidirectionalIter2>
-BidirectionalIter2 unchecked_move_backward(
+MYSTL_CONSTEXPR20 BidirectionalIter2 unchecked_move_backward(
     BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result) {
     return unchecked_move_backward_cat(first, last, result, iterator_category(first));
 }
 
 // 为 trivially_copy_assignable 类型提供特化版本
 template <class Tp, class Up>
+MYSTL_CONSTEXPR20
 typename std::enable_if<std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
                             std::is_trivially_move_assignable<Up>::value,
     Up*>::type
 unchecked_move_backward(Tp* first, Tp* last, Up* result) {
+    if (mystl::is_constant_evaluated()) {
+        return unchecked_move_backward_cat(
+            first, last, result, mystl::random_access_iterator_tag{});
+    }
     const size_t n = static_cast<size_t>(last - first);
     if (n != 0) {
         result -= n;
@@ -285,17 +306,37 @@ unchecked_move_backward(Tp* first, Tp* last, Up* result) {
 }
 
 template <class BidirectionalIter1, class BidirectionalIter2>
-BidirectionalIter2 move_backward(
+MYSTL_CONSTEXPR20 BidirectionalIter2 move_backward(
     BidirectionalIter1 first, BidirectionalIter1 last, BidirectionalIter2 result) {
     return unchecked_move_backward(first, last, result);
 }
 
+/*****************************************************************************************/
+// 两个迭代器都是指向同一种整数类型的指针时，元素相等当且仅当字节相等，
+// equal / mismatch / lexicographical_compare 的默认版本交给 simd.h 中的内核按字节比较
+/*****************************************************************************************/
+template <class Iter1, class Iter2>
+struct is_bytewise_comparable : m_false_type {};
+
+template <class Tp1, class Tp2>
+struct is_bytewise_comparable<Tp1*, Tp2*>
+    : m_bool_constant<std::is_same<typename std::remove_cv<Tp1>::type,
+                          typename std::remove_cv<Tp2>::type>::value &&
+                      std::is_integral<Tp1>::value> {};
+
+// 返回 [first1, first1 + n) 与 [first2, first2 + n) 中第一对不相等元素的下标
+template <class Tp1, class Tp2>
+size_t bytewise_mismatch(Tp1* first1, Tp2* first2, size_t n) noexcept {
+    return mystl::simd::mismatch_bytes(first1, first2, n * sizeof(Tp1)) / sizeof(Tp1);
+}
+
 /*****************************************************************************************/
 // equal
 // 比较第一序列在 [first, last)区间上的元素值是否和第二序列相等
 /*****************************************************************************************/
 template <class InputIter1, class InputIter2>
-bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+MYSTL_CONSTEXPR20 bool equal_cat(
+    InputIter1 first1, InputIter1 last1, InputIter2 first2, m_false_type) {
     for (; first1 != last1; ++first1, ++first2) {
         if (*first1 != *first2)
             return false;
@@ -303,9 +344,24 @@ bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
     return true;
 }
 
+template <class Tp1, class Tp2>
+MYSTL_CONSTEXPR20 bool equal_cat(Tp1* first1, Tp1* last1, Tp2* first2, m_true_type) {
+    if (mystl::is_constant_evaluated())
+        return mystl::equal_cat(first1, last1, first2, m_false_type{});
+    const auto n = static_cast<size_t>(last1 - first1);
+    return mystl::bytewise_mismatch(first1, first2, n) == n;
+}
+
+template <class InputIter1, class InputIter2>
+MYSTL_CONSTEXPR20 bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+    return mystl::equal_cat(first1, last1, first2,
+        m_bool_constant<is_bytewise_comparable<InputIter1, InputIter2>::value>{});
+}
+
 // 重载版本使用函数对象 comp 代替比较操作
 template <class InputIter1, class InputIter2, class Compared>
-bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compared comp) {
+MYSTL_CONSTEXPR20 bool equal(
+    InputIter1 first1, InputIter1 last1, InputIter2 first2, Compared comp) {
     for (; first1 != last1; ++first1, ++first2) {
         if (!comp(*first1, *first2))
             return false;
@@ -318,7 +374,7 @@ bool equal(InputIter1 first1, InputIter1 last1, InputIter2 first2, Compared comp
 // 从 first 位置开始填充 n 个值
 /*****************************************************************************************/
 template <class OutputIter, class Size, class T>
-OutputIter unchecked_fill_n(OutputIter first, Size n, const T& value) {
+MYSTL_CONSTEXPR20 OutputIter unchecked_fill_n(OutputIter first, Size n, const T& value) {
     for (; n > 0; --n, ++first) {
         *first = value;
     }
@@ -327,11 +383,18 @@ OutputIter unchecked_fill_n(OutputIter first, Size n, const T& value) {
 
 // 为 one-byte 类型提供特化版本
 template <class Tp, class Size, class Up>
+MYSTL_CONSTEXPR20
 typename std::enable_if<std::is_integral<Tp>::value && sizeof(Tp) == 1 &&
                             !std::is_same<Tp, bool>::value &&
                             std::is_integral<Up>::value && sizeof(Up) == 1,
     Tp*>::type
 unchecked_fill_n(Tp* first, Size n, Up value) {
+    if (mystl::is_constant_evaluated()) {
+        for (; n > 0; --n, ++first) {
+            *first = static_cast<Tp>(value);
+        }
+        return first;
+    }
     if (n > 0) {
         std::memset(first, (unsigned char)value, (size_t)(n));
     }
@@ -339,7 +402,7 @@ unchecked_fill_n(Tp* first, Size n, Up value) {
 }
 
 template <class OutputIter, class Size, class T>
-OutputIter fill_n(OutputIter first, Size n, const T& value) {
+MYSTL_CONSTEXPR20 OutputIter fill_n(OutputIter first, Size n, const T& value) {
     return unchecked_fill_n(first, n, value);
 }
 
@@ -348,7 +411,7 @@ OutputIter fill_n(OutputIter first, Size n, const T& value) {
 // 为 [first, last)区间内的所有元素填充新值
 /*****************************************************************************************/
 template <class ForwardIter, class T>
-void fill_cat(
+MYSTL_CONSTEXPR20 void fill_cat(
     ForwardIter first, ForwardIter last, const T& value, mystl::forward_iterator_tag) {
     for (; first != last; ++first) {
         *first = value;
@@ -356,13 +419,13 @@ void fill_cat(
 }
 
 template <class RandomIter, class T>
-void fill_cat(RandomIter first, RandomIter last, const T& value,
+MYSTL_CONSTEXPR20 void fill_cat(RandomIter first, RandomIter last, const T& value,
     mystl::random_access_iterator_tag) {
-    fill_n(first, last - first, value);
+    mystl::fill_n(first, last - first, value);
 }
 
 template <class ForwardIter, class T>
-void fill(ForwardIter first, ForwardIter last, const T& value) {
+MYSTL_CONSTEXPR20 void fill(ForwardIter first, ForwardIter last, const T& value) {
     fill_cat(first, last, value, iterator_category(first));
 }
 
@@ -375,8 +438,8 @@ void fill(ForwardIter first, ForwardIter last, const T& value) {
 // (4)如果同时到达 last1 和 last2 返回 false
 /*****************************************************************************************/
 template <class InputIter1, class InputIter2>
-bool lexicographical_compare(
-    InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2) {
+MYSTL_CONSTEXPR20 bool lexicographical_compare_cat(InputIter1 first1, InputIter1 last1,
+    InputIter2 first2, InputIter2 last2, m_false_type) {
     for (; first1 != last1 && first2 != last2; ++first1, ++first2) {
         if (*first1 < *first2)
             return true;
@@ -386,10 +449,33 @@ bool lexicographical_compare(
     return first1 == last1 && first2 != last2;
 }
 
+// 先按字节找到第一处失配，再比较失配的两个元素
+template <class Tp1, class Tp2>
+MYSTL_CONSTEXPR20 bool lexicographical_compare_cat(
+    Tp1* first1, Tp1* last1, Tp2* first2, Tp2* last2, m_true_type) {
+    if (mystl::is_constant_evaluated()) {
+        return mystl::lexicographical_compare_cat(
+            first1, last1, first2, last2, m_false_type{});
+    }
+    const auto len1 = static_cast<size_t>(last1 - first1);
+    const auto len2 = static_cast<size_t>(last2 - first2);
+    const auto len = mystl::min(len1, len2);
+    const auto i = mystl::bytewise_mismatch(first1, first2, len);
+    // 若相等，长度较长的比较大
+    return i != len ? first1[i] < first2[i] : len1 < len2;
+}
+
+template <class InputIter1, class InputIter2>
+MYSTL_CONSTEXPR20 bool lexicographical_compare(
+    InputIter1 first1, InputIter1 last1, InputIter2 first2, InputIter2 last2) {
+    return mystl::lexicographical_compare_cat(first1, last1, first2, last2,
+        m_bool_constant<is_bytewise_comparable<InputIter1, InputIter2>::value>{});
+}
+
 // 重载版本使用函数对象 comp 代替比较操作
 template <class InputIter1, class InputIter2, class Compred>
-bool lexicographical_compare(InputIter1 first1, InputIter1 last1, InputIter2 first2,
-    InputIter2 last2, Compred comp) {
+MYSTL_CONSTEXPR20 bool lexicographical_compare(InputIter1 first1, InputIter1 last1,
+    InputIter2 first2, InputIter2 last2, Compred comp) {
     for (; first1 != last1 && first2 != last2; ++first1, ++first2) {
         if (comp(*first1, *first2))
             return true;
@@ -399,24 +485,13 @@ bool lexicographical_compare(InputIter1 first1, InputIter1 last1, InputIter2 fir
     return first1 == last1 && first2 != last2;
 }
 
-// 针对 const unsigned char* 的特化版本
-bool lexicographical_compare(const unsigned char* first1, const unsigned char* last1,
-    const unsigned char* first2, const unsigned char* last2) {
-    const auto len1 = last1 - first1;
-    const auto len2 = last2 - first2;
-    // 先比较相同长度的部分
-    const auto result = std::memcmp(first1, first2, mystl::min(len1, len2));
-    // 若相等，长度较长的比较大
-    return result != 0 ? result < 0 : len1 < len2;
-}
-
 /*****************************************************************************************/
 // mismatch
 // 平行比较两个序列，找到第一处失配的元素，返回一对迭代器，分别指向两个序列中失配的元素
 /*****************************************************************************************/
 template <class InputIter1, class InputIter2>
-mystl::pair<InputIter1, InputIter2> mismatch(
-    InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+MYSTL_CONSTEXPR20 mystl::pair<InputIter1, InputIter2> mismatch_cat(
+    InputIter1 first1, InputIter1 last1, InputIter2 first2, m_false_type) {
     while (first1 != last1 && *first1 == *first2) {
         ++first1;
         ++first2;
@@ -424,9 +499,26 @@ mystl::pair<InputIter1, InputIter2> mismatch(
     return mystl::pair<InputIter1, InputIter2>(first1, first2);
 }
 
+template <class Tp1, class Tp2>
+MYSTL_CONSTEXPR20 mystl::pair<Tp1*, Tp2*> mismatch_cat(
+    Tp1* first1, Tp1* last1, Tp2* first2, m_true_type) {
+    if (mystl::is_constant_evaluated())
+        return mystl::mismatch_cat(first1, last1, first2, m_false_type{});
+    const auto i =
+        mystl::bytewise_mismatch(first1, first2, static_cast<size_t>(last1 - first1));
+    return mystl::pair<Tp1*, Tp2*>(first1 + i, first2 + i);
+}
+
+template <class InputIter1, class InputIter2>
+MYSTL_CONSTEXPR20 mystl::pair<InputIter1, InputIter2> mismatch(
+    InputIter1 first1, InputIter1 last1, InputIter2 first2) {
+    return mystl::mismatch_cat(first1, last1, first2,
+        m_bool_constant<is_bytewise_comparable<InputIter1, InputIter2>::value>{});
+}
+
 // 重载版本使用函数对象 comp 代替比较操作
 template <class InputIter1, class InputIter2, class Compred>
-mystl::pair<InputIter1, InputIter2> mismatch(
+MYSTL_CONSTEXPR20 mystl::pair<InputIter1, InputIter2> mismatch(
     InputIter1 first1, InputIter1 last1, InputIter2 first2, Compred comp) {
     while (first1 != last1 && comp(*first1, *first2)) {
         ++first1;
@@ -435,5 +527,127 @@ mystl::pair<InputIter1, InputIter2> mismatch(
     return mystl::pair<InputIter1, InputIter2>(first1, first2);
 }
 
+/*****************************************************************************************/
+// branchless_partition_point
+// 在有序区间 [first, first + n) 上查找第一个不满足 less(*it) 的位置
+// 每轮只根据比较结果选择新的起点，编译器可以生成条件传送指令而不是分支
+template <class RandomIter, class Less>
+MYSTL_CONSTEXPR20 RandomIter branchless_partition_point(RandomIter first, size_t n, Less less) {
+    if (n == 0)
+        return first;
+    while (n > 1) {
+        const size_t half = n / 2;
+        first = less(first[half]) ? first + half : first;
+        n -= half;
+    }
+    return first + (less(*first) ? 1 : 0);
+}
+
+/*****************************************************************************************/
+// 带执行策略的 copy / move / fill / fill_n
+// 策略允许并行且迭代器都是随机访问迭代器时，把区间分段交给线程池，否则使用顺序版本
+/*****************************************************************************************/
+template <class ExecutionPolicy, class Iter1, class Iter2 = Iter1>
+struct use_parallel
+    : m_bool_constant<
+          execution::is_parallel_policy<typename std::decay<ExecutionPolicy>::type>::value &&
+          is_random_access_iterator<Iter1>::value && is_random_access_iterator<Iter2>::value> {
+};
+
+// copy
+template <class InputIter, class OutputIter>
+OutputIter par_copy(InputIter first, InputIter last, OutputIter result, m_false_type) {
+    return mystl::copy(first, last, result);
+}
+
+template <class RandomIter, class OutputIter>
+OutputIter par_copy(RandomIter first, RandomIter last, OutputIter result, m_true_type) {
+    const auto n = static_cast<size_t>(last - first);
+    const auto split = execution::split_range(
+        n, sizeof(typename iterator_traits<RandomIter>::value_type));
+    if (split.count == 1)
+        return mystl::copy(first, last, result);
+    execution::parallel_ranges(split, [&](size_t b, size_t e) {
+        mystl::copy(first + b, first + e, result + b);
+    });
+    return result + n;
+}
+
+template <class ExecutionPolicy, class InputIter, class OutputIter>
+execution::enable_if_execution_policy<ExecutionPolicy, OutputIter> copy(
+    ExecutionPolicy&&, InputIter first, InputIter last, OutputIter result) {
+    return mystl::par_copy(
+        first, last, result, use_parallel<ExecutionPolicy, InputIter, OutputIter>{});
+}
+
+// move
+template <class InputIter, class OutputIter>
+OutputIter par_move(InputIter first, InputIter last, OutputIter result, m_false_type) {
+    return mystl::move(first, last, result);
+}
+
+template <class RandomIter, class OutputIter>
+OutputIter par_move(RandomIter first, RandomIter last, OutputIter result, m_true_type) {
+    const auto n = static_cast<size_t>(last - first);
+    const auto split = execution::split_range(
+        n, sizeof(typename iterator_traits<RandomIter>::value_type));
+    if (split.count == 1)
+        return mystl::move(first, last, result);
+    execution::parallel_ranges(split, [&](size_t b, size_t e) {
+        mystl::move(first + b, first + e, result + b);
+    });
+    return result + n;
+}
+
+template <class ExecutionPolicy, class InputIter, class OutputIter>
+execution::enable_if_execution_policy<ExecutionPolicy, OutputIter> move(
+    ExecutionPolicy&&, InputIter first, InputIter last, OutputIter result) {
+    return mystl::par_move(
+        first, last, result, use_parallel<ExecutionPolicy, InputIter, OutputIter>{});
+}
+
+// fill_n
+template <class OutputIter, class Size, class T>
+OutputIter par_fill_n(OutputIter first, Size n, const T& value, m_false_type) {
+    return mystl::fill_n(first, n, value);
+}
+
+template <class RandomIter, class Size, class T>
+RandomIter par_fill_n(RandomIter first, Size n, const T& value, m_true_type) {
+    if (n <= 0)
+        return first;
+    const auto split = execution::split_range(
+        static_cast<size_t>(n), sizeof(typename iterator_traits<RandomIter>::value_type));
+    if (split.count == 1)
+        return mystl::fill_n(first, n, value);
+    execution::parallel_ranges(split, [&](size_t b, size_t e) {
+        mystl::fill_n(first + b, e - b, value);
+    });
+    return first + static_cast<size_t>(n);
+}
+
+template <class ExecutionPolicy, class OutputIter, class Size, class T>
+execution::enable_if_execution_policy<ExecutionPolicy, OutputIter> fill_n(
+    ExecutionPolicy&&, OutputIter first, Size n, const T& value) {
+    return mystl::par_fill_n(first, n, value, use_parallel<ExecutionPolicy, OutputIter>{});
+}
+
+// fill
+template <class ForwardIter, class T>
+void par_fill(ForwardIter first, ForwardIter last, const T& value, m_false_type) {
+    mystl::fill(first, last, value);
+}
+
+template <class RandomIter, class T>
+void par_fill(RandomIter first, RandomIter last, const T& value, m_true_type) {
+    mystl::par_fill_n(first, last - first, value, m_true_type{});
+}
+
+template <class ExecutionPolicy, class ForwardIter, class T>
+execution::enable_if_execution_policy<ExecutionPolicy, void> fill(
+    ExecutionPolicy&&, ForwardIter first, ForwardIter last, const T& value) {
+    mystl::par_fill(first, last, value, use_parallel<ExecutionPolicy, ForwardIter>{});
+}
+
 } // namespace mystl
 #endif // !MYTINYSTL_ALGOBASE_H_
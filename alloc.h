@@ -1 +1,472 @@
+#pragma once
 
+// 这个头文件包含一个类 alloc，以内存池的方式分配和回收小块内存
+//
+// 小于等于 4096 bytes 的请求按大小分为 56 个级别，每个级别维护一条自由链表；
+// 自由链表为空时，一次从内存池中批量切出若干块补充进来，
+// 内存池不足时再向系统申请一大块 chunk。
+// 大于 4096 bytes 的请求直接交给 malloc / free。
+// 不小于 MYSTL_MMAP_THRESHOLD 的超大块在 Linux 上直接用 mmap 映射，并提示内核使用透明大页，
+// 扩容时用 mremap 重新映射，不需要复制数据。定义 MYSTL_NO_MMAP 可以关闭这条路径。
+// 回收的小块只会挂回自由链表，不会归还给系统。
+// allocate_zeroed 返回清零的空间：超大块直接使用内核清零的新页面，大块使用 calloc，
+// 都不需要逐字节写入，页面在第一次访问时才真正分配。
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#if defined(__linux__) && !defined(MYSTL_NO_MMAP)
+#include <sys/mman.h>
+#include <unistd.h>
+#define MYSTL_HAS_MMAP 1
+#endif
+
+// 使用 mmap 的阈值，分配和回收都按请求的大小判断路径，因此只能在编译期调整
+#ifndef MYSTL_MMAP_THRESHOLD
+#define MYSTL_MMAP_THRESHOLD (static_cast<size_t>(32) << 20)
+#endif
+
+namespace mystl {
+
+// 自由链表的节点，空闲时用 next 串联，分配出去后整块交给使用者
+union FreeList {
+    union FreeList* next;
+    char data[1];
+};
+
+// 不同内存范围的上调大小
+enum {
+    EAlign128 = 8,
+    EAlign256 = 16,
+    EAlign512 = 32,
+    EAlign1024 = 64,
+    EAlign2048 = 128,
+    EAlign4096 = 256
+};
+
+// 小对象的内存上限
+enum { ESmallObjectBytes = 4096 };
+
+// free lists 个数
+enum { EFreeListsNumber = 56 };
+
+// 每次补充自由链表时最多切出的块数，以及一次补充的目标字节数
+enum { ERefillObjects = 20 };
+enum { ERefillBytes = 16384 };
+
+// 内存池分配出去的块保证的对齐值
+enum { EPoolAlign = EAlign128 };
+
+class alloc {
+private:
+    struct pool_state {
+        char* start_free;                       // 内存池起始位置
+        char* end_free;                         // 内存池结束位置
+        size_t heap_size;                       // 已向系统申请的总大小
+        FreeList* free_list[EFreeListsNumber];  // 自由链表
+        std::mutex mutex;
+    };
+
+public:
+    static void* allocate(size_t n);
+    static void deallocate(void* p, size_t n);
+    static void* reallocate(void* p, size_t old_size, size_t new_size);
+
+    // 与 allocate 相同，返回的 p 前 usable_size(p, n) 个字节都为 0
+    static void* allocate_zeroed(size_t n);
+
+    // 批量取出 / 归还 n bytes 级别的块，供线程缓存等前端一次性搬运使用
+    static size_t allocate_batch(size_t n, size_t count, FreeList*& head);
+    static void deallocate_batch(size_t n, FreeList* head, FreeList* tail);
+
+    // 判断 n bytes 的请求是否由内存池负责
+    static bool is_small(size_t n) noexcept {
+        return n <= static_cast<size_t>(ESmallObjectBytes);
+    }
+
+    // 判断 n bytes 的请求是否直接映射页面
+    static bool is_huge(size_t n) noexcept {
+#ifdef MYSTL_HAS_MMAP
+        return n >= MYSTL_MMAP_THRESHOLD;
+#else
+        (void)n;
+        return false;
+#endif
+    }
+
+    // 返回 n bytes 的请求实际占用的大小
+    static size_t round_up(size_t n) noexcept {
+        return is_small(n) ? M_round_up(n == 0 ? 1 : n) : n;
+    }
+
+    // 返回 allocate(n) 得到的 p 实际可用的大小，以这个大小释放 p 同样合法。
+    // 释放时按大小选择路径，malloc 得到的块报告的大小不能达到 mmap 的阈值
+    static size_t usable_size(void* p, size_t n) noexcept {
+        if (is_small(n))
+            return M_round_up(n == 0 ? 1 : n);
+        if (is_huge(n))
+            return M_page_round(n);
+#if defined(__GLIBC__)
+        const size_t usable = ::malloc_usable_size(p);
+        return is_huge(usable) ? MYSTL_MMAP_THRESHOLD - 1 : usable;
+#else
+        (void)p;
+        return n;
+#endif
+    }
+
+    // 返回 n bytes 所在级别的编号及每次补充的块数
+    static size_t freelist_index(size_t n) noexcept {
+        return M_freelist_index(n == 0 ? 1 : n);
+    }
+
+    static size_t refill_number(size_t n) noexcept {
+        return M_refill_number(round_up(n));
+    }
+
+private:
+    static pool_state& M_state();
+    static size_t M_page_round(size_t bytes) noexcept;
+    static void* M_map(size_t n);
+    static void M_unmap(void* p, size_t n) noexcept;
+    static void* M_remap(void* p, size_t old_size, size_t new_size);
+    static size_t M_align(size_t bytes);
+    static size_t M_round_up(size_t bytes);
+    static size_t M_freelist_index(size_t bytes);
+    static size_t M_refill_number(size_t bytes);
+    static void M_push_block(char* p, size_t bytes);
+    static void* M_refill(size_t n);
+    static char* M_chunk_alloc(size_t size, size_t& nblock);
+};
+
+// 内存池状态只构造不析构，避免其他静态对象析构时再访问已销毁的内存池
+inline alloc::pool_state& alloc::M_state() {
+    static pool_state* state = ::new pool_state();
+    return *state;
+}
+
+// 分配大小为 n 的空间， n > 0
+inline void* alloc::allocate(size_t n) {
+    if (n == 0)
+        n = 1;
+    if (is_huge(n))
+        return M_map(n);
+    if (!is_small(n)) {
+        void* p = std::malloc(n);
+        if (p == nullptr)
+            throw std::bad_alloc();
+        return p;
+    }
+
+    auto& state = M_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    FreeList** my_free_list = &state.free_list[M_freelist_index(n)];
+    FreeList* result = *my_free_list;
+    if (result == nullptr) {
+        return M_refill(M_round_up(n));
+    }
+    *my_free_list = result->next;
+    return result;
+}
+
+// 分配大小为 n 的清零空间
+inline void* alloc::allocate_zeroed(size_t n) {
+    if (n == 0)
+        n = 1;
+    // 新映射的匿名页面由内核清零
+    if (is_huge(n))
+        return M_map(n);
+    if (!is_small(n)) {
+        void* p = std::calloc(1, n);
+        if (p == nullptr)
+            throw std::bad_alloc();
+        return p;
+    }
+    void* p = allocate(n);
+    std::memset(p, 0, M_round_up(n));
+    return p;
+}
+
+// 释放 p 指向的大小为 n 的空间, p 不能为 0
+inline void alloc::deallocate(void* p, size_t n) {
+    if (p == nullptr)
+        return;
+    if (n == 0)
+        n = 1;
+    if (is_huge(n)) {
+        M_unmap(p, n);
+        return;
+    }
+    if (!is_small(n)) {
+        std::free(p);
+        return;
+    }
+
+    auto& state = M_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    FreeList* q = static_cast<FreeList*>(p);
+    FreeList** my_free_list = &state.free_list[M_freelist_index(n)];
+    q->next = *my_free_list;
+    *my_free_list = q;
+}
+
+// 重新分配空间，接受三个参数，参数一为指向新空间的指针，参数二为原来空间的大小，参数三为申请空间的大小
+// 内容按字节搬到新空间，大块之间使用 realloc，超大块之间使用 mremap，可能原地扩展而不需要复制
+inline void* alloc::reallocate(void* p, size_t old_size, size_t new_size) {
+    if (p == nullptr)
+        return allocate(new_size);
+    if (is_huge(old_size) && is_huge(new_size))
+        return M_remap(p, old_size, new_size);
+    if (!is_small(old_size) && !is_small(new_size) && !is_huge(old_size) &&
+        !is_huge(new_size)) {
+        void* result = std::realloc(p, new_size);
+        if (result == nullptr)
+            throw std::bad_alloc();
+        return result;
+    }
+    // 同一级别的块已经足够容纳新的大小
+    if (is_small(old_size) && is_small(new_size) &&
+        round_up(old_size) == round_up(new_size))
+        return p;
+
+    void* result = allocate(new_size);
+    std::memcpy(result, p, old_size < new_size ? old_size : new_size);
+    deallocate(p, old_size);
+    return result;
+}
+
+// 取出至多 count 个 n bytes 级别的块，串成以 nullptr 结尾的链表，返回实际取得的个数
+inline size_t alloc::allocate_batch(size_t n, size_t count, FreeList*& head) {
+    head = nullptr;
+    if (count == 0)
+        return 0;
+    const size_t size = round_up(n);
+
+    auto& state = M_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    FreeList** my_free_list = &state.free_list[M_freelist_index(size)];
+    size_t got = 0;
+    while (got < count && *my_free_list != nullptr) {
+        FreeList* p = *my_free_list;
+        *my_free_list = p->next;
+        p->next = head;
+        head = p;
+        ++got;
+    }
+    if (got != 0)
+        return got;
+
+    // 自由链表已空，直接从内存池中切出一批
+    size_t nblock = count;
+    char* c = M_chunk_alloc(size, nblock);
+    for (size_t i = 0; i < nblock; ++i) {
+        FreeList* p = reinterpret_cast<FreeList*>(c + i * size);
+        p->next = head;
+        head = p;
+    }
+    return nblock;
+}
+
+// 把 [head, tail] 这一串 n bytes 级别的块一次性挂回自由链表
+inline void alloc::deallocate_batch(size_t n, FreeList* head, FreeList* tail) {
+    if (head == nullptr)
+        return;
+    auto& state = M_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    FreeList** my_free_list = &state.free_list[M_freelist_index(round_up(n))];
+    tail->next = *my_free_list;
+    *my_free_list = head;
+}
+
+// 把 bytes 上调为页大小的整数倍
+inline size_t alloc::M_page_round(size_t bytes) noexcept {
+#ifdef MYSTL_HAS_MMAP
+    static const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    return (bytes + page - 1) & ~(page - 1);
+#else
+    return bytes;
+#endif
+}
+
+#ifdef MYSTL_HAS_MMAP
+
+// 映射 n bytes 的匿名页面，并提示内核使用透明大页以减少 TLB 缺失
+inline void* alloc::M_map(size_t n) {
+    const size_t len = M_page_round(n);
+    void* p =
+        ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+        throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+    ::madvise(p, len, MADV_HUGEPAGE);
+#endif
+    return p;
+}
+
+inline void alloc::M_unmap(void* p, size_t n) noexcept {
+    ::munmap(p, M_page_round(n));
+}
+
+// 重新映射，内核只调整页表，不复制数据
+inline void* alloc::M_remap(void* p, size_t old_size, size_t new_size) {
+    const size_t old_len = M_page_round(old_size);
+    const size_t new_len = M_page_round(new_size);
+    if (old_len == new_len)
+        return p;
+    void* result = ::mremap(p, old_len, new_len, MREMAP_MAYMOVE);
+    if (result == MAP_FAILED)
+        throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+    if (new_len > old_len)
+        ::madvise(result, new_len, MADV_HUGEPAGE);
+#endif
+    return result;
+}
+
+#else
+
+inline void* alloc::M_map(size_t n) {
+    return std::malloc(n);
+}
+
+inline void alloc::M_unmap(void* p, size_t) noexcept {
+    std::free(p);
+}
+
+inline void* alloc::M_remap(void* p, size_t, size_t new_size) {
+    return std::realloc(p, new_size);
+}
+
+#endif // MYSTL_HAS_MMAP
+
+// bytes 对应上调大小
+inline size_t alloc::M_align(size_t bytes) {
+    if (bytes <= 512) {
+        return bytes <= 256 ? bytes <= 128 ? EAlign128 : EAlign256 : EAlign512;
+    }
+    return bytes <= 2048 ? bytes <= 1024 ? EAlign1024 : EAlign2048 : EAlign4096;
+}
+
+// 将 bytes 上调至对应区间大小
+inline size_t alloc::M_round_up(size_t bytes) {
+    const size_t align = M_align(bytes);
+    return (bytes + align - 1) & ~(align - 1);
+}
+
+// 根据区块大小，选择第 n 个 free lists
+inline size_t alloc::M_freelist_index(size_t bytes) {
+    if (bytes <= 512) {
+        return bytes <= 256
+                   ? bytes <= 128 ? ((bytes + EAlign128 - 1) / EAlign128 - 1)
+                                  : (15 + (bytes + EAlign256 - 129) / EAlign256)
+                   : (23 + (bytes + EAlign512 - 257) / EAlign512);
+    }
+    return bytes <= 2048
+               ? bytes <= 1024 ? (31 + (bytes + EAlign1024 - 513) / EAlign1024)
+                               : (39 + (bytes + EAlign2048 - 1025) / EAlign2048)
+               : (47 + (bytes + EAlign4096 - 2049) / EAlign4096);
+}
+
+// 补充自由链表时切出的块数，大块少切一些以免一次占用过多内存
+inline size_t alloc::M_refill_number(size_t bytes) {
+    const size_t n = ERefillBytes / bytes;
+    const size_t max_n = ERefillObjects;
+    return n < 2 ? 2 : n > max_n ? max_n : n;
+}
+
+// 把内存池中剩余的零头拆成若干个合法大小的块挂到自由链表上
+inline void alloc::M_push_block(char* p, size_t bytes) {
+    auto& state = M_state();
+    while (bytes >= EAlign128) {
+        const size_t size = bytes & ~(M_align(bytes) - 1);
+        FreeList* q = reinterpret_cast<FreeList*>(p);
+        FreeList** my_free_list = &state.free_list[M_freelist_index(size)];
+        q->next = *my_free_list;
+        *my_free_list = q;
+        p += size;
+        bytes -= size;
+    }
+}
+
+// 重新填充 free list，n 已经上调至对应大小，调用者需持有锁
+inline void* alloc::M_refill(size_t n) {
+    size_t nblock = M_refill_number(n);
+    char* c = M_chunk_alloc(n, nblock);
+    if (nblock == 1)
+        return c;
+
+    // 第一块返回给调用者，其余的串成链表挂到对应的 free list 上
+    FreeList** my_free_list = &M_state().free_list[M_freelist_index(n)];
+    FreeList* result = reinterpret_cast<FreeList*>(c);
+    FreeList* cur = reinterpret_cast<FreeList*>(c + n);
+    *my_free_list = cur;
+    for (size_t i = 2; i < nblock; ++i) {
+        FreeList* next = reinterpret_cast<FreeList*>(reinterpret_cast<char*>(cur) + n);
+        cur->next = next;
+        cur = next;
+    }
+    cur->next = nullptr;
+    return result;
+}
+
+// 从内存池中取空间给 free list 使用，条件不允许时，会调整 nblock
+inline char* alloc::M_chunk_alloc(size_t size, size_t& nblock) {
+    auto& state = M_state();
+    char* result = nullptr;
+    size_t need_bytes = size * nblock;
+    size_t pool_bytes = static_cast<size_t>(state.end_free - state.start_free);
+
+    // 如果内存池剩余大小完全满足需求量，返回它
+    if (pool_bytes >= need_bytes) {
+        result = state.start_free;
+        state.start_free += need_bytes;
+        return result;
+    }
+
+    // 如果内存池剩余大小不能完全满足需求量，但至少可以分配一个或一个以上的区块，就返回它
+    if (pool_bytes >= size) {
+        nblock = pool_bytes / size;
+        need_bytes = size * nblock;
+        result = state.start_free;
+        state.start_free += need_bytes;
+        return result;
+    }
+
+    // 如果内存池剩余大小连一个区块都无法满足，先把零头挂到自由链表上
+    if (pool_bytes > 0) {
+        M_push_block(state.start_free, pool_bytes);
+        state.start_free = state.end_free;
+    }
+
+    // 申请新的 chunk，大小随已申请总量增长
+    const size_t bytes_to_get = (need_bytes << 1) + M_round_up((state.heap_size >> 4) + 1);
+    state.start_free = static_cast<char*>(::operator new(bytes_to_get, std::nothrow));
+    if (state.start_free == nullptr) {
+        // 系统内存不足，试着从更大的 free list 中借一块当作内存池
+        for (size_t i = size + M_align(size + 1); i <= ESmallObjectBytes;
+             i += M_align(i + 1)) {
+            FreeList** my_free_list = &state.free_list[M_freelist_index(i)];
+            FreeList* p = *my_free_list;
+            if (p != nullptr) {
+                *my_free_list = p->next;
+                state.start_free = reinterpret_cast<char*>(p);
+                state.end_free = state.start_free + i;
+                return M_chunk_alloc(size, nblock);
+            }
+        }
+        state.end_free = nullptr;
+        throw std::bad_alloc();
+    }
+    state.end_free = state.start_free + bytes_to_get;
+    state.heap_size += bytes_to_get;
+    return M_chunk_alloc(size, nblock);
+}
+
+} // namespace mystl
@@ -0,0 +1,249 @@
+#pragma once
+
+// 这个头文件包含 allocator 的内存统计
+//
+// 定义 MYSTL_ALLOC_STATS 时，allocator<T> 的每次分配、释放和重新分配都会按 T 记录：
+// 分配次数、释放次数、重新分配次数、当前占用字节数、峰值字节数以及按 2 的幂分级的大小直方图。
+// 计数器使用 relaxed 原子操作，可以在多线程下使用。
+// 未定义时统计钩子是空函数，不产生任何开销，快照接口也不会返回任何类型。
+//
+// alloc_stats_visit(fn)  : 对每个有过分配的类型调用 fn(const alloc_stats_snapshot&)
+// alloc_stats_dump(file) : 以 CSV 格式输出所有类型的统计，便于导出到监控系统
+// alloc_stats_reset()    : 清零计数器，峰值重置为当前占用
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+#if defined(MYSTL_ALLOC_STATS) && (defined(__cpp_rtti) || defined(__GXX_RTTI))
+#include <typeinfo>
+#define MYSTL_ALLOC_STATS_RTTI 1
+#endif
+
+namespace mystl {
+
+enum { EStatsBuckets = 40 }; // 直方图的级数，第 i 级为 [2^i, 2^(i+1)) bytes，最后一级不设上限
+
+// 某个类型在某一时刻的统计
+struct alloc_stats_snapshot {
+    const char* type_name;    // 编译器给出的类型名，可能是修饰过的名字
+    size_t type_size;         // sizeof(T)
+    uint64_t allocations;     // 分配次数
+    uint64_t deallocations;   // 释放次数
+    uint64_t reallocations;   // 调用 reallocate 的次数，同时计入一次分配和一次释放
+    uint64_t bytes_allocated; // 累计分配的字节数
+    int64_t bytes_live;       // 当前占用的字节数
+    int64_t peak_bytes;       // 当前占用字节数的峰值
+    uint64_t histogram[EStatsBuckets];
+};
+
+/*****************************************************************************************/
+// alloc_type_stats
+// 单个类型的计数器，第一次使用时加入全局链表，之后不会被释放
+/*****************************************************************************************/
+class alloc_type_stats {
+public:
+    alloc_type_stats(const char* name, size_t size) noexcept;
+
+    void record_allocate(size_t bytes) noexcept;
+    void record_deallocate(size_t bytes) noexcept;
+    void record_reallocate(size_t old_bytes, size_t new_bytes) noexcept;
+
+    void snapshot(alloc_stats_snapshot& s) const noexcept;
+    void reset() noexcept;
+
+    const alloc_type_stats* next() const noexcept {
+        return next_;
+    }
+
+    static const alloc_type_stats* head() noexcept {
+        return M_head().load(std::memory_order_acquire);
+    }
+
+private:
+    static std::atomic<alloc_type_stats*>& M_head() noexcept {
+        static std::atomic<alloc_type_stats*> head(nullptr);
+        return head;
+    }
+
+    static size_t M_bucket(size_t bytes) noexcept;
+
+    const char* name_;
+    size_t size_;
+    std::atomic<uint64_t> allocations_;
+    std::atomic<uint64_t> deallocations_;
+    std::atomic<uint64_t> reallocations_;
+    std::atomic<uint64_t> bytes_allocated_;
+    std::atomic<int64_t> bytes_live_;
+    std::atomic<int64_t> peak_bytes_;
+    std::atomic<uint64_t> histogram_[EStatsBuckets];
+    alloc_type_stats* next_;
+};
+
+inline alloc_type_stats::alloc_type_stats(const char* name, size_t size) noexcept
+    : name_(name)
+    , size_(size)
+    , allocations_(0)
+    , deallocations_(0)
+    , reallocations_(0)
+    , bytes_allocated_(0)
+    , bytes_live_(0)
+    , peak_bytes_(0)
+    , next_(nullptr) {
+    for (auto& h : histogram_) {
+        h.store(0, std::memory_order_relaxed);
+    }
+    // 头插法加入链表，遍历的一方只会看到完整构造的节点
+    alloc_type_stats* old_head = M_head().load(std::memory_order_relaxed);
+    do {
+        next_ = old_head;
+    } while (!M_head().compare_exchange_weak(
+        old_head, this, std::memory_order_release, std::memory_order_relaxed));
+}
+
+inline size_t alloc_type_stats::M_bucket(size_t bytes) noexcept {
+    size_t i = 0;
+    while (bytes > 1 && i + 1 < static_cast<size_t>(EStatsBuckets)) {
+        bytes >>= 1;
+        ++i;
+    }
+    return i;
+}
+
+inline void alloc_type_stats::record_allocate(size_t bytes) noexcept {
+    allocations_.fetch_add(1, std::memory_order_relaxed);
+    bytes_allocated_.fetch_add(bytes, std::memory_order_relaxed);
+    histogram_[M_bucket(bytes)].fetch_add(1, std::memory_order_relaxed);
+    const int64_t live =
+        bytes_live_.fetch_add(static_cast<int64_t>(bytes), std::memory_order_relaxed) +
+        static_cast<int64_t>(bytes);
+    int64_t peak = peak_bytes_.load(std::memory_order_relaxed);
+    while (live > peak &&
+           !peak_bytes_.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+}
+
+inline void alloc_type_stats::record_deallocate(size_t bytes) noexcept {
+    deallocations_.fetch_add(1, std::memory_order_relaxed);
+    bytes_live_.fetch_sub(static_cast<int64_t>(bytes), std::memory_order_relaxed);
+}
+
+inline void alloc_type_stats::record_reallocate(
+    size_t old_bytes, size_t new_bytes) noexcept {
+    reallocations_.fetch_add(1, std::memory_order_relaxed);
+    record_deallocate(old_bytes);
+    record_allocate(new_bytes);
+}
+
+inline void alloc_type_stats::snapshot(alloc_stats_snapshot& s) const noexcept {
+    s.type_name = name_;
+    s.type_size = size_;
+    s.allocations = allocations_.load(std::memory_order_relaxed);
+    s.deallocations = deallocations_.load(std::memory_order_relaxed);
+    s.reallocations = reallocations_.load(std::memory_order_relaxed);
+    s.bytes_allocated = bytes_allocated_.load(std::memory_order_relaxed);
+    s.bytes_live = bytes_live_.load(std::memory_order_relaxed);
+    s.peak_bytes = peak_bytes_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < static_cast<size_t>(EStatsBuckets); ++i) {
+        s.histogram[i] = histogram_[i].load(std::memory_order_relaxed);
+    }
+}
+
+// 当前占用的字节数不清零，否则之后的释放会让它变为负数
+inline void alloc_type_stats::reset() noexcept {
+    allocations_.store(0, std::memory_order_relaxed);
+    deallocations_.store(0, std::memory_order_relaxed);
+    reallocations_.store(0, std::memory_order_relaxed);
+    bytes_allocated_.store(0, std::memory_order_relaxed);
+    peak_bytes_.store(
+        bytes_live_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    for (auto& h : histogram_) {
+        h.store(0, std::memory_order_relaxed);
+    }
+}
+
+/*****************************************************************************************/
+// alloc_stats_hook
+// allocator<T> 调用的统计钩子，未定义 MYSTL_ALLOC_STATS 时全部为空函数
+/*****************************************************************************************/
+#ifdef MYSTL_ALLOC_STATS
+
+template <typename T>
+struct alloc_stats_hook {
+    static alloc_type_stats& stats() noexcept {
+        // 故意不析构，静态对象析构之后仍可能有内存被释放
+#ifdef MYSTL_ALLOC_STATS_RTTI
+        static alloc_type_stats* s = new alloc_type_stats(typeid(T).name(), sizeof(T));
+#else
+        static alloc_type_stats* s = new alloc_type_stats("?", sizeof(T));
+#endif
+        return *s;
+    }
+
+    static void on_allocate(size_t bytes) noexcept {
+        stats().record_allocate(bytes);
+    }
+
+    static void on_deallocate(size_t bytes) noexcept {
+        stats().record_deallocate(bytes);
+    }
+
+    static void on_reallocate(size_t old_bytes, size_t new_bytes) noexcept {
+        stats().record_reallocate(old_bytes, new_bytes);
+    }
+};
+
+#else
+
+template <typename T>
+struct alloc_stats_hook {
+    static void on_allocate(size_t) noexcept {}
+    static void on_deallocate(size_t) noexcept {}
+    static void on_reallocate(size_t, size_t) noexcept {}
+};
+
+#endif // MYSTL_ALLOC_STATS
+
+/*****************************************************************************************/
+// 快照接口
+/*****************************************************************************************/
+template <class Fn>
+void alloc_stats_visit(Fn fn) {
+    alloc_stats_snapshot s;
+    for (auto p = alloc_type_stats::head(); p != nullptr; p = p->next()) {
+        p->snapshot(s);
+        fn(static_cast<const alloc_stats_snapshot&>(s));
+    }
+}
+
+inline void alloc_stats_reset() noexcept {
+    for (auto p = alloc_type_stats::head(); p != nullptr; p = p->next()) {
+        const_cast<alloc_type_stats*>(p)->reset();
+    }
+}
+
+// 每个类型输出一行：type,type_size,allocations,deallocations,reallocations,
+// bytes_allocated,bytes_live,peak_bytes,h0,...,h39，第一行为表头
+inline void alloc_stats_dump(std::FILE* out) {
+    std::fprintf(out, "type,type_size,allocations,deallocations,reallocations,"
+                      "bytes_allocated,bytes_live,peak_bytes");
+    for (int i = 0; i < EStatsBuckets; ++i) {
+        std::fprintf(out, ",h%d", i);
+    }
+    std::fprintf(out, "\n");
+    alloc_stats_visit([out](const alloc_stats_snapshot& s) {
+        std::fprintf(out, "%s,%zu,%llu,%llu,%llu,%llu,%lld,%lld", s.type_name, s.type_size,
+            static_cast<unsigned long long>(s.allocations),
+            static_cast<unsigned long long>(s.deallocations),
+            static_cast<unsigned long long>(s.reallocations),
+            static_cast<unsigned long long>(s.bytes_allocated),
+            static_cast<long long>(s.bytes_live), static_cast<long long>(s.peak_bytes));
+        for (int i = 0; i < EStatsBuckets; ++i) {
+            std::fprintf(out, ",%llu", static_cast<unsigned long long>(s.histogram[i]));
+        }
+        std::fprintf(out, "\n");
+    });
+}
+
+} // namespace mystl
@@ -1,10 +1,43 @@
 #pragma once
 
+// 这个头文件包含一个模板类 allocator，用于管理内存的分配、释放，对象的构造、析构
+// 小块内存交给内存池管理，其余的直接使用 ::operator new / ::operator delete
+//
+// 内存池后端可以在编译期切换，便于对比测试：
+// 默认使用带线程缓存的 thread_alloc
+// 定义 MYSTL_NO_THREAD_CACHE 时直接使用全局内存池 alloc
+// 定义 MYSTL_NO_POOL 时不使用内存池，全部交给 ::operator new / ::operator delete
+//
+// 定义 MYSTL_ALLOC_STATS 时按类型记录分配统计，见 alloc_stats.h
+//
+// C++20 下分配和释放可以在常量求值中使用，此时改用 std::allocator，不经过内存池也不记录统计
+
+#include <cstring>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "alloc.h"
+#include "alloc_stats.h"
 #include "construct.h"
+#include "thread_alloc.h"
 #include "util.h"
 
 namespace mystl {
 
+#ifdef MYSTL_NO_THREAD_CACHE
+using pool_alloc = mystl::alloc;
+#else
+using pool_alloc = mystl::thread_alloc;
+#endif
+
+// allocate_at_least 的返回值，count 为实际得到的元素个数，不小于请求的个数
+template <typename Pointer>
+struct allocation_result {
+    Pointer ptr;
+    size_t count;
+};
+
 template <typename T>
 class allocator {
 public:
@@ -16,80 +49,432 @@ public:
     using const_reference   = const T&;
     using size_type         = size_t;
     using difference_type   = ptrdiff_t;
+
+    // allocator 没有状态，任意两个实例都可以互相释放对方分配的内存
+    using propagate_on_container_move_assignment    = std::true_type;
+    using is_always_equal                           = std::true_type;
     // clang-format on
 
+    template <typename U>
+    struct rebind {
+        using other = allocator<U>;
+    };
+
 public:
-    static T* allocate();
-    static T* allocate(size_type n);
+    constexpr allocator() noexcept = default;
+
+    template <typename U>
+    constexpr allocator(const allocator<U>&) noexcept {}
+
+public:
+    static MYSTL_CONSTEXPR20 T* allocate();
+    static MYSTL_CONSTEXPR20 T* allocate(size_type n);
+
+    // 申请至少 n 个元素的空间，返回的 count 反映内存池级别或 malloc 实际给出的大小
+    static MYSTL_CONSTEXPR20 allocation_result<T*> allocate_at_least(size_type n);
 
-    static void deallocate(T* ptr);
-    static void deallocate(T* ptr, size_type n);
+    // 与 allocate_at_least 相同，并且 count 个元素的空间全部为 0 字节。
+    // 大块内存直接取自 calloc 或新映射的页面，不需要逐字节清零。
+    // 常量求值中没有“按字节为 0”的对象，改为逐个值初始化
+    static MYSTL_CONSTEXPR20 allocation_result<T*> allocate_zeroed(size_type n);
 
-    static void construct(T* ptr);
-    static void construct(T* ptr, const_reference value);
-    static void construct(T* ptr, T&& value);
+    static MYSTL_CONSTEXPR20 void deallocate(T* ptr);
+    static MYSTL_CONSTEXPR20 void deallocate(T* ptr, size_type n);
+
+    // 把 ptr 上 old_n 个元素的空间调整为至少 new_n 个，内容按字节搬动，
+    // 只能用于可平凡重定位的类型，大块内存可能原地扩展
+    static allocation_result<T*> reallocate(T* ptr, size_type old_n, size_type new_n);
+
+    static MYSTL_CONSTEXPR20 void construct(T* ptr);
+    static MYSTL_CONSTEXPR20 void construct(T* ptr, const_reference value);
+    static MYSTL_CONSTEXPR20 void construct(T* ptr, T&& value);
     template <typename... Args>
-    static void construct(T* ptr, Args&&... args);
+    static MYSTL_CONSTEXPR20 void construct(T* ptr, Args&&... args);
+
+    static MYSTL_CONSTEXPR20 void destroy(T* ptr);
+    static MYSTL_CONSTEXPR20 void destroy(T* first, T* last);
 
-    static void destroy(T* ptr);
-    static void destroy(T* first, T* last);
+private:
+    // 内存池只保证 EPoolAlign 的对齐，对齐要求更高的类型绕过内存池
+#ifdef MYSTL_NO_POOL
+    static constexpr bool use_pool = false;
+#else
+    static constexpr bool use_pool = alignof(T) <= static_cast<size_t>(EPoolAlign);
+#endif
+
+    using stats_hook = alloc_stats_hook<T>;
+
+    static void* M_allocate(size_type bytes);
+    static void M_deallocate(void* ptr, size_type bytes);
 };
 
 template <typename T>
-T* allocator<T>::allocate() {
-    return static_cast<T*>(::operator new(sizeof(T)));
+void* allocator<T>::M_allocate(size_type bytes) {
+    if (use_pool)
+        return pool_alloc::allocate(bytes);
+#ifdef __cpp_aligned_new
+    return ::operator new(bytes, std::align_val_t(alignof(T)));
+#else
+    return ::operator new(bytes);
+#endif
 }
 
 template <typename T>
-T* allocator<T>::allocate(size_type n) {
+void allocator<T>::M_deallocate(void* ptr, size_type bytes) {
+    if (use_pool) {
+        pool_alloc::deallocate(ptr, bytes);
+        return;
+    }
+#ifdef __cpp_aligned_new
+    ::operator delete(ptr, std::align_val_t(alignof(T)));
+#else
+    ::operator delete(ptr);
+#endif
+}
+
+template <typename T>
+MYSTL_CONSTEXPR20 T* allocator<T>::allocate() {
+#ifdef MYSTL_HAS_CONSTEXPR20
+    if (std::is_constant_evaluated())
+        return std::allocator<T>().allocate(1);
+#endif
+    T* ptr = static_cast<T*>(M_allocate(sizeof(T)));
+    stats_hook::on_allocate(sizeof(T));
+    return ptr;
+}
+
+template <typename T>
+MYSTL_CONSTEXPR20 T* allocator<T>::allocate(size_type n) {
     if (n == 0)
         return nullptr;
-    return static_cast<T*>(::operator new(n * sizeof(T)));
+#ifdef MYSTL_HAS_CONSTEXPR20
+    if (std::is_constant_evaluated())
+        return std::allocator<T>().allocate(n);
+#endif
+    T* ptr = static_cast<T*>(M_allocate(n * sizeof(T)));
+    stats_hook::on_allocate(n * sizeof(T));
+    return ptr;
+}
+
+template <typename T>
+MYSTL_CONSTEXPR20 allocation_result<T*> allocator<T>::allocate_at_least(size_type n) {
+    if (n == 0)
+        return {nullptr, 0};
+#ifdef MYSTL_HAS_CONSTEXPR20
+    if (std::is_constant_evaluated())
+        return {std::allocator<T>().allocate(n), n};
+#endif
+    T* ptr = static_cast<T*>(M_allocate(n * sizeof(T)));
+    const size_type count =
+        use_pool ? pool_alloc::usable_size(ptr, n * sizeof(T)) / sizeof(T) : n;
+    // 容器会以 count 释放，统计也按 count 记录
+    stats_hook::on_allocate(count * sizeof(T));
+    return {ptr, count};
 }
 
 template <typename T>
-void allocator<T>::deallocate(T* ptr) {
+MYSTL_CONSTEXPR20 allocation_result<T*> allocator<T>::allocate_zeroed(size_type n) {
+    if (n == 0)
+        return {nullptr, 0};
+#ifdef MYSTL_HAS_CONSTEXPR20
+    if (std::is_constant_evaluated()) {
+        T* ptr = std::allocator<T>().allocate(n);
+        for (size_type i = 0; i != n; ++i) {
+            std::construct_at(ptr + i);
+        }
+        return {ptr, n};
+    }
+#endif
+    const size_type bytes = n * sizeof(T);
+    if (!use_pool) {
+        T* ptr = static_cast<T*>(M_allocate(bytes));
+        std::memset(static_cast<void*>(ptr), 0, bytes);
+        stats_hook::on_allocate(bytes);
+        return {ptr, n};
+    }
+    T* ptr = static_cast<T*>(pool_alloc::allocate_zeroed(bytes));
+    const size_type count = pool_alloc::usable_size(ptr, bytes) / sizeof(T);
+    stats_hook::on_allocate(count * sizeof(T));
+    return {ptr, count};
+}
+
+template <typename T>
+MYSTL_CONSTEXPR20 void allocator<T>::deallocate(T* ptr) {
     if (ptr == nullptr)
         return;
-    ::operator delete(ptr);
+#ifdef MYSTL_HAS_CONSTEXPR20
+    if (std::is_constant_evaluated()) {
+        std::allocator<T>().deallocate(ptr, 1);
+        return;
+    }
+#endif
+    stats_hook::on_deallocate(sizeof(T));
+    M_deallocate(ptr, sizeof(T));
 }
 
 template <typename T>
-void allocator<T>::deallocate(T* ptr, size_type n) {
+MYSTL_CONSTEXPR20 void allocator<T>::deallocate(T* ptr, size_type n) {
     if (ptr == nullptr)
         return;
-    ::operator delete(ptr);
+#ifdef MYSTL_HAS_CONSTEXPR20
+    if (std::is_constant_evaluated()) {
+        std::allocator<T>().deallocate(ptr, n);
+        return;
+    }
+#endif
+    stats_hook::on_deallocate(n * sizeof(T));
+    M_deallocate(ptr, n * sizeof(T));
+}
+
+template <typename T>
+allocation_result<T*> allocator<T>::reallocate(T* ptr, size_type old_n, size_type new_n) {
+    if (ptr == nullptr)
+        return allocate_at_least(new_n);
+    if (!use_pool) {
+        T* result = static_cast<T*>(M_allocate(new_n * sizeof(T)));
+        std::memcpy(static_cast<void*>(result), static_cast<const void*>(ptr),
+            (old_n < new_n ? old_n : new_n) * sizeof(T));
+        M_deallocate(ptr, old_n * sizeof(T));
+        stats_hook::on_reallocate(old_n * sizeof(T), new_n * sizeof(T));
+        return {result, new_n};
+    }
+    void* result = pool_alloc::reallocate(ptr, old_n * sizeof(T), new_n * sizeof(T));
+    const size_type count = pool_alloc::usable_size(result, new_n * sizeof(T)) / sizeof(T);
+    stats_hook::on_reallocate(old_n * sizeof(T), count * sizeof(T));
+    return {static_cast<T*>(result), count};
 }
 
 template <typename T>
-void allocator<T>::construct(T* ptr) {
+MYSTL_CONSTEXPR20 void allocator<T>::construct(T* ptr) {
     mystl::construct(ptr);
 }
 
 template <typename T>
-void allocator<T>::construct(T* ptr, const T& value) {
+MYSTL_CONSTEXPR20 void allocator<T>::construct(T* ptr, const T& value) {
     mystl::construct(ptr, value);
 }
 
 template <typename T>
-void allocator<T>::construct(T* ptr, T&& value) {
+MYSTL_CONSTEXPR20 void allocator<T>::construct(T* ptr, T&& value) {
     mystl::construct(ptr, mystl::move(value));
 }
 
 template <typename T>
 template <typename... Args>
-void allocator<T>::construct(T* ptr, Args&&... args) {
-    mystl::construct(ptr, mystl::forward<args>(args)...);
+MYSTL_CONSTEXPR20 void allocator<T>::construct(T* ptr, Args&&... args) {
+    mystl::construct(ptr, mystl::forward<Args>(args)...);
 }
 
 template <typename T>
-void allocator<T>::destroy(T* ptr) {
+MYSTL_CONSTEXPR20 void allocator<T>::destroy(T* ptr) {
     mystl::destroy(ptr);
 }
 
 template <typename T>
-void allocator<T>::destroy(T* first, T* last) {
+MYSTL_CONSTEXPR20 void allocator<T>::destroy(T* first, T* last) {
     mystl::destroy(first, last);
 }
 
+template <typename T, typename U>
+constexpr bool operator==(const allocator<T>&, const allocator<U>&) noexcept {
+    return true;
+}
+
+template <typename T, typename U>
+constexpr bool operator!=(const allocator<T>&, const allocator<U>&) noexcept {
+    return false;
+}
+
+/*****************************************************************************************/
+// allocator_traits
+// 萃取分配器的特性，容器通过它使用分配器，分配器没有提供的成员使用默认的实现
+/*****************************************************************************************/
+
+// 检测分配器的成员类型，不存在时使用 Default
+#define MYSTL_ALLOC_MEMBER_TYPE(name, member)                                 \
+    template <typename Alloc, typename Default, typename = void>              \
+    struct name {                                                             \
+        using type = Default;                                                 \
+    };                                                                        \
+    template <typename Alloc, typename Default>                               \
+    struct name<Alloc, Default, m_void_t<typename Alloc::member>> {           \
+        using type = typename Alloc::member;                                  \
+    }
+
+MYSTL_ALLOC_MEMBER_TYPE(alloc_pocca, propagate_on_container_copy_assignment);
+MYSTL_ALLOC_MEMBER_TYPE(alloc_pocma, propagate_on_container_move_assignment);
+MYSTL_ALLOC_MEMBER_TYPE(alloc_pocs, propagate_on_container_swap);
+MYSTL_ALLOC_MEMBER_TYPE(alloc_always_equal, is_always_equal);
+
+#undef MYSTL_ALLOC_MEMBER_TYPE
+
+// 检测分配器是否提供 reallocate(ptr, old_n, new_n)
+template <typename Alloc, typename = void>
+struct alloc_has_reallocate : public m_false_type {};
+
+template <typename Alloc>
+struct alloc_has_reallocate<Alloc,
+    m_void_t<decltype(std::declval<Alloc&>().reallocate(
+        std::declval<typename Alloc::value_type*>(), size_t(), size_t()))>>
+    : public m_true_type {};
+
+// 检测分配器是否提供 allocate_zeroed(n)
+template <typename Alloc, typename = void>
+struct alloc_has_allocate_zeroed : public m_false_type {};
+
+template <typename Alloc>
+struct alloc_has_allocate_zeroed<Alloc,
+    m_void_t<decltype(std::declval<Alloc&>().allocate_zeroed(size_t()))>>
+    : public m_true_type {};
+
+// rebind : 优先使用 Alloc::rebind<U>::other，否则把 Alloc<T, Args...> 换成 Alloc<U, Args...>
+template <typename Alloc, typename U>
+struct alloc_rebind_helper {};
+
+template <template <typename, typename...> class Alloc, typename T, typename... Args,
+    typename U>
+struct alloc_rebind_helper<Alloc<T, Args...>, U> {
+    using type = Alloc<U, Args...>;
+};
+
+template <typename Alloc, typename U, typename = void>
+struct alloc_rebind : public alloc_rebind_helper<Alloc, U> {};
+
+template <typename Alloc, typename U>
+struct alloc_rebind<Alloc, U, m_void_t<typename Alloc::template rebind<U>::other>> {
+    using type = typename Alloc::template rebind<U>::other;
+};
+
+template <typename Alloc>
+struct allocator_traits {
+    // clang-format off
+    using allocator_type    = Alloc;
+    using value_type        = typename Alloc::value_type;
+    using pointer           = value_type*;
+    using const_pointer     = const value_type*;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+
+    using propagate_on_container_copy_assignment =
+        typename alloc_pocca<Alloc, std::false_type>::type;
+    using propagate_on_container_move_assignment =
+        typename alloc_pocma<Alloc, std::false_type>::type;
+    using propagate_on_container_swap =
+        typename alloc_pocs<Alloc, std::false_type>::type;
+    using is_always_equal =
+        typename alloc_always_equal<Alloc, typename std::is_empty<Alloc>::type>::type;
+    // clang-format on
+
+    template <typename U>
+    using rebind_alloc = typename alloc_rebind<Alloc, U>::type;
+
+    using has_reallocate = alloc_has_reallocate<Alloc>;
+    using has_allocate_zeroed = alloc_has_allocate_zeroed<Alloc>;
+
+    static MYSTL_CONSTEXPR20 pointer allocate(Alloc& a, size_type n) {
+        return a.allocate(n);
+    }
+
+    // 分配器没有提供 allocate_at_least 时，恰好申请 n 个元素
+    static MYSTL_CONSTEXPR20 allocation_result<pointer> allocate_at_least(
+        Alloc& a, size_type n) {
+        return allocate_at_least_dispatch(0, a, n);
+    }
+
+    // 只有 has_allocate_zeroed 为真时才能调用
+    static MYSTL_CONSTEXPR20 allocation_result<pointer> allocate_zeroed(
+        Alloc& a, size_type n) {
+        auto result = a.allocate_zeroed(n);
+        return {result.ptr, result.count};
+    }
+
+    static MYSTL_CONSTEXPR20 void deallocate(Alloc& a, pointer ptr, size_type n) {
+        a.deallocate(ptr, n);
+    }
+
+    // 只有 has_reallocate 为真时才能调用
+    static allocation_result<pointer> reallocate(
+        Alloc& a, pointer ptr, size_type old_n, size_type new_n) {
+        auto result = a.reallocate(ptr, old_n, new_n);
+        return {result.ptr, result.count};
+    }
+
+    template <typename T, typename... Args>
+    static MYSTL_CONSTEXPR20 void construct(Alloc& a, T* ptr, Args&&... args) {
+        construct_dispatch(0, a, ptr, mystl::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    static MYSTL_CONSTEXPR20 void destroy(Alloc& a, T* ptr) {
+        destroy_dispatch(0, a, ptr);
+    }
+
+    static MYSTL_CONSTEXPR20 size_type max_size(const Alloc& a) noexcept {
+        return max_size_dispatch(0, a);
+    }
+
+    static MYSTL_CONSTEXPR20 Alloc select_on_container_copy_construction(const Alloc& a) {
+        return select_dispatch(0, a);
+    }
+
+private:
+    // 以 int / long 作为参数区分优先级，分配器提供了对应成员时优先匹配 int 版本
+    template <typename A>
+    static MYSTL_CONSTEXPR20 auto allocate_at_least_dispatch(int, A& a, size_type n)
+        -> decltype(a.allocate_at_least(n), allocation_result<pointer>()) {
+        auto result = a.allocate_at_least(n);
+        return {result.ptr, result.count};
+    }
+
+    template <typename A>
+    static MYSTL_CONSTEXPR20 allocation_result<pointer> allocate_at_least_dispatch(
+        long, A& a, size_type n) {
+        return {a.allocate(n), n};
+    }
+
+    template <typename A, typename T, typename... Args>
+    static MYSTL_CONSTEXPR20 auto construct_dispatch(int, A& a, T* ptr, Args&&... args)
+        -> decltype(a.construct(ptr, mystl::forward<Args>(args)...), void()) {
+        a.construct(ptr, mystl::forward<Args>(args)...);
+    }
+
+    template <typename A, typename T, typename... Args>
+    static MYSTL_CONSTEXPR20 void construct_dispatch(long, A&, T* ptr, Args&&... args) {
+        mystl::construct(ptr, mystl::forward<Args>(args)...);
+    }
+
+    template <typename A, typename T>
+    static MYSTL_CONSTEXPR20 auto destroy_dispatch(int, A& a, T* ptr)
+        -> decltype(a.destroy(ptr), void()) {
+        a.destroy(ptr);
+    }
+
+    template <typename A, typename T>
+    static MYSTL_CONSTEXPR20 void destroy_dispatch(long, A&, T* ptr) {
+        mystl::destroy(ptr);
+    }
+
+    template <typename A>
+    static MYSTL_CONSTEXPR20 auto max_size_dispatch(int, const A& a)
+        -> decltype(a.max_size(), size_type()) {
+        return a.max_size();
+    }
+
+    template <typename A>
+    static MYSTL_CONSTEXPR20 size_type max_size_dispatch(long, const A&) {
+        return static_cast<size_type>(-1) / sizeof(value_type);
+    }
+
+    template <typename A>
+    static MYSTL_CONSTEXPR20 auto select_dispatch(int, const A& a)
+        -> decltype(a.select_on_container_copy_construction()) {
+        return a.select_on_container_copy_construction();
+    }
+
+    template <typename A>
+    static MYSTL_CONSTEXPR20 Alloc select_dispatch(long, const A& a) {
+        return a;
+    }
+};
+
 } // namespace mystl
@@ -0,0 +1,188 @@
+#pragma once
+
+// 基准测试的公共部分：计时、防止被优化掉、结果输出以及测试注册
+//
+// 编译与运行（在仓库根目录）：
+//   g++ -std=c++11 -O2 -DNDEBUG -pthread -I. bench/*.cpp -o bench_run
+//   ./bench_run > bench_output.txt       运行全部测试
+//   ./bench_run vector algobase          只运行名字中含有任一参数的测试组
+//
+// 每个结果输出为一行 CSV：suite,case,type,size,impl,ns_per_op,iterations
+// 第一行为表头，impl 为 mystl 或 std，方便对比同一行两种实现的结果
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+using clock_type = std::chrono::steady_clock;
+
+enum { EMinNanoseconds = 20000000 }; // 每次测量至少运行的时间
+enum { ERepeats = 5 };               // 重复测量的次数，取最好的一次
+
+// 阻止编译器把结果当作无用代码删除
+template <class T>
+inline void do_not_optimize(const T& value) {
+#if defined(__GNUC__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+inline void clobber_memory() {
+#if defined(__GNUC__)
+    asm volatile("" : : : "memory");
+#endif
+}
+
+struct result {
+    double ns_per_op;
+    size_t iterations;
+};
+
+// fn() 执行一轮，每轮包含 ops 次操作，返回每次操作的纳秒数
+// setup() 在每轮之前执行，不计入时间
+template <class Setup, class Fn>
+result measure(size_t ops, Setup setup, Fn fn) {
+    result best = {0.0, 0};
+    for (int r = 0; r < ERepeats; ++r) {
+        size_t rounds = 0;
+        clock_type::duration total(0);
+        while (total < std::chrono::nanoseconds(EMinNanoseconds) || rounds == 0) {
+            setup();
+            const auto start = clock_type::now();
+            fn();
+            clobber_memory();
+            total += clock_type::now() - start;
+            ++rounds;
+        }
+        const double ns =
+            static_cast<double>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(total).count()) /
+            static_cast<double>(rounds * (ops == 0 ? 1 : ops));
+        if (best.iterations == 0 || ns < best.ns_per_op) {
+            best.ns_per_op = ns;
+            best.iterations = rounds * ops;
+        }
+    }
+    return best;
+}
+
+template <class Fn>
+result measure(size_t ops, Fn fn) {
+    return measure(ops, [] {}, fn);
+}
+
+inline void report(const char* suite, const char* name, const char* type, size_t size,
+    const char* impl, const result& r) {
+    std::printf("%s,%s,%s,%zu,%s,%.3f,%zu\n", suite, name, type, size, impl, r.ns_per_op,
+        r.iterations);
+    std::fflush(stdout);
+}
+
+// 测试组注册，每个源文件用一个静态的 registrar 把自己的测试组加入列表
+struct suite {
+    const char* name;
+    void (*run)();
+};
+
+inline std::vector<suite>& registry() {
+    static std::vector<suite> suites;
+    return suites;
+}
+
+struct registrar {
+    registrar(const char* name, void (*run)()) {
+        registry().push_back(suite{name, run});
+    }
+};
+
+// 测试用的元素类型
+struct pod64 {
+    long v[8];
+};
+
+template <class T>
+struct type_name;
+
+template <>
+struct type_name<int> {
+    static const char* get() {
+        return "int";
+    }
+};
+
+template <>
+struct type_name<char> {
+    static const char* get() {
+        return "char";
+    }
+};
+
+template <>
+struct type_name<unsigned char> {
+    static const char* get() {
+        return "uchar";
+    }
+};
+
+template <>
+struct type_name<long> {
+    static const char* get() {
+        return "long";
+    }
+};
+
+template <>
+struct type_name<double> {
+    static const char* get() {
+        return "double";
+    }
+};
+
+template <>
+struct type_name<std::string> {
+    static const char* get() {
+        return "string";
+    }
+};
+
+template <>
+struct type_name<pod64> {
+    static const char* get() {
+        return "pod64";
+    }
+};
+
+// 由下标生成测试值
+template <class T>
+struct make_value {
+    static T get(size_t i) {
+        return static_cast<T>(i * 2654435761u);
+    }
+};
+
+template <>
+struct make_value<std::string> {
+    static std::string get(size_t i) {
+        return std::string("value-") + std::to_string(i);
+    }
+};
+
+template <>
+struct make_value<pod64> {
+    static pod64 get(size_t i) {
+        pod64 p;
+        for (long& x : p.v) {
+            x = static_cast<long>(i);
+        }
+        return p;
+    }
+};
+
+} // namespace bench
@@ -0,0 +1,127 @@
+// algobase.h 中 copy / fill / equal / mismatch / lexicographical_compare 与 std:: 版本的对比
+
+#include <algorithm>
+#include <vector>
+
+#include "algobase.h"
+#include "bench.h"
+
+namespace {
+
+struct mystl_impl {
+    static const char* name() {
+        return "mystl";
+    }
+
+    template <class T>
+    static T* copy(const T* first, const T* last, T* result) {
+        return mystl::copy(first, last, result);
+    }
+
+    template <class T>
+    static void fill(T* first, T* last, const T& value) {
+        mystl::fill(first, last, value);
+    }
+
+    template <class T>
+    static bool equal(const T* first1, const T* last1, const T* first2) {
+        return mystl::equal(first1, last1, first2);
+    }
+
+    template <class T>
+    static const T* mismatch(const T* first1, const T* last1, const T* first2) {
+        return mystl::mismatch(first1, last1, first2).first;
+    }
+
+    template <class T>
+    static bool less(const T* first1, const T* last1, const T* first2, const T* last2) {
+        return mystl::lexicographical_compare(first1, last1, first2, last2);
+    }
+};
+
+struct std_impl {
+    static const char* name() {
+        return "std";
+    }
+
+    template <class T>
+    static T* copy(const T* first, const T* last, T* result) {
+        return std::copy(first, last, result);
+    }
+
+    template <class T>
+    static void fill(T* first, T* last, const T& value) {
+        std::fill(first, last, value);
+    }
+
+    template <class T>
+    static bool equal(const T* first1, const T* last1, const T* first2) {
+        return std::equal(first1, last1, first2);
+    }
+
+    template <class T>
+    static const T* mismatch(const T* first1, const T* last1, const T* first2) {
+        return std::mismatch(first1, last1, first2).first;
+    }
+
+    template <class T>
+    static bool less(const T* first1, const T* last1, const T* first2, const T* last2) {
+        return std::lexicographical_compare(first1, last1, first2, last2);
+    }
+};
+
+template <class Impl, class T>
+void run_case(size_t n) {
+    const char* type = bench::type_name<T>::get();
+    std::vector<T> a(n), b(n);
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = bench::make_value<T>::get(i);
+    }
+    const T* first = a.data();
+    const T* last = a.data() + n;
+
+    auto r = bench::measure(n, [&] { bench::do_not_optimize(Impl::copy(first, last, b.data())); });
+    bench::report("algobase", "copy", type, n, Impl::name(), r);
+
+    const T value = bench::make_value<T>::get(7);
+    r = bench::measure(n, [&] { Impl::fill(b.data(), b.data() + n, value); });
+    bench::report("algobase", "fill", type, n, Impl::name(), r);
+
+    // 两个序列完全相同，比较必须走完全程
+    std::copy(first, last, b.data());
+    r = bench::measure(n, [&] { bench::do_not_optimize(Impl::equal(first, last, b.data())); });
+    bench::report("algobase", "equal", type, n, Impl::name(), r);
+
+    // 只有最后一个元素不同
+    if (n != 0)
+        b[n - 1] = bench::make_value<T>::get(n + 1);
+    r = bench::measure(
+        n, [&] { bench::do_not_optimize(Impl::mismatch(first, last, b.data())); });
+    bench::report("algobase", "mismatch", type, n, Impl::name(), r);
+
+    r = bench::measure(n, [&] {
+        bench::do_not_optimize(Impl::less(first, last, b.data(), b.data() + n));
+    });
+    bench::report("algobase", "lexicographical_compare", type, n, Impl::name(), r);
+}
+
+template <class T>
+void run_type() {
+    const size_t bytes[] = {64, 4096, 262144, 16777216};
+    for (size_t size : bytes) {
+        const size_t n = size / sizeof(T);
+        run_case<mystl_impl, T>(n);
+        run_case<std_impl, T>(n);
+    }
+}
+
+void run() {
+    run_type<unsigned char>();
+    run_type<int>();
+    run_type<long>();
+    run_type<double>();
+}
+
+bench::registrar reg("algobase", &run);
+
+} // namespace
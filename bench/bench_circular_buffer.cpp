@@ -0,0 +1,90 @@
+// mystl::circular_buffer 与 std::deque 的对比：保留最近 window 个样本的滑动窗口、把窗口复制出来
+// 另外测量原先用 mystl::vector 加 erase(begin()) 模拟滑动窗口的做法，作为参照
+
+#include <algorithm>
+#include <deque>
+
+#include "bench.h"
+#include "circular_buffer.h"
+#include "vector.h"
+
+namespace {
+
+const size_t window = 1000;
+
+// 每来一个样本，窗口满时丢弃最旧的一个
+template <class T>
+void window_case(size_t n) {
+    const T value = bench::make_value<T>::get(n);
+    auto r = bench::measure(n, [&] {
+        mystl::circular_buffer<T> cb(window);
+        for (size_t i = 0; i < n; ++i) {
+            cb.push_back(value);
+        }
+        bench::do_not_optimize(cb.front());
+    });
+    bench::report("circular_buffer", "window", bench::type_name<T>::get(), n, "mystl", r);
+    r = bench::measure(n, [&] {
+        std::deque<T> q;
+        for (size_t i = 0; i < n; ++i) {
+            if (q.size() == window)
+                q.pop_front();
+            q.push_back(value);
+        }
+        bench::do_not_optimize(q.front());
+    });
+    bench::report("circular_buffer", "window", bench::type_name<T>::get(), n, "std", r);
+    r = bench::measure(n, [&] {
+        mystl::vector<T> v;
+        for (size_t i = 0; i < n; ++i) {
+            if (v.size() == window)
+                v.erase(v.begin());
+            v.push_back(value);
+        }
+        bench::do_not_optimize(v.front());
+    });
+    bench::report("circular_buffer", "vector_erase", bench::type_name<T>::get(), n, "mystl", r);
+}
+
+// 窗口已经回绕，按从旧到新的顺序复制到连续的空间
+template <class T>
+void copy_out_case(size_t n) {
+    mystl::circular_buffer<T> cb(n);
+    std::deque<T> q;
+    for (size_t i = 0; i < n + n / 2; ++i) {
+        cb.push_back(bench::make_value<T>::get(i));
+        if (q.size() == n)
+            q.pop_front();
+        q.push_back(bench::make_value<T>::get(i));
+    }
+    mystl::vector<T> out(n);
+    auto r = bench::measure(n, [&] {
+        cb.copy_to(out.begin());
+        bench::do_not_optimize(out.back());
+    });
+    bench::report("circular_buffer", "copy_out", bench::type_name<T>::get(), n, "mystl", r);
+    r = bench::measure(n, [&] {
+        std::copy(q.begin(), q.end(), out.begin());
+        bench::do_not_optimize(out.back());
+    });
+    bench::report("circular_buffer", "copy_out", bench::type_name<T>::get(), n, "std", r);
+}
+
+template <class T>
+void run_type() {
+    const size_t sizes[] = {1000, 100000, 1000000};
+    for (size_t n : sizes) {
+        window_case<T>(n);
+        copy_out_case<T>(n);
+    }
+}
+
+void run() {
+    run_type<int>();
+    run_type<bench::pod64>();
+    run_type<std::string>();
+}
+
+bench::registrar reg("circular_buffer", &run);
+
+} // namespace
@@ -0,0 +1,109 @@
+// mystl::concurrent_vector 与 std::mutex 保护的 mystl::vector 的对比：多个线程同时追加
+// 这一组的 size 列为线程数，每个线程追加 per_thread 个元素，结果为平均每个元素的纳秒数
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "concurrent_vector.h"
+#include "vector.h"
+
+namespace {
+
+const size_t per_thread = 100000;
+
+// 原来的做法：追加时加锁
+template <class T>
+struct locked_vector {
+    std::mutex mutex;
+    mystl::vector<T> vec;
+
+    void push_back(const T& value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        vec.push_back(value);
+    }
+
+    void grow_by(const T* first, const T* last) {
+        std::lock_guard<std::mutex> lock(mutex);
+        vec.insert(vec.end(), first, last);
+    }
+};
+
+template <class Vec, class Fn>
+void run_threads(size_t threads, Fn fn) {
+    Vec v;
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&] { fn(v); });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+}
+
+template <class T>
+void push_back_case(size_t threads) {
+    const T value = bench::make_value<T>::get(threads);
+    auto r = bench::measure(threads * per_thread, [&] {
+        run_threads<mystl::concurrent_vector<T>>(threads, [&](mystl::concurrent_vector<T>& v) {
+            for (size_t i = 0; i < per_thread; ++i) {
+                v.push_back(value);
+            }
+        });
+    });
+    bench::report(
+        "concurrent_vector", "push_back", bench::type_name<T>::get(), threads, "mystl", r);
+    r = bench::measure(threads * per_thread, [&] {
+        run_threads<locked_vector<T>>(threads, [&](locked_vector<T>& v) {
+            for (size_t i = 0; i < per_thread; ++i) {
+                v.push_back(value);
+            }
+        });
+    });
+    bench::report(
+        "concurrent_vector", "push_back", bench::type_name<T>::get(), threads, "std", r);
+}
+
+// 每次追加 64 个元素
+template <class T>
+void grow_by_case(size_t threads) {
+    const std::vector<T> batch(64, bench::make_value<T>::get(threads));
+    const T* first = batch.data();
+    const T* last = first + batch.size();
+    auto r = bench::measure(threads * per_thread, [&] {
+        run_threads<mystl::concurrent_vector<T>>(threads, [&](mystl::concurrent_vector<T>& v) {
+            for (size_t i = 0; i < per_thread; i += batch.size()) {
+                v.grow_by(first, last);
+            }
+        });
+    });
+    bench::report(
+        "concurrent_vector", "grow_by", bench::type_name<T>::get(), threads, "mystl", r);
+    r = bench::measure(threads * per_thread, [&] {
+        run_threads<locked_vector<T>>(threads, [&](locked_vector<T>& v) {
+            for (size_t i = 0; i < per_thread; i += batch.size()) {
+                v.grow_by(first, last);
+            }
+        });
+    });
+    bench::report("concurrent_vector", "grow_by", bench::type_name<T>::get(), threads, "std", r);
+}
+
+template <class T>
+void run_type() {
+    const size_t thread_counts[] = {1, 4, 8};
+    for (size_t threads : thread_counts) {
+        push_back_case<T>(threads);
+        grow_by_case<T>(threads);
+    }
+}
+
+void run() {
+    run_type<int>();
+    run_type<std::string>();
+}
+
+bench::registrar reg("concurrent_vector", &run);
+
+} // namespace
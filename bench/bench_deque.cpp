@@ -0,0 +1,83 @@
+// mystl::deque 与 std::deque 的对比：队列式的 push_back/pop_front、push_front、随机访问
+
+#include <deque>
+
+#include "bench.h"
+#include "deque.h"
+
+namespace {
+
+// 保持 window 个元素的队列，每次 push_back 一个再 pop_front 一个，反复申请释放块
+template <class Deq>
+void fifo_case(const char* impl, size_t n) {
+    using T = typename Deq::value_type;
+    const size_t window = 1000;
+    const T value = bench::make_value<T>::get(n);
+    Deq q;
+    for (size_t i = 0; i < window; ++i) {
+        q.push_back(value);
+    }
+    auto r = bench::measure(n, [&] {
+        for (size_t i = 0; i < n; ++i) {
+            q.push_back(value);
+            q.pop_front();
+        }
+        bench::do_not_optimize(q.front());
+    });
+    bench::report("deque", "fifo", bench::type_name<T>::get(), n, impl, r);
+}
+
+template <class Deq>
+void push_front_case(const char* impl, size_t n) {
+    using T = typename Deq::value_type;
+    const T value = bench::make_value<T>::get(n);
+    auto r = bench::measure(n, [&] {
+        Deq q;
+        for (size_t i = 0; i < n; ++i) {
+            q.push_front(value);
+        }
+        bench::do_not_optimize(q.front());
+    });
+    bench::report("deque", "push_front", bench::type_name<T>::get(), n, impl, r);
+}
+
+// 按跨块的步长访问，测量下标运算的开销
+template <class Deq>
+void random_access_case(const char* impl, size_t n) {
+    using T = typename Deq::value_type;
+    Deq q;
+    for (size_t i = 0; i < n; ++i) {
+        q.push_back(bench::make_value<T>::get(i));
+    }
+    auto r = bench::measure(n, [&] {
+        size_t idx = 0;
+        for (size_t i = 0; i < n; ++i) {
+            bench::do_not_optimize(q[idx]);
+            idx = (idx + 7919) % n;
+        }
+    });
+    bench::report("deque", "random_access", bench::type_name<T>::get(), n, impl, r);
+}
+
+template <class T>
+void run_type() {
+    const size_t sizes[] = {1000, 100000, 1000000};
+    for (size_t n : sizes) {
+        fifo_case<mystl::deque<T>>("mystl", n);
+        fifo_case<std::deque<T>>("std", n);
+        push_front_case<mystl::deque<T>>("mystl", n);
+        push_front_case<std::deque<T>>("std", n);
+        random_access_case<mystl::deque<T>>("mystl", n);
+        random_access_case<std::deque<T>>("std", n);
+    }
+}
+
+void run() {
+    run_type<int>();
+    run_type<bench::pod64>();
+    run_type<std::string>();
+}
+
+bench::registrar reg("deque", &run);
+
+} // namespace
@@ -0,0 +1,98 @@
+// mystl::flat_hash_map 与 std::unordered_map 的对比：插入、命中查找、未命中查找、删除后再插入
+
+#include <string>
+#include <unordered_map>
+
+#include "bench.h"
+#include "flat_hash_map.h"
+
+namespace {
+
+template <class Map>
+void insert_case(const char* impl, size_t n) {
+    using K = typename Map::key_type;
+    auto r = bench::measure(n, [&] {
+        Map m;
+        for (size_t i = 0; i < n; ++i) {
+            m.insert({bench::make_value<K>::get(i), static_cast<int>(i)});
+        }
+        bench::do_not_optimize(m.size());
+    });
+    bench::report("flat_hash", "insert", bench::type_name<K>::get(), n, impl, r);
+}
+
+// 按打乱的顺序查找已有的键
+template <class Map>
+void find_hit_case(const char* impl, size_t n) {
+    using K = typename Map::key_type;
+    Map m;
+    for (size_t i = 0; i < n; ++i) {
+        m.insert({bench::make_value<K>::get(i), static_cast<int>(i)});
+    }
+    auto r = bench::measure(n, [&] {
+        size_t idx = 0;
+        for (size_t i = 0; i < n; ++i) {
+            bench::do_not_optimize(m.find(bench::make_value<K>::get(idx)));
+            idx = (idx + 7919) % n;
+        }
+    });
+    bench::report("flat_hash", "find_hit", bench::type_name<K>::get(), n, impl, r);
+}
+
+template <class Map>
+void find_miss_case(const char* impl, size_t n) {
+    using K = typename Map::key_type;
+    Map m;
+    for (size_t i = 0; i < n; ++i) {
+        m.insert({bench::make_value<K>::get(i), static_cast<int>(i)});
+    }
+    auto r = bench::measure(n, [&] {
+        for (size_t i = 0; i < n; ++i) {
+            bench::do_not_optimize(m.find(bench::make_value<K>::get(n + i)));
+        }
+    });
+    bench::report("flat_hash", "find_miss", bench::type_name<K>::get(), n, impl, r);
+}
+
+// 大小不变的会话表：删除最旧的键再插入一个新键
+template <class Map>
+void churn_case(const char* impl, size_t n) {
+    using K = typename Map::key_type;
+    Map m;
+    for (size_t i = 0; i < n; ++i) {
+        m.insert({bench::make_value<K>::get(i), static_cast<int>(i)});
+    }
+    size_t next = n;
+    auto r = bench::measure(n, [&] {
+        for (size_t i = 0; i < n; ++i, ++next) {
+            m.erase(bench::make_value<K>::get(next - n));
+            m.insert({bench::make_value<K>::get(next), static_cast<int>(i)});
+        }
+        bench::do_not_optimize(m.size());
+    });
+    bench::report("flat_hash", "churn", bench::type_name<K>::get(), n, impl, r);
+}
+
+template <class K>
+void run_type() {
+    const size_t sizes[] = {1000, 100000, 1000000};
+    for (size_t n : sizes) {
+        insert_case<mystl::flat_hash_map<K, int>>("mystl", n);
+        insert_case<std::unordered_map<K, int>>("std", n);
+        find_hit_case<mystl::flat_hash_map<K, int>>("mystl", n);
+        find_hit_case<std::unordered_map<K, int>>("std", n);
+        find_miss_case<mystl::flat_hash_map<K, int>>("mystl", n);
+        find_miss_case<std::unordered_map<K, int>>("std", n);
+        churn_case<mystl::flat_hash_map<K, int>>("mystl", n);
+        churn_case<std::unordered_map<K, int>>("std", n);
+    }
+}
+
+void run() {
+    run_type<long>();
+    run_type<std::string>();
+}
+
+bench::registrar reg("flat_hash", &run);
+
+} // namespace
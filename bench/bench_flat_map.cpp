@@ -0,0 +1,78 @@
+// mystl::flat_map 与 std::map 的对比：由无序输入一次构建、随机查找
+
+#include <map>
+#include <string>
+#include <utility>
+
+#include "bench.h"
+#include "flat_map.h"
+#include "vector.h"
+
+namespace {
+
+template <class K>
+mystl::vector<mystl::pair<K, int>> make_input(size_t n) {
+    mystl::vector<mystl::pair<K, int>> input;
+    input.reserve(n);
+    size_t idx = 0;
+    for (size_t i = 0; i < n; ++i) {
+        input.push_back(mystl::make_pair(bench::make_value<K>::get(idx), static_cast<int>(i)));
+        idx = (idx + 7919) % n;
+    }
+    return input;
+}
+
+template <class K>
+void build_case(size_t n) {
+    const auto input = make_input<K>(n);
+    auto r = bench::measure(n, [&] {
+        mystl::flat_map<K, int> m(input.begin(), input.end());
+        bench::do_not_optimize(m.size());
+    });
+    bench::report("flat_map", "build", bench::type_name<K>::get(), n, "mystl", r);
+    r = bench::measure(n, [&] {
+        std::map<K, int> m;
+        for (const auto& p : input) {
+            m.emplace(p.first, p.second);
+        }
+        bench::do_not_optimize(m.size());
+    });
+    bench::report("flat_map", "build", bench::type_name<K>::get(), n, "std", r);
+}
+
+template <class Map>
+void find_case(const char* impl, size_t n) {
+    using K = typename Map::key_type;
+    const auto input = make_input<K>(n);
+    Map m;
+    for (const auto& p : input) {
+        m.insert(typename Map::value_type(p.first, p.second));
+    }
+    auto r = bench::measure(n, [&] {
+        size_t idx = 0;
+        for (size_t i = 0; i < n; ++i) {
+            bench::do_not_optimize(m.find(bench::make_value<K>::get(idx)));
+            idx = (idx + 104729) % n;
+        }
+    });
+    bench::report("flat_map", "find", bench::type_name<K>::get(), n, impl, r);
+}
+
+template <class K>
+void run_type() {
+    const size_t sizes[] = {1000, 100000, 1000000};
+    for (size_t n : sizes) {
+        build_case<K>(n);
+        find_case<mystl::flat_map<K, int>>("mystl", n);
+        find_case<std::map<K, int>>("std", n);
+    }
+}
+
+void run() {
+    run_type<long>();
+    run_type<std::string>();
+}
+
+bench::registrar reg("flat_map", &run);
+
+} // namespace
@@ -0,0 +1,18 @@
+// 基准测试的入口，编译和运行方式见 bench.h
+
+#include <cstring>
+
+#include "bench.h"
+
+int main(int argc, char** argv) {
+    std::printf("suite,case,type,size,impl,ns_per_op,iterations\n");
+    for (const auto& s : bench::registry()) {
+        bool selected = argc < 2;
+        for (int i = 1; i < argc && !selected; ++i) {
+            selected = std::strstr(s.name, argv[i]) != nullptr;
+        }
+        if (selected)
+            s.run();
+    }
+    return 0;
+}
@@ -0,0 +1,105 @@
+// mystl::mpmc_queue 与 std::mutex 保护的 std::deque 的对比：不同线程数下的竞争
+// 这一组的 size 列为线程数：一半线程入队、一半线程出队，只有 1 个线程时交替入队和出队。
+// 结果为平均每次入队 (加一次出队) 的纳秒数
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "bench.h"
+#include "mpmc_queue.h"
+
+namespace {
+
+const size_t capacity = 1024;
+const size_t ops = 200000;
+
+// 原来的做法：一把全局锁保护的队列，满了或者空了在条件变量上等待
+template <class T>
+class locked_queue {
+public:
+    void push(const T& value) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this] { return q_.size() < capacity; });
+        q_.push_back(value);
+        lock.unlock();
+        not_empty_.notify_one();
+    }
+
+    void pop(T& value) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [this] { return !q_.empty(); });
+        value = q_.front();
+        q_.pop_front();
+        lock.unlock();
+        not_full_.notify_one();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+    std::deque<T> q_;
+};
+
+template <class Queue, class T>
+void contend(Queue& q, size_t threads) {
+    const T value = bench::make_value<T>::get(threads);
+    if (threads == 1) {
+        T out = value;
+        for (size_t i = 0; i < ops; ++i) {
+            q.push(value);
+            q.pop(out);
+        }
+        bench::do_not_optimize(out);
+        return;
+    }
+    const size_t pairs = threads / 2;
+    const size_t per_thread = ops / pairs;
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < pairs; ++t) {
+        workers.emplace_back([&] {
+            for (size_t i = 0; i < per_thread; ++i) {
+                q.push(value);
+            }
+        });
+        workers.emplace_back([&] {
+            T out = value;
+            for (size_t i = 0; i < per_thread; ++i) {
+                q.pop(out);
+            }
+            bench::do_not_optimize(out);
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+}
+
+template <class T>
+void run_type() {
+    const size_t thread_counts[] = {1, 8, 32, 64};
+    for (size_t threads : thread_counts) {
+        auto r = bench::measure(ops, [&] {
+            mystl::mpmc_queue<T> q(capacity);
+            contend<mystl::mpmc_queue<T>, T>(q, threads);
+        });
+        bench::report("mpmc_queue", "contention", bench::type_name<T>::get(), threads, "mystl", r);
+        r = bench::measure(ops, [&] {
+            locked_queue<T> q;
+            contend<locked_queue<T>, T>(q, threads);
+        });
+        bench::report("mpmc_queue", "contention", bench::type_name<T>::get(), threads, "std", r);
+    }
+}
+
+void run() {
+    run_type<int>();
+    run_type<std::string>();
+}
+
+bench::registrar reg("mpmc_queue", &run);
+
+} // namespace
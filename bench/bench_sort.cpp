@@ -0,0 +1,133 @@
+// mystl::sort / nth_element / partial_sort 与 std 版本的对比
+// 输入模式：sorted (升序)、reverse (降序)、sawtooth (长度为 1000 的升序段重复)、random (随机)
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <string>
+
+#include "algo.h"
+#include "bench.h"
+#include "vector.h"
+
+namespace {
+
+enum pattern { ESorted, EReverse, ESawtooth, ERandom };
+
+const char* const pattern_names[] = {"sorted", "reverse", "sawtooth", "random"};
+
+// 由整数键生成元素，保持键的大小顺序
+template <class T>
+struct key_value {
+    static T get(size_t key) {
+        return static_cast<T>(key);
+    }
+};
+
+template <>
+struct key_value<std::string> {
+    static std::string get(size_t key) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "key-%012zu", key);
+        return buf;
+    }
+};
+
+template <class T>
+mystl::vector<T> make_input(pattern p, size_t n) {
+    std::mt19937_64 rng(n);
+    mystl::vector<T> v;
+    v.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        size_t key = 0;
+        switch (p) {
+            case ESorted:
+                key = i;
+                break;
+            case EReverse:
+                key = n - i;
+                break;
+            case ESawtooth:
+                key = i % 1000;
+                break;
+            case ERandom:
+                key = static_cast<size_t>(rng() % n);
+                break;
+        }
+        v.push_back(key_value<T>::get(key));
+    }
+    return v;
+}
+
+// 每轮开始前把 work 恢复为原始输入，不计入时间
+template <class T>
+void sort_case(pattern p, size_t n) {
+    const mystl::vector<T> input = make_input<T>(p, n);
+    mystl::vector<T> work(input);
+    const char* type = bench::type_name<T>::get();
+    auto reset = [&] { std::copy(input.begin(), input.end(), work.begin()); };
+
+    auto r = bench::measure(n, reset, [&] {
+        mystl::sort(work.begin(), work.end());
+        bench::do_not_optimize(work.front());
+    });
+    bench::report("sort", pattern_names[p], type, n, "mystl", r);
+    r = bench::measure(n, reset, [&] {
+        std::sort(work.begin(), work.end());
+        bench::do_not_optimize(work.front());
+    });
+    bench::report("sort", pattern_names[p], type, n, "std", r);
+}
+
+// 随机输入上取中位数、取前 1% 排好序
+template <class T>
+void select_case(size_t n) {
+    const mystl::vector<T> input = make_input<T>(ERandom, n);
+    mystl::vector<T> work(input);
+    const char* type = bench::type_name<T>::get();
+    auto reset = [&] { std::copy(input.begin(), input.end(), work.begin()); };
+
+    auto r = bench::measure(n, reset, [&] {
+        mystl::nth_element(work.begin(), work.begin() + n / 2, work.end());
+        bench::do_not_optimize(work[n / 2]);
+    });
+    bench::report("sort", "nth_element", type, n, "mystl", r);
+    r = bench::measure(n, reset, [&] {
+        std::nth_element(work.begin(), work.begin() + n / 2, work.end());
+        bench::do_not_optimize(work[n / 2]);
+    });
+    bench::report("sort", "nth_element", type, n, "std", r);
+
+    r = bench::measure(n, reset, [&] {
+        mystl::partial_sort(work.begin(), work.begin() + n / 100, work.end());
+        bench::do_not_optimize(work.front());
+    });
+    bench::report("sort", "partial_sort", type, n, "mystl", r);
+    r = bench::measure(n, reset, [&] {
+        std::partial_sort(work.begin(), work.begin() + n / 100, work.end());
+        bench::do_not_optimize(work.front());
+    });
+    bench::report("sort", "partial_sort", type, n, "std", r);
+}
+
+template <class T>
+void run_type() {
+    const size_t sizes[] = {1000, 100000, 1000000};
+    const pattern patterns[] = {ESorted, EReverse, ESawtooth, ERandom};
+    for (size_t n : sizes) {
+        for (pattern p : patterns) {
+            sort_case<T>(p, n);
+        }
+        select_case<T>(n);
+    }
+}
+
+void run() {
+    run_type<int>();
+    run_type<double>();
+    run_type<std::string>();
+}
+
+bench::registrar reg("sort", &run);
+
+} // namespace
@@ -0,0 +1,140 @@
+// mystl::spsc_queue 与 std::mutex 保护的 std::deque 的对比：两个线程之间逐个或成批地传递元素
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "bench.h"
+#include "spsc_queue.h"
+
+namespace {
+
+const size_t capacity = 4096;
+const size_t batch = 64;
+
+// 原来的做法：一个互斥量保护的队列，满了或者空了就重试
+template <class T>
+class locked_queue {
+public:
+    bool try_push(const T& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (q_.size() == capacity)
+            return false;
+        q_.push_back(value);
+        return true;
+    }
+
+    size_t try_push_n(const T* first, size_t n) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (n > capacity - q_.size())
+            n = capacity - q_.size();
+        q_.insert(q_.end(), first, first + n);
+        return n;
+    }
+
+    bool try_pop(T& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (q_.empty())
+            return false;
+        value = q_.front();
+        q_.pop_front();
+        return true;
+    }
+
+    size_t try_pop_n(T* result, size_t n) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (n > q_.size())
+            n = q_.size();
+        std::copy(q_.begin(), q_.begin() + n, result);
+        q_.erase(q_.begin(), q_.begin() + n);
+        return n;
+    }
+
+private:
+    std::mutex mutex_;
+    std::deque<T> q_;
+};
+
+// 队列满或者空时让出 CPU，核数少于两个时另一方才有机会运行
+template <class Queue, class T>
+void handoff_one(Queue& q, size_t n) {
+    const T value = bench::make_value<T>::get(n);
+    std::thread producer([&] {
+        for (size_t i = 0; i < n;) {
+            if (q.try_push(value)) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    T out = value;
+    for (size_t i = 0; i < n;) {
+        if (q.try_pop(out)) {
+            ++i;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    bench::do_not_optimize(out);
+}
+
+template <class Queue, class T>
+void handoff_batch(Queue& q, size_t n) {
+    std::vector<T> in(batch, bench::make_value<T>::get(n));
+    std::thread producer([&] {
+        for (size_t i = 0; i < n;) {
+            const size_t m = n - i < batch ? n - i : batch;
+            const size_t pushed = q.try_push_n(in.data(), m);
+            if (pushed == 0)
+                std::this_thread::yield();
+            i += pushed;
+        }
+    });
+    std::vector<T> out(batch);
+    for (size_t i = 0; i < n;) {
+        const size_t popped = q.try_pop_n(out.data(), batch);
+        if (popped == 0)
+            std::this_thread::yield();
+        i += popped;
+    }
+    producer.join();
+    bench::do_not_optimize(out[0]);
+}
+
+template <class T>
+void run_type() {
+    const size_t n = 1000000;
+    auto r = bench::measure(n, [&] {
+        mystl::spsc_queue<T> q(capacity);
+        handoff_one<mystl::spsc_queue<T>, T>(q, n);
+    });
+    bench::report("spsc_queue", "handoff", bench::type_name<T>::get(), n, "mystl", r);
+    r = bench::measure(n, [&] {
+        locked_queue<T> q;
+        handoff_one<locked_queue<T>, T>(q, n);
+    });
+    bench::report("spsc_queue", "handoff", bench::type_name<T>::get(), n, "std", r);
+    r = bench::measure(n, [&] {
+        mystl::spsc_queue<T> q(capacity);
+        handoff_batch<mystl::spsc_queue<T>, T>(q, n);
+    });
+    bench::report("spsc_queue", "handoff_batch", bench::type_name<T>::get(), n, "mystl", r);
+    r = bench::measure(n, [&] {
+        locked_queue<T> q;
+        handoff_batch<locked_queue<T>, T>(q, n);
+    });
+    bench::report("spsc_queue", "handoff_batch", bench::type_name<T>::get(), n, "std", r);
+}
+
+void run() {
+    run_type<int>();
+    run_type<bench::pod64>();
+    run_type<std::string>();
+}
+
+bench::registrar reg("spsc_queue", &run);
+
+} // namespace
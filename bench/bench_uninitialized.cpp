@@ -0,0 +1,146 @@
+// uninitialized.h 中的 uninitialized_copy / uninitialized_fill_n / uninitialized_move
+// 与 std:: 版本的对比，目标空间每轮重新析构，析构的时间不计入
+
+#include <memory>
+#include <vector>
+
+#include "bench.h"
+#include "uninitialized.h"
+
+namespace {
+
+struct mystl_impl {
+    static const char* name() {
+        return "mystl";
+    }
+
+    template <class T>
+    static T* copy(T* first, T* last, T* result) {
+        return mystl::uninitialized_copy(first, last, result);
+    }
+
+    template <class T>
+    static T* fill_n(T* first, size_t n, const T& value) {
+        return mystl::uninitialized_fill_n(first, n, value);
+    }
+
+    template <class T>
+    static T* move(T* first, T* last, T* result) {
+        return mystl::uninitialized_move(first, last, result);
+    }
+};
+
+struct std_impl {
+    static const char* name() {
+        return "std";
+    }
+
+    template <class T>
+    static T* copy(T* first, T* last, T* result) {
+        return std::uninitialized_copy(first, last, result);
+    }
+
+    template <class T>
+    static T* fill_n(T* first, size_t n, const T& value) {
+        return std::uninitialized_fill_n(first, n, value);
+    }
+
+    template <class T>
+    static T* move(T* first, T* last, T* result) {
+        // std::uninitialized_move 是 C++17 才有的，这里用 move_iterator 得到相同的效果
+        return std::uninitialized_copy(
+            std::make_move_iterator(first), std::make_move_iterator(last), result);
+    }
+};
+
+// 存放构造结果的未初始化空间
+template <class T>
+class raw_buffer {
+public:
+    explicit raw_buffer(size_t n)
+        : data_(static_cast<T*>(::operator new(n * sizeof(T))))
+        , size_(n)
+        , built_(0) {}
+
+    ~raw_buffer() {
+        reset();
+        ::operator delete(data_);
+    }
+
+    T* data() const {
+        return data_;
+    }
+
+    void built(size_t n) {
+        built_ = n;
+    }
+
+    void reset() {
+        for (size_t i = 0; i < built_; ++i) {
+            data_[i].~T();
+        }
+        built_ = 0;
+    }
+
+private:
+    T* data_;
+    size_t size_;
+    size_t built_;
+};
+
+template <class Impl, class T>
+void run_case(size_t n) {
+    const char* type = bench::type_name<T>::get();
+    std::vector<T> src(n);
+    for (size_t i = 0; i < n; ++i) {
+        src[i] = bench::make_value<T>::get(i);
+    }
+    raw_buffer<T> dst(n);
+
+    auto r = bench::measure(n, [&] { dst.reset(); },
+        [&] {
+            Impl::copy(src.data(), src.data() + n, dst.data());
+            dst.built(n);
+        });
+    bench::report("uninitialized", "uninitialized_copy", type, n, Impl::name(), r);
+
+    const T value = bench::make_value<T>::get(n);
+    r = bench::measure(n, [&] { dst.reset(); },
+        [&] {
+            Impl::fill_n(dst.data(), n, value);
+            dst.built(n);
+        });
+    bench::report("uninitialized", "uninitialized_fill_n", type, n, Impl::name(), r);
+
+    // 每轮移动之前重新准备源序列，准备的时间不计入
+    std::vector<T> moved(n);
+    r = bench::measure(n,
+        [&] {
+            dst.reset();
+            moved.assign(src.begin(), src.end());
+        },
+        [&] {
+            Impl::move(moved.data(), moved.data() + n, dst.data());
+            dst.built(n);
+        });
+    bench::report("uninitialized", "uninitialized_move", type, n, Impl::name(), r);
+}
+
+template <class T>
+void run_type() {
+    const size_t sizes[] = {16, 1000, 100000, 1000000};
+    for (size_t n : sizes) {
+        run_case<mystl_impl, T>(n);
+        run_case<std_impl, T>(n);
+    }
+}
+
+void run() {
+    run_type<int>();
+    run_type<bench::pod64>();
+    run_type<std::string>();
+}
+
+bench::registrar reg("uninitialized", &run);
+
+} // namespace
@@ -0,0 +1,109 @@
+// mystl::vector 与 std::vector 的对比：push_back、reserve 后 push_back、中间插入、中间删除
+
+#include <vector>
+
+#include "bench.h"
+#include "vector.h"
+
+namespace {
+
+template <class Vec>
+void push_back_case(const char* impl, size_t n) {
+    using T = typename Vec::value_type;
+    std::vector<T> values;
+    for (size_t i = 0; i < n; ++i) {
+        values.push_back(bench::make_value<T>::get(i));
+    }
+    auto r = bench::measure(n, [&] {
+        Vec v;
+        for (size_t i = 0; i < n; ++i) {
+            v.push_back(values[i]);
+        }
+        bench::do_not_optimize(v.data());
+    });
+    bench::report("vector", "push_back", bench::type_name<T>::get(), n, impl, r);
+}
+
+template <class Vec>
+void reserve_push_back_case(const char* impl, size_t n) {
+    using T = typename Vec::value_type;
+    std::vector<T> values;
+    for (size_t i = 0; i < n; ++i) {
+        values.push_back(bench::make_value<T>::get(i));
+    }
+    auto r = bench::measure(n, [&] {
+        Vec v;
+        v.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            v.push_back(values[i]);
+        }
+        bench::do_not_optimize(v.data());
+    });
+    bench::report("vector", "reserve_push_back", bench::type_name<T>::get(), n, impl, r);
+}
+
+// 每次在中间插入一个元素，直到 n 个
+template <class Vec>
+void insert_middle_case(const char* impl, size_t n) {
+    using T = typename Vec::value_type;
+    const T value = bench::make_value<T>::get(n);
+    auto r = bench::measure(n, [&] {
+        Vec v;
+        for (size_t i = 0; i < n; ++i) {
+            v.insert(v.begin() + v.size() / 2, value);
+        }
+        bench::do_not_optimize(v.data());
+    });
+    bench::report("vector", "insert_middle", bench::type_name<T>::get(), n, impl, r);
+}
+
+// 从 n 个元素开始每次删除中间的元素，直到为空，建立容器的时间不计入
+template <class Vec>
+void erase_middle_case(const char* impl, size_t n) {
+    using T = typename Vec::value_type;
+    const T value = bench::make_value<T>::get(n);
+    Vec v;
+    auto r = bench::measure(n,
+        [&] {
+            v.clear();
+            for (size_t i = 0; i < n; ++i) {
+                v.push_back(value);
+            }
+        },
+        [&] {
+            while (!v.empty()) {
+                v.erase(v.begin() + v.size() / 2);
+            }
+            bench::do_not_optimize(v.data());
+        });
+    bench::report("vector", "erase_middle", bench::type_name<T>::get(), n, impl, r);
+}
+
+template <class T>
+void run_type() {
+    const size_t sizes[] = {1000, 100000, 1000000};
+    for (size_t n : sizes) {
+        push_back_case<mystl::vector<T>>("mystl", n);
+        push_back_case<std::vector<T>>("std", n);
+        reserve_push_back_case<mystl::vector<T>>("mystl", n);
+        reserve_push_back_case<std::vector<T>>("std", n);
+    }
+    // 中间插入和删除是平方复杂度，只测较小的规模
+    const size_t small_sizes[] = {100, 1000, 10000};
+    for (size_t n : small_sizes) {
+        insert_middle_case<mystl::vector<T>>("mystl", n);
+        insert_middle_case<std::vector<T>>("std", n);
+        erase_middle_case<mystl::vector<T>>("mystl", n);
+        erase_middle_case<std::vector<T>>("std", n);
+    }
+}
+
+void run() {
+    run_type<int>();
+    run_type<bench::pod64>();
+    run_type<std::string>();
+}
+
+bench::registrar reg("vector", &run);
+
+} // namespace
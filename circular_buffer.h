@@ -0,0 +1,856 @@
+#pragma once
+
+// 这个头文件包含一个模板类 circular_buffer
+// circular_buffer : 环形缓冲区，元素存放在一段大小为 2 的幂的连续空间中，下标通过与掩码按位与回绕，
+// 两端的插入和删除都是 O(1)，不会移动已有的元素。
+//
+// capacity() 为逻辑容量，可以是任意值；实际分配的空间向上取整为 2 的幂。
+// 容器满时的行为由 circular_full_policy 决定：覆盖最旧的元素、拒绝新元素，或者把容量翻倍。
+//
+// 元素在空间中最多分成两段连续的区间，array_one() / array_two() 按从旧到新的顺序返回这两段，
+// 可以直接交给 algobase.h 中的算法，可平凡复制的类型按 memmove 的速度处理。
+
+#include <initializer_list>
+
+#include "exceptdef.h"
+#include "iterator.h"
+#include "memory.h"
+#include "memory_resource.h"
+#include "util.h"
+
+namespace mystl {
+
+// 容器满时插入新元素的处理方式
+enum circular_full_policy {
+    EFullOverwrite, // 覆盖另一端最旧 (push_front 时为最新) 的元素
+    EFullReject,    // 不插入，push 返回 false
+    EFullGrow       // 逻辑容量翻倍
+};
+
+// 不小于 n 的 2 的幂，n 为 0 时返回 0
+inline size_t circular_buffer_round_up(size_t n) noexcept {
+    size_t cap = n == 0 ? 0 : 1;
+    while (cap < n) {
+        cap <<= 1;
+    }
+    return cap;
+}
+
+/*****************************************************************************************/
+// circular_buffer_iterator
+// pos 为没有回绕的位置 (起点 + 下标)，解引用时才与掩码按位与
+/*****************************************************************************************/
+template <typename T, typename Ref, typename Ptr>
+struct circular_buffer_iterator : public iterator<random_access_iterator_tag, T> {
+    // clang-format off
+    using iterator          = circular_buffer_iterator<T, T&, T*>;
+    using const_iterator    = circular_buffer_iterator<T, const T&, const T*>;
+    using self              = circular_buffer_iterator;
+
+    using value_type        = T;
+    using pointer           = Ptr;
+    using reference         = Ref;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+    // clang-format on
+
+    T* buf;
+    size_type mask;
+    size_type pos;
+
+    circular_buffer_iterator() noexcept
+        : buf(nullptr)
+        , mask(0)
+        , pos(0) {}
+
+    circular_buffer_iterator(T* b, size_type m, size_type p) noexcept
+        : buf(b)
+        , mask(m)
+        , pos(p) {}
+
+    circular_buffer_iterator(const iterator& rhs) noexcept
+        : buf(rhs.buf)
+        , mask(rhs.mask)
+        , pos(rhs.pos) {}
+
+    reference operator*() const noexcept {
+        return buf[pos & mask];
+    }
+
+    pointer operator->() const noexcept {
+        return buf + (pos & mask);
+    }
+
+    self& operator++() noexcept {
+        ++pos;
+        return *this;
+    }
+
+    self operator++(int) noexcept {
+        self tmp = *this;
+        ++pos;
+        return tmp;
+    }
+
+    self& operator--() noexcept {
+        --pos;
+        return *this;
+    }
+
+    self operator--(int) noexcept {
+        self tmp = *this;
+        --pos;
+        return tmp;
+    }
+
+    self& operator+=(difference_type n) noexcept {
+        pos += static_cast<size_type>(n);
+        return *this;
+    }
+
+    self operator+(difference_type n) const noexcept {
+        self tmp = *this;
+        return tmp += n;
+    }
+
+    self& operator-=(difference_type n) noexcept {
+        pos -= static_cast<size_type>(n);
+        return *this;
+    }
+
+    self operator-(difference_type n) const noexcept {
+        self tmp = *this;
+        return tmp -= n;
+    }
+
+    difference_type operator-(const self& rhs) const noexcept {
+        return static_cast<difference_type>(pos - rhs.pos);
+    }
+
+    reference operator[](difference_type n) const noexcept {
+        return *(*this + n);
+    }
+
+    bool operator==(const self& rhs) const noexcept {
+        return pos == rhs.pos;
+    }
+    bool operator!=(const self& rhs) const noexcept {
+        return pos != rhs.pos;
+    }
+    bool operator<(const self& rhs) const noexcept {
+        return pos < rhs.pos;
+    }
+    bool operator>(const self& rhs) const noexcept {
+        return rhs < *this;
+    }
+    bool operator<=(const self& rhs) const noexcept {
+        return !(rhs < *this);
+    }
+    bool operator>=(const self& rhs) const noexcept {
+        return !(*this < rhs);
+    }
+};
+
+template <typename T, typename Ref, typename Ptr>
+circular_buffer_iterator<T, Ref, Ptr> operator+(
+    ptrdiff_t n, const circular_buffer_iterator<T, Ref, Ptr>& it) noexcept {
+    return it + n;
+}
+
+/*****************************************************************************************/
+// circular_buffer
+// 第 i 个元素位于 buf_[(head_ + i) & (cap_ - 1)]，head_ 总是小于 cap_
+/*****************************************************************************************/
+template <typename T, typename Alloc = mystl::allocator<T>>
+class circular_buffer {
+    static_assert(std::is_same<T, typename Alloc::value_type>::value,
+        "Alloc::value_type must be the same as T");
+
+public:
+    // clang-format off
+    using allocator_type            = Alloc;
+    using alloc_traits              = mystl::allocator_traits<allocator_type>;
+
+    using value_type                = T;
+    using pointer                   = typename alloc_traits::pointer;
+    using const_pointer             = typename alloc_traits::const_pointer;
+    using reference                 = value_type&;
+    using const_reference           = const value_type&;
+    using size_type                 = typename alloc_traits::size_type;
+    using difference_type           = typename alloc_traits::difference_type;
+
+    using iterator                  = circular_buffer_iterator<T, T&, T*>;
+    using const_iterator            = circular_buffer_iterator<T, const T&, const T*>;
+    using reverse_iterator          = mystl::reverse_iterator<iterator>;
+    using const_reverse_iterator    = mystl::reverse_iterator<const_iterator>;
+
+    // 一段连续的元素：起始地址和元素个数
+    using array_range               = mystl::pair<pointer, size_type>;
+    using const_array_range         = mystl::pair<const_pointer, size_type>;
+    // clang-format on
+
+    allocator_type get_allocator() const {
+        return alloc_ref();
+    }
+
+private:
+    // 分配器作为基类保存，无状态的分配器借助空基类优化不占用额外空间
+    struct buffer_impl : public allocator_type {
+        pointer buf_;                 // 存放元素的空间
+        size_type cap_;               // 分配的元素个数，为 0 或 2 的幂
+        size_type head_;              // 第一个元素的位置
+        size_type size_;              // 元素个数
+        size_type limit_;             // 逻辑容量，不超过 cap_
+        circular_full_policy policy_; // 满时的处理方式
+
+        explicit buffer_impl(const allocator_type& a, circular_full_policy policy) noexcept
+            : allocator_type(a)
+            , buf_(nullptr)
+            , cap_(0)
+            , head_(0)
+            , size_(0)
+            , limit_(0)
+            , policy_(policy) {}
+    };
+
+    buffer_impl impl_;
+
+public:
+    circular_buffer() noexcept(std::is_nothrow_default_constructible<allocator_type>::value)
+        : impl_(allocator_type(), EFullOverwrite) {}
+
+    explicit circular_buffer(const allocator_type& a) noexcept
+        : impl_(a, EFullOverwrite) {}
+
+    explicit circular_buffer(size_type capacity, circular_full_policy policy = EFullOverwrite,
+        const allocator_type& a = allocator_type())
+        : impl_(a, policy) {
+        set_capacity(capacity);
+    }
+
+    // 容量为 ilist 的长度
+    circular_buffer(std::initializer_list<value_type> ilist,
+        circular_full_policy policy = EFullOverwrite, const allocator_type& a = allocator_type())
+        : impl_(a, policy) {
+        set_capacity(ilist.size());
+        push_back(ilist.begin(), ilist.end());
+    }
+
+    circular_buffer(const circular_buffer& rhs)
+        : impl_(alloc_traits::select_on_container_copy_construction(rhs.alloc_ref()),
+              rhs.impl_.policy_) {
+        copy_init(rhs);
+    }
+
+    circular_buffer(const circular_buffer& rhs, const allocator_type& a)
+        : impl_(a, rhs.impl_.policy_) {
+        copy_init(rhs);
+    }
+
+    circular_buffer(circular_buffer&& rhs) noexcept
+        : impl_(mystl::move(rhs.alloc_ref()), rhs.impl_.policy_) {
+        swap_data(rhs);
+    }
+
+    circular_buffer& operator=(const circular_buffer& rhs);
+    circular_buffer& operator=(circular_buffer&& rhs) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value);
+
+    ~circular_buffer() {
+        release_all();
+    }
+
+public:
+    // 迭代器相关操作
+    iterator begin() noexcept {
+        return iterator(impl_.buf_, impl_.cap_ - 1, impl_.head_);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(impl_.buf_, impl_.cap_ - 1, impl_.head_);
+    }
+    iterator end() noexcept {
+        return iterator(impl_.buf_, impl_.cap_ - 1, impl_.head_ + impl_.size_);
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(impl_.buf_, impl_.cap_ - 1, impl_.head_ + impl_.size_);
+    }
+
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+    const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+    const_reverse_iterator crend() const noexcept {
+        return rend();
+    }
+
+    // 容量相关操作
+    bool empty() const noexcept {
+        return impl_.size_ == 0;
+    }
+
+    bool full() const noexcept {
+        return impl_.size_ == impl_.limit_;
+    }
+
+    size_type size() const noexcept {
+        return impl_.size_;
+    }
+
+    size_type capacity() const noexcept {
+        return impl_.limit_;
+    }
+
+    size_type max_size() const noexcept {
+        return alloc_traits::max_size(alloc_ref());
+    }
+
+    circular_full_policy full_policy() const noexcept {
+        return impl_.policy_;
+    }
+
+    void set_full_policy(circular_full_policy policy) noexcept {
+        impl_.policy_ = policy;
+    }
+
+    // 修改逻辑容量，新容量小于元素个数时丢弃最旧的元素
+    void set_capacity(size_type n);
+
+    // 把元素搬到空间的开头，之后 array_two() 为空；返回第一个元素的地址
+    pointer linearize();
+
+    // 访问元素相关操作
+    reference operator[](size_type n) {
+        MYSTL_DEBUG(n < size());
+        return impl_.buf_[(impl_.head_ + n) & (impl_.cap_ - 1)];
+    }
+
+    const_reference operator[](size_type n) const {
+        MYSTL_DEBUG(n < size());
+        return impl_.buf_[(impl_.head_ + n) & (impl_.cap_ - 1)];
+    }
+
+    reference at(size_type n) {
+        THROW_OUT_OF_RANGE_IF(
+            !(n < size()), "circular_buffer<T>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(
+            !(n < size()), "circular_buffer<T>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return impl_.buf_[impl_.head_];
+    }
+
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return impl_.buf_[impl_.head_];
+    }
+
+    reference back() {
+        MYSTL_DEBUG(!empty());
+        return (*this)[impl_.size_ - 1];
+    }
+
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return (*this)[impl_.size_ - 1];
+    }
+
+    // 按从旧到新的顺序返回两段连续的元素，元素没有回绕时第二段为空
+    array_range array_one() noexcept {
+        return array_range(impl_.buf_ + impl_.head_, first_span_size());
+    }
+
+    const_array_range array_one() const noexcept {
+        return const_array_range(impl_.buf_ + impl_.head_, first_span_size());
+    }
+
+    array_range array_two() noexcept {
+        return array_range(impl_.buf_, impl_.size_ - first_span_size());
+    }
+
+    const_array_range array_two() const noexcept {
+        return const_array_range(impl_.buf_, impl_.size_ - first_span_size());
+    }
+
+    // 按从旧到新的顺序把所有元素复制到 result，每一段只调用一次 mystl::copy
+    template <typename OutputIter>
+    OutputIter copy_to(OutputIter result) const {
+        const auto one = array_one();
+        const auto two = array_two();
+        result = mystl::copy(one.first, one.first + one.second, result);
+        return mystl::copy(two.first, two.first + two.second, result);
+    }
+
+    // 修改容器相关操作
+
+    // emplace_back / emplace_front，容器满并且策略为 EFullReject 时不插入，返回 false
+    template <typename... Args>
+    bool emplace_back(Args&&... args);
+
+    template <typename... Args>
+    bool emplace_front(Args&&... args);
+
+    bool push_back(const value_type& value) {
+        return emplace_back(value);
+    }
+
+    bool push_back(value_type&& value) {
+        return emplace_back(mystl::move(value));
+    }
+
+    bool push_front(const value_type& value) {
+        return emplace_front(value);
+    }
+
+    bool push_front(value_type&& value) {
+        return emplace_front(mystl::move(value));
+    }
+
+    // 在尾部批量插入，最多分两段构造；返回插入的元素个数
+    // EFullOverwrite 时输入比容量多的部分只保留最后 capacity() 个
+    template <typename Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type = 0>
+    size_type push_back(Iter first, Iter last) {
+        return copy_append(first, last, iterator_category(first));
+    }
+
+    // pop_front / pop_back
+    void pop_front() noexcept {
+        MYSTL_DEBUG(!empty());
+        alloc_traits::destroy(alloc_ref(), impl_.buf_ + impl_.head_);
+        impl_.head_ = (impl_.head_ + 1) & (impl_.cap_ - 1);
+        --impl_.size_;
+    }
+
+    void pop_back() noexcept {
+        MYSTL_DEBUG(!empty());
+        alloc_traits::destroy(alloc_ref(), &back());
+        --impl_.size_;
+    }
+
+    // 弹出最旧的 n 个元素
+    void pop_front(size_type n) noexcept;
+
+    void clear() noexcept {
+        pop_front(impl_.size_);
+        impl_.head_ = 0;
+    }
+
+    void swap(circular_buffer& rhs) noexcept;
+
+private:
+    // helper functions
+
+    allocator_type& alloc_ref() noexcept {
+        return impl_;
+    }
+
+    const allocator_type& alloc_ref() const noexcept {
+        return impl_;
+    }
+
+    size_type first_span_size() const noexcept {
+        const size_type to_end = impl_.cap_ - impl_.head_;
+        return impl_.size_ < to_end ? impl_.size_ : to_end;
+    }
+
+    // 在尾部 / 头部构造一个元素，调用前要求容器未满
+    template <typename... Args>
+    void construct_back(Args&&... args);
+
+    template <typename... Args>
+    void construct_front(Args&&... args);
+
+    // 容器已满时能否再插入新元素
+    bool can_make_room() const noexcept {
+        return impl_.policy_ == EFullGrow ||
+               (impl_.policy_ == EFullOverwrite && impl_.limit_ != 0);
+    }
+
+    // 容器已满时为一个新元素腾出位置，at_back 表示新元素插入尾部，要求 can_make_room()
+    void make_room(bool at_back);
+
+    // 析构 [first, last) 中的元素，与单个元素的 pop 一样经过 alloc_traits::destroy
+    void destroy_range(pointer first, pointer last) noexcept {
+        for (; first != last; ++first) {
+            alloc_traits::destroy(alloc_ref(), first);
+        }
+    }
+
+    // 把元素按顺序搬到一块容纳 new_cap 个元素的新空间的开头
+    void relocate_to(size_type new_cap);
+
+    // 移动构造可能抛出异常并且可以复制时，换空间改为复制，抛出异常时原有的元素保持不变
+    using move_on_grow = m_bool_constant<std::is_nothrow_move_constructible<T>::value ||
+                                         !std::is_copy_constructible<T>::value>;
+
+    pointer transfer(pointer first, pointer last, pointer result, m_true_type) {
+        return mystl::uninitialized_move(first, last, result);
+    }
+
+    pointer transfer(pointer first, pointer last, pointer result, m_false_type) {
+        return mystl::uninitialized_copy(first, last, result);
+    }
+
+    void release_all() noexcept;
+    void copy_init(const circular_buffer& rhs);
+
+    template <typename Iter>
+    size_type copy_append(Iter first, Iter last, input_iterator_tag);
+
+    template <typename Iter>
+    size_type copy_append(Iter first, Iter last, forward_iterator_tag);
+
+    // 只交换数据，不交换分配器
+    void swap_data(circular_buffer& rhs) noexcept;
+};
+
+/*****************************************************************************************/
+
+// 复制赋值运算符
+template <typename T, typename Alloc>
+circular_buffer<T, Alloc>& circular_buffer<T, Alloc>::operator=(const circular_buffer& rhs) {
+    if (this != &rhs) {
+        release_all();
+        if (alloc_traits::propagate_on_container_copy_assignment::value)
+            alloc_ref() = rhs.alloc_ref();
+        impl_.policy_ = rhs.impl_.policy_;
+        copy_init(rhs);
+    }
+    return *this;
+}
+
+// 移动赋值运算符，分配器可以传播或者相等时直接接管 rhs 的空间，否则逐个移动元素
+template <typename T, typename Alloc>
+circular_buffer<T, Alloc>& circular_buffer<T, Alloc>::operator=(circular_buffer&& rhs) noexcept(
+    alloc_traits::propagate_on_container_move_assignment::value ||
+    alloc_traits::is_always_equal::value) {
+    if (this == &rhs)
+        return *this;
+    release_all();
+    impl_.policy_ = rhs.impl_.policy_;
+    if (alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value || alloc_ref() == rhs.alloc_ref()) {
+        if (alloc_traits::propagate_on_container_move_assignment::value)
+            alloc_ref() = mystl::move(rhs.alloc_ref());
+        swap_data(rhs);
+    } else {
+        set_capacity(rhs.capacity());
+        for (auto& value : rhs) {
+            emplace_back(mystl::move(value));
+        }
+        rhs.clear();
+    }
+    return *this;
+}
+
+template <typename T, typename Alloc>
+void circular_buffer<T, Alloc>::set_capacity(size_type n) {
+    if (n < impl_.size_)
+        pop_front(impl_.size_ - n);
+    const size_type new_cap = circular_buffer_round_up(n);
+    if (new_cap != impl_.cap_)
+        relocate_to(new_cap);
+    impl_.limit_ = n;
+}
+
+template <typename T, typename Alloc>
+typename circular_buffer<T, Alloc>::pointer circular_buffer<T, Alloc>::linearize() {
+    if (first_span_size() != impl_.size_)
+        relocate_to(impl_.cap_);
+    return impl_.buf_ + impl_.head_;
+}
+
+// 在尾部就地构建元素。容器已满时 args 可能引用容器中的元素，腾出位置会析构 (EFullOverwrite)
+// 或搬走 (EFullGrow) 它，所以必须先用 args 构造出新元素：
+// 空间中还有空位时直接构造在空位上再弹出另一端，否则先构造一个临时对象再移动到腾出的位置
+template <typename T, typename Alloc>
+template <typename... Args>
+bool circular_buffer<T, Alloc>::emplace_back(Args&&... args) {
+    if (impl_.size_ == impl_.limit_) {
+        if (!can_make_room())
+            return false;
+        if (impl_.policy_ == EFullOverwrite && impl_.size_ < impl_.cap_) {
+            construct_back(mystl::forward<Args>(args)...);
+            pop_front();
+            return true;
+        }
+        value_type value(mystl::forward<Args>(args)...);
+        make_room(true);
+        construct_back(mystl::move(value));
+        return true;
+    }
+    construct_back(mystl::forward<Args>(args)...);
+    return true;
+}
+
+// 在头部就地构建元素，容器已满时的处理同 emplace_back
+template <typename T, typename Alloc>
+template <typename... Args>
+bool circular_buffer<T, Alloc>::emplace_front(Args&&... args) {
+    if (impl_.size_ == impl_.limit_) {
+        if (!can_make_room())
+            return false;
+        if (impl_.policy_ == EFullOverwrite && impl_.size_ < impl_.cap_) {
+            construct_front(mystl::forward<Args>(args)...);
+            pop_back();
+            return true;
+        }
+        value_type value(mystl::forward<Args>(args)...);
+        make_room(false);
+        construct_front(mystl::move(value));
+        return true;
+    }
+    construct_front(mystl::forward<Args>(args)...);
+    return true;
+}
+
+template <typename T, typename Alloc>
+void circular_buffer<T, Alloc>::pop_front(size_type n) noexcept {
+    MYSTL_DEBUG(n <= size());
+    if (n == 0)
+        return;
+    const size_type to_end = impl_.cap_ - impl_.head_;
+    if (n <= to_end) {
+        destroy_range(impl_.buf_ + impl_.head_, impl_.buf_ + impl_.head_ + n);
+    } else {
+        destroy_range(impl_.buf_ + impl_.head_, impl_.buf_ + impl_.cap_);
+        destroy_range(impl_.buf_, impl_.buf_ + (n - to_end));
+    }
+    impl_.head_ = (impl_.head_ + n) & (impl_.cap_ - 1);
+    impl_.size_ -= n;
+}
+
+// 与另一个 circular_buffer 交换，propagate_on_container_swap 为 false 时要求两者的分配器相等
+template <typename T, typename Alloc>
+void circular_buffer<T, Alloc>::swap(circular_buffer& rhs) noexcept {
+    if (this != &rhs) {
+        if (alloc_traits::propagate_on_container_swap::value) {
+            mystl::swap(alloc_ref(), rhs.alloc_ref());
+        } else {
+            MYSTL_DEBUG(alloc_ref() == rhs.alloc_ref());
+        }
+        mystl::swap(impl_.policy_, rhs.impl_.policy_);
+        swap_data(rhs);
+    }
+}
+
+/*****************************************************************************************/
+// helper function
+
+template <typename T, typename Alloc>
+template <typename... Args>
+void circular_buffer<T, Alloc>::construct_back(Args&&... args) {
+    alloc_traits::construct(alloc_ref(),
+        impl_.buf_ + ((impl_.head_ + impl_.size_) & (impl_.cap_ - 1)),
+        mystl::forward<Args>(args)...);
+    ++impl_.size_;
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+void circular_buffer<T, Alloc>::construct_front(Args&&... args) {
+    const size_type new_head = (impl_.head_ - 1) & (impl_.cap_ - 1);
+    alloc_traits::construct(alloc_ref(), impl_.buf_ + new_head, mystl::forward<Args>(args)...);
+    impl_.head_ = new_head;
+    ++impl_.size_;
+}
+
+template <typename T, typename Alloc>
+void circular_buffer<T, Alloc>::make_room(bool at_back) {
+    MYSTL_DEBUG(can_make_room());
+    if (impl_.policy_ == EFullGrow) {
+        set_capacity(impl_.limit_ == 0 ? 1 : impl_.limit_ * 2);
+    } else if (at_back) {
+        pop_front();
+    } else {
+        pop_back();
+    }
+}
+
+template <typename T, typename Alloc>
+void circular_buffer<T, Alloc>::relocate_to(size_type new_cap) {
+    pointer new_buf = new_cap == 0 ? nullptr : alloc_traits::allocate(alloc_ref(), new_cap);
+    if (impl_.size_ != 0) {
+        const auto one = array_one();
+        const auto two = array_two();
+        if (mystl::is_trivially_relocatable<T>::value) {
+            mystl::uninitialized_relocate(one.first, one.first + one.second, new_buf);
+            mystl::uninitialized_relocate(
+                two.first, two.first + two.second, new_buf + one.second);
+        } else {
+            // 两段都搬好之后才析构旧元素，中途抛出异常时原有的元素不变，只需要释放新空间
+            pointer mid = new_buf;
+            try {
+                mid = transfer(one.first, one.first + one.second, new_buf, move_on_grow{});
+                transfer(two.first, two.first + two.second, mid, move_on_grow{});
+            } catch (...) {
+                destroy_range(new_buf, mid);
+                alloc_traits::deallocate(alloc_ref(), new_buf, new_cap);
+                throw;
+            }
+            destroy_range(one.first, one.first + one.second);
+            destroy_range(two.first, two.first + two.second);
+        }
+    }
+    if (impl_.buf_ != nullptr)
+        alloc_traits::deallocate(alloc_ref(), impl_.buf_, impl_.cap_);
+    impl_.buf_ = new_buf;
+    impl_.cap_ = new_cap;
+    impl_.head_ = 0;
+}
+
+template <typename T, typename Alloc>
+void circular_buffer<T, Alloc>::release_all() noexcept {
+    clear();
+    if (impl_.buf_ != nullptr)
+        alloc_traits::deallocate(alloc_ref(), impl_.buf_, impl_.cap_);
+    impl_.buf_ = nullptr;
+    impl_.cap_ = 0;
+    impl_.limit_ = 0;
+}
+
+// 复制后的元素从空间的开头连续存放，两段分别复制
+template <typename T, typename Alloc>
+void circular_buffer<T, Alloc>::copy_init(const circular_buffer& rhs) {
+    set_capacity(rhs.capacity());
+    const auto one = rhs.array_one();
+    const auto two = rhs.array_two();
+    pointer mid = impl_.buf_;
+    try {
+        mid = mystl::uninitialized_copy(one.first, one.first + one.second, impl_.buf_);
+        mystl::uninitialized_copy(two.first, two.first + two.second, mid);
+    } catch (...) {
+        // 从构造函数调用时析构函数不会执行，空间要在这里释放
+        destroy_range(impl_.buf_, mid);
+        release_all();
+        throw;
+    }
+    impl_.size_ = rhs.size();
+}
+
+template <typename T, typename Alloc>
+template <typename Iter>
+typename circular_buffer<T, Alloc>::size_type circular_buffer<T, Alloc>::copy_append(
+    Iter first, Iter last, input_iterator_tag) {
+    size_type n = 0;
+    for (; first != last; ++first) {
+        if (!emplace_back(*first))
+            break;
+        ++n;
+    }
+    return n;
+}
+
+// 先腾出足够的位置，再把输入分成空闲空间中的两段，分别用 uninitialized_copy 构造
+template <typename T, typename Alloc>
+template <typename Iter>
+typename circular_buffer<T, Alloc>::size_type circular_buffer<T, Alloc>::copy_append(
+    Iter first, Iter last, forward_iterator_tag) {
+    auto n = static_cast<size_type>(mystl::distance(first, last));
+    switch (impl_.policy_) {
+    case EFullOverwrite:
+        if (n > impl_.limit_) {
+            mystl::advance(first, n - impl_.limit_);
+            n = impl_.limit_;
+        }
+        if (n > impl_.limit_ - impl_.size_)
+            pop_front(n - (impl_.limit_ - impl_.size_));
+        break;
+    case EFullGrow:
+        if (n > impl_.limit_ - impl_.size_) {
+            size_type new_limit = impl_.limit_ == 0 ? 1 : impl_.limit_;
+            while (new_limit < impl_.size_ + n) {
+                new_limit *= 2;
+            }
+            set_capacity(new_limit);
+        }
+        break;
+    default:
+        if (n > impl_.limit_ - impl_.size_)
+            n = impl_.limit_ - impl_.size_;
+        break;
+    }
+    if (n == 0)
+        return 0;
+    const size_type tail = (impl_.head_ + impl_.size_) & (impl_.cap_ - 1);
+    const size_type to_end = impl_.cap_ - tail;
+    const size_type n1 = n < to_end ? n : to_end;
+    Iter mid = first;
+    mystl::advance(mid, n1);
+    mystl::uninitialized_copy(first, mid, impl_.buf_ + tail);
+    impl_.size_ += n1;
+    if (n1 != n) {
+        Iter end = mid;
+        mystl::advance(end, n - n1);
+        mystl::uninitialized_copy(mid, end, impl_.buf_);
+        impl_.size_ += n - n1;
+    }
+    return n;
+}
+
+template <typename T, typename Alloc>
+void circular_buffer<T, Alloc>::swap_data(circular_buffer& rhs) noexcept {
+    mystl::swap(impl_.buf_, rhs.impl_.buf_);
+    mystl::swap(impl_.cap_, rhs.impl_.cap_);
+    mystl::swap(impl_.head_, rhs.impl_.head_);
+    mystl::swap(impl_.size_, rhs.impl_.size_);
+    mystl::swap(impl_.limit_, rhs.impl_.limit_);
+}
+
+// 重载比较操作符
+template <typename T, typename Alloc>
+bool operator==(const circular_buffer<T, Alloc>& lhs, const circular_buffer<T, Alloc>& rhs) {
+    return lhs.size() == rhs.size() && mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, typename Alloc>
+bool operator!=(const circular_buffer<T, Alloc>& lhs, const circular_buffer<T, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T, typename Alloc>
+bool operator<(const circular_buffer<T, Alloc>& lhs, const circular_buffer<T, Alloc>& rhs) {
+    return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+// 重载 mystl 的 swap
+template <typename T, typename Alloc>
+void swap(circular_buffer<T, Alloc>& lhs, circular_buffer<T, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+namespace pmr {
+
+// 使用 polymorphic_allocator 的 circular_buffer，不同内存资源上的 circular_buffer 属于同一类型
+template <typename T>
+using circular_buffer = mystl::circular_buffer<T, polymorphic_allocator<T>>;
+
+} // namespace pmr
+
+} // namespace mystl
@@ -0,0 +1,812 @@
+#pragma once
+
+// 这个头文件包含一个模板类 concurrent_vector
+// concurrent_vector : 可以由多个线程同时追加元素的向量，元素存放在大小按 2 倍增长的段中。
+//
+// 第 k 段有 B * 2^k 个元素 (B = 2^EConcurrentFirstSegmentShift)，存放下标
+// [B * (2^k - 1), B * (2^(k+1) - 1)) 上的元素；下标 i 所在的段由 i + B 的最高位直接算出。
+// 段一旦分配就不再移动，所以增长时已有元素的地址、引用和迭代器都不会失效。
+//
+// push_back / emplace_back / grow_by / grow_to_at_least 可以由多个线程同时调用：
+// 先分配覆盖 [size(), size() + n) 的段，再用 CAS 领取下标区间，
+// 其他线程抢先追加导致 CAS 失败时按新的 size() 重试。
+// 需要的段不存在时各线程用 CAS 竞争安装，失败的一方释放自己的段。
+// 段分配失败时还没有领取下标，size() 不变，容器仍然可用。
+// 追加的同时，其他线程可以读写已经构造好的元素。
+// size() 包含已经领取、可能还在构造中的元素，只有通过返回值或者其他同步手段得知构造完成的元素才能读取。
+//
+// clear、swap、赋值、析构等其余的修改操作不能与其他操作同时进行。
+//
+// 下标领取后不能放弃，所以要求 T 的移动构造不抛出异常：
+// 构造可能抛出异常时先在段外构造好，领取下标后再移动进去。
+
+#include <atomic>
+#include <initializer_list>
+
+#include "exceptdef.h"
+#include "iterator.h"
+#include "memory.h"
+#include "memory_resource.h"
+#include "util.h"
+#include "vector.h"
+
+namespace mystl {
+
+enum { EConcurrentFirstSegmentShift = 4 }; // 第 0 段的元素个数为 2^4
+
+/*****************************************************************************************/
+// concurrent_vector_iterator
+// 保存容器的指针和下标，解引用时按下标计算地址
+/*****************************************************************************************/
+template <typename Vector, typename T>
+struct concurrent_vector_iterator : public iterator<random_access_iterator_tag, T> {
+    // clang-format off
+    using self              = concurrent_vector_iterator;
+
+    using value_type        = typename std::remove_const<T>::type;
+    using pointer           = T*;
+    using reference         = T&;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+    // clang-format on
+
+    Vector* vec;
+    size_type idx;
+
+    concurrent_vector_iterator() noexcept
+        : vec(nullptr)
+        , idx(0) {}
+
+    concurrent_vector_iterator(Vector* v, size_type i) noexcept
+        : vec(v)
+        , idx(i) {}
+
+    // 非 const 迭代器转换为 const 迭代器
+    template <typename V, typename U,
+        typename std::enable_if<std::is_convertible<V*, Vector*>::value &&
+                                    std::is_convertible<U*, T*>::value,
+            int>::type = 0>
+    concurrent_vector_iterator(const concurrent_vector_iterator<V, U>& rhs) noexcept
+        : vec(rhs.vec)
+        , idx(rhs.idx) {}
+
+    reference operator*() const noexcept {
+        return (*vec)[idx];
+    }
+
+    pointer operator->() const noexcept {
+        return &(*vec)[idx];
+    }
+
+    self& operator++() noexcept {
+        ++idx;
+        return *this;
+    }
+
+    self operator++(int) noexcept {
+        self tmp = *this;
+        ++idx;
+        return tmp;
+    }
+
+    self& operator--() noexcept {
+        --idx;
+        return *this;
+    }
+
+    self operator--(int) noexcept {
+        self tmp = *this;
+        --idx;
+        return tmp;
+    }
+
+    self& operator+=(difference_type n) noexcept {
+        idx += static_cast<size_type>(n);
+        return *this;
+    }
+
+    self operator+(difference_type n) const noexcept {
+        self tmp = *this;
+        return tmp += n;
+    }
+
+    self& operator-=(difference_type n) noexcept {
+        idx -= static_cast<size_type>(n);
+        return *this;
+    }
+
+    self operator-(difference_type n) const noexcept {
+        self tmp = *this;
+        return tmp -= n;
+    }
+
+    difference_type operator-(const self& rhs) const noexcept {
+        return static_cast<difference_type>(idx - rhs.idx);
+    }
+
+    reference operator[](difference_type n) const noexcept {
+        return *(*this + n);
+    }
+
+    bool operator==(const self& rhs) const noexcept {
+        return idx == rhs.idx;
+    }
+    bool operator!=(const self& rhs) const noexcept {
+        return idx != rhs.idx;
+    }
+    bool operator<(const self& rhs) const noexcept {
+        return idx < rhs.idx;
+    }
+    bool operator>(const self& rhs) const noexcept {
+        return rhs < *this;
+    }
+    bool operator<=(const self& rhs) const noexcept {
+        return !(rhs < *this);
+    }
+    bool operator>=(const self& rhs) const noexcept {
+        return !(*this < rhs);
+    }
+};
+
+template <typename Vector, typename T>
+concurrent_vector_iterator<Vector, T> operator+(
+    ptrdiff_t n, const concurrent_vector_iterator<Vector, T>& it) noexcept {
+    return it + n;
+}
+
+/*****************************************************************************************/
+// concurrent_vector
+/*****************************************************************************************/
+template <typename T, typename Alloc = mystl::allocator<T>>
+class concurrent_vector {
+    static_assert(std::is_same<T, typename Alloc::value_type>::value,
+        "Alloc::value_type must be the same as T");
+    static_assert(std::is_nothrow_move_constructible<T>::value,
+        "concurrent_vector<T> requires T to be nothrow move constructible");
+
+public:
+    // clang-format off
+    using allocator_type            = Alloc;
+    using alloc_traits              = mystl::allocator_traits<allocator_type>;
+
+    using value_type                = T;
+    using pointer                   = typename alloc_traits::pointer;
+    using const_pointer             = typename alloc_traits::const_pointer;
+    using reference                 = value_type&;
+    using const_reference           = const value_type&;
+    using size_type                 = typename alloc_traits::size_type;
+    using difference_type           = typename alloc_traits::difference_type;
+
+    using iterator                  = concurrent_vector_iterator<concurrent_vector, T>;
+    using const_iterator            = concurrent_vector_iterator<const concurrent_vector, const T>;
+    using reverse_iterator          = mystl::reverse_iterator<iterator>;
+    using const_reverse_iterator    = mystl::reverse_iterator<const_iterator>;
+    // clang-format on
+
+    allocator_type get_allocator() const {
+        return impl_;
+    }
+
+private:
+    // clang-format off
+    static constexpr size_type first_shift      = EConcurrentFirstSegmentShift;
+    static constexpr size_type first_size       = size_type(1) << first_shift;
+    static constexpr size_type segment_count    = sizeof(size_type) * 8 - first_shift;
+    // clang-format on
+
+    struct vector_impl : public allocator_type {
+        std::atomic<pointer> segments_[segment_count]; // 各段的起始地址，未分配时为 nullptr
+        std::atomic<size_type> size_;                  // 已经领取的元素个数
+
+        explicit vector_impl(const allocator_type& a) noexcept
+            : allocator_type(a)
+            , size_(0) {
+            for (auto& seg : segments_) {
+                seg.store(nullptr, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    vector_impl impl_;
+
+public:
+    concurrent_vector() noexcept(std::is_nothrow_default_constructible<allocator_type>::value)
+        : impl_(allocator_type()) {}
+
+    explicit concurrent_vector(const allocator_type& a) noexcept
+        : impl_(a) {}
+
+    explicit concurrent_vector(size_type n, const allocator_type& a = allocator_type())
+        : impl_(a) {
+        init_guard([&] { grow_by(n); });
+    }
+
+    concurrent_vector(
+        size_type n, const value_type& value, const allocator_type& a = allocator_type())
+        : impl_(a) {
+        init_guard([&] { grow_by(n, value); });
+    }
+
+    template <typename Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type = 0>
+    concurrent_vector(Iter first, Iter last, const allocator_type& a = allocator_type())
+        : impl_(a) {
+        init_guard([&] { grow_by(first, last); });
+    }
+
+    concurrent_vector(
+        std::initializer_list<value_type> ilist, const allocator_type& a = allocator_type())
+        : concurrent_vector(ilist.begin(), ilist.end(), a) {}
+
+    concurrent_vector(const concurrent_vector& rhs)
+        : impl_(alloc_traits::select_on_container_copy_construction(rhs.alloc_ref())) {
+        init_guard([&] { grow_by(rhs.begin(), rhs.end()); });
+    }
+
+    concurrent_vector(concurrent_vector&& rhs) noexcept
+        : impl_(mystl::move(rhs.alloc_ref())) {
+        swap_data(rhs);
+    }
+
+    concurrent_vector& operator=(const concurrent_vector& rhs);
+    concurrent_vector& operator=(concurrent_vector&& rhs) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value);
+
+    concurrent_vector& operator=(std::initializer_list<value_type> ilist) {
+        clear();
+        grow_by(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    ~concurrent_vector() {
+        release_all();
+    }
+
+public:
+    // 迭代器相关操作
+    iterator begin() noexcept {
+        return iterator(this, 0);
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(this, 0);
+    }
+    iterator end() noexcept {
+        return iterator(this, size());
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(this, size());
+    }
+
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+    const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+    const_reverse_iterator crend() const noexcept {
+        return rend();
+    }
+
+    // 容量相关操作
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    // 包含其他线程已经领取、可能还在构造中的元素
+    size_type size() const noexcept {
+        return impl_.size_.load(std::memory_order_acquire);
+    }
+
+    size_type max_size() const noexcept {
+        return alloc_traits::max_size(alloc_ref()) / 2;
+    }
+
+    // 已经分配的段能够容纳的元素个数 (假定各段从第 0 段开始连续分配)
+    size_type capacity() const noexcept {
+        size_type k = 0;
+        while (k < segment_count && impl_.segments_[k].load(std::memory_order_acquire) != nullptr) {
+            ++k;
+        }
+        return segment_base(k);
+    }
+
+    // 预先分配容纳 n 个元素所需的段，可以与追加操作同时进行
+    void reserve(size_type n) {
+        THROW_LENGTH_ERROR_IF(n > max_size(), "concurrent_vector<T>'s size too big");
+        if (n == 0)
+            return;
+        const size_type last = segment_index(n - 1);
+        for (size_type k = 0; k <= last; ++k) {
+            segment_at(k);
+        }
+    }
+
+    // 访问元素相关操作，下标对应的段必须已经分配 (下标小于 size())
+    reference operator[](size_type n) noexcept {
+        MYSTL_DEBUG(n < size());
+        return element_at(n);
+    }
+
+    const_reference operator[](size_type n) const noexcept {
+        MYSTL_DEBUG(n < size());
+        return const_cast<concurrent_vector*>(this)->element_at(n);
+    }
+
+    reference at(size_type n) {
+        THROW_OUT_OF_RANGE_IF(
+            !(n < size()), "concurrent_vector<T>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(
+            !(n < size()), "concurrent_vector<T>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    reference front() noexcept {
+        MYSTL_DEBUG(!empty());
+        return (*this)[0];
+    }
+
+    const_reference front() const noexcept {
+        MYSTL_DEBUG(!empty());
+        return (*this)[0];
+    }
+
+    reference back() noexcept {
+        MYSTL_DEBUG(!empty());
+        return (*this)[size() - 1];
+    }
+
+    const_reference back() const noexcept {
+        MYSTL_DEBUG(!empty());
+        return (*this)[size() - 1];
+    }
+
+    // 并发追加相关操作，返回的引用和迭代器在容器析构 (或 clear) 之前一直有效
+
+    template <typename... Args>
+    reference emplace_back(Args&&... args) {
+        return emplace_back_cat(std::is_nothrow_constructible<T, Args&&...>{},
+            mystl::forward<Args>(args)...);
+    }
+
+    reference push_back(const value_type& value) {
+        return emplace_back(value);
+    }
+
+    reference push_back(value_type&& value) {
+        return emplace_back(mystl::move(value));
+    }
+
+    // 在尾部追加 n 个值初始化的元素，返回指向第一个新元素的迭代器
+    iterator grow_by(size_type n);
+
+    // 在尾部追加 n 个 value 的副本
+    iterator grow_by(size_type n, const value_type& value);
+
+    // 在尾部追加 [first, last) 的副本，各段上逐个用 alloc_traits::construct 构造
+    template <typename Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type = 0>
+    iterator grow_by(Iter first, Iter last) {
+        return grow_by_range(first, last, iterator_category(first));
+    }
+
+    iterator grow_by(std::initializer_list<value_type> ilist) {
+        return grow_by(ilist.begin(), ilist.end());
+    }
+
+    // 元素个数少于 n 时追加值初始化的元素，使元素个数恰好为 n；
+    // 返回指向本次追加的第一个元素的迭代器，没有追加时返回指向下标 n 的迭代器
+    iterator grow_to_at_least(size_type n);
+
+    // 以下操作不能与其他操作同时进行
+
+    // 析构所有元素，保留第 0 段，其他段归还
+    void clear() noexcept;
+
+    // 归还没有元素的段
+    void shrink_to_fit() noexcept;
+
+    void swap(concurrent_vector& rhs) noexcept;
+
+private:
+    // helper functions
+
+    allocator_type& alloc_ref() noexcept {
+        return impl_;
+    }
+
+    const allocator_type& alloc_ref() const noexcept {
+        return impl_;
+    }
+
+    // 下标 n 所在的段
+    static size_type segment_index(size_type n) noexcept {
+        return highest_bit(n + first_size) - first_shift;
+    }
+
+    // 第 k 段第一个元素的下标
+    static size_type segment_base(size_type k) noexcept {
+        return (first_size << k) - first_size;
+    }
+
+    static size_type segment_size(size_type k) noexcept {
+        return first_size << k;
+    }
+
+    // n 不为 0；或上 1 让编译器知道结果在 [0, 63] 之内
+    static size_type highest_bit(size_type n) noexcept {
+#if defined(__GNUC__)
+        return sizeof(unsigned long long) * 8 - 1 -
+               static_cast<size_type>(__builtin_clzll(static_cast<unsigned long long>(n) | 1));
+#else
+        size_type r = 0;
+        while (n >>= 1) {
+            ++r;
+        }
+        return r;
+#endif
+    }
+
+    reference element_at(size_type n) noexcept {
+        const size_type k = segment_index(n);
+        return impl_.segments_[k].load(std::memory_order_acquire)[n - segment_base(k)];
+    }
+
+    // 第 k 段的起始地址，段不存在时分配并用 CAS 安装
+    pointer segment_at(size_type k);
+
+    // 分配覆盖 n 个新下标的段，再领取这些下标，返回第一个下标
+    size_type claim(size_type n);
+
+    // 分配覆盖下标 [start, start + n) 的段
+    void ensure_segments(size_type start, size_type n);
+
+    // 在 [start, start + n) 上按段调用 fn(p, count)，p 为这一段中第一个位置的地址
+    template <typename Fn>
+    void for_each_span(size_type start, size_type n, Fn fn);
+
+    template <typename... Args>
+    reference emplace_back_cat(std::true_type, Args&&... args) {
+        const size_type idx = claim(1);
+        pointer p = &element_at(idx);
+        alloc_traits::construct(alloc_ref(), p, mystl::forward<Args>(args)...);
+        return *p;
+    }
+
+    template <typename... Args>
+    reference emplace_back_cat(std::false_type, Args&&... args) {
+        value_type tmp(mystl::forward<Args>(args)...);
+        return emplace_back_cat(std::true_type{}, mystl::move(tmp));
+    }
+
+    template <typename Iter>
+    iterator grow_by_range(Iter first, Iter last, input_iterator_tag);
+
+    template <typename Iter>
+    iterator grow_by_range(Iter first, Iter last, forward_iterator_tag);
+
+    // 把 tmp 中的元素移动到新领取的位置上，元素的复制可能抛出异常时先复制到 tmp
+    iterator grow_by_moving(mystl::vector<value_type, allocator_type>& tmp);
+
+    // 构造函数中追加失败时归还已经分配的段
+    template <typename Fn>
+    void init_guard(Fn fn) {
+        try {
+            fn();
+        } catch (...) {
+            release_all();
+            throw;
+        }
+    }
+
+    void release_all() noexcept;
+
+    void swap_data(concurrent_vector& rhs) noexcept;
+};
+
+/*****************************************************************************************/
+
+// 复制赋值运算符
+template <typename T, typename Alloc>
+concurrent_vector<T, Alloc>& concurrent_vector<T, Alloc>::operator=(const concurrent_vector& rhs) {
+    if (this != &rhs) {
+        release_all();
+        if (alloc_traits::propagate_on_container_copy_assignment::value)
+            alloc_ref() = rhs.alloc_ref();
+        grow_by(rhs.begin(), rhs.end());
+    }
+    return *this;
+}
+
+// 移动赋值运算符，分配器可以传播或者相等时直接接管 rhs 的段，否则逐个移动元素
+template <typename T, typename Alloc>
+concurrent_vector<T, Alloc>& concurrent_vector<T, Alloc>::operator=(
+    concurrent_vector&& rhs) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                      alloc_traits::is_always_equal::value) {
+    if (this == &rhs)
+        return *this;
+    release_all();
+    if (alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value || alloc_ref() == rhs.alloc_ref()) {
+        if (alloc_traits::propagate_on_container_move_assignment::value)
+            alloc_ref() = mystl::move(rhs.alloc_ref());
+        swap_data(rhs);
+    } else {
+        reserve(rhs.size());
+        for (auto& value : rhs) {
+            emplace_back(mystl::move(value));
+        }
+        rhs.clear();
+    }
+    return *this;
+}
+
+template <typename T, typename Alloc>
+typename concurrent_vector<T, Alloc>::iterator concurrent_vector<T, Alloc>::grow_by(size_type n) {
+    if (!std::is_nothrow_default_constructible<value_type>::value) {
+        mystl::vector<value_type, allocator_type> tmp(n, alloc_ref());
+        return grow_by_moving(tmp);
+    }
+    const size_type start = claim(n);
+    for_each_span(start, n, [this](pointer p, size_type count) {
+        for (size_type i = 0; i < count; ++i) {
+            alloc_traits::construct(alloc_ref(), p + i);
+        }
+    });
+    return iterator(this, start);
+}
+
+template <typename T, typename Alloc>
+typename concurrent_vector<T, Alloc>::iterator concurrent_vector<T, Alloc>::grow_by(
+    size_type n, const value_type& value) {
+    if (!std::is_nothrow_copy_constructible<value_type>::value) {
+        mystl::vector<value_type, allocator_type> tmp(n, value, alloc_ref());
+        return grow_by_moving(tmp);
+    }
+    const size_type start = claim(n);
+    for_each_span(start, n, [&](pointer p, size_type count) {
+        for (size_type i = 0; i < count; ++i) {
+            alloc_traits::construct(alloc_ref(), p + i, value);
+        }
+    });
+    return iterator(this, start);
+}
+
+// 用 CAS 把元素个数从 cur 改为 n，其他线程同时追加导致 CAS 失败时按新的元素个数重试
+template <typename T, typename Alloc>
+typename concurrent_vector<T, Alloc>::iterator concurrent_vector<T, Alloc>::grow_to_at_least(
+    size_type n) {
+    THROW_LENGTH_ERROR_IF(n > max_size(), "concurrent_vector<T>'s size too big");
+    const bool in_place = std::is_nothrow_default_constructible<value_type>::value;
+    mystl::vector<value_type, allocator_type> tmp(alloc_ref());
+    size_type cur = impl_.size_.load(std::memory_order_acquire);
+    while (cur < n) {
+        if (!in_place) {
+            tmp.clear();
+            for (size_type i = cur; i < n; ++i) {
+                tmp.emplace_back();
+            }
+        }
+        // 与 claim 相同，段分配好之后才发布新的元素个数
+        ensure_segments(cur, n - cur);
+        if (!impl_.size_.compare_exchange_weak(cur, n, std::memory_order_acq_rel))
+            continue;
+        pointer src = tmp.data();
+        for_each_span(cur, n - cur, [&](pointer p, size_type count) {
+            for (size_type i = 0; i < count; ++i) {
+                if (in_place) {
+                    alloc_traits::construct(alloc_ref(), p + i);
+                } else {
+                    alloc_traits::construct(alloc_ref(), p + i, mystl::move(*src++));
+                }
+            }
+        });
+        return iterator(this, cur);
+    }
+    return iterator(this, n);
+}
+
+template <typename T, typename Alloc>
+void concurrent_vector<T, Alloc>::clear() noexcept {
+    const size_type n = impl_.size_.load(std::memory_order_relaxed);
+    for (size_type k = 0; k < segment_count && segment_base(k) < n; ++k) {
+        const size_type count =
+            n - segment_base(k) < segment_size(k) ? n - segment_base(k) : segment_size(k);
+        pointer seg = impl_.segments_[k].load(std::memory_order_relaxed);
+        for (size_type i = 0; i < count; ++i) {
+            alloc_traits::destroy(alloc_ref(), seg + i);
+        }
+    }
+    impl_.size_.store(0, std::memory_order_relaxed);
+    shrink_to_fit();
+}
+
+template <typename T, typename Alloc>
+void concurrent_vector<T, Alloc>::shrink_to_fit() noexcept {
+    const size_type n = impl_.size_.load(std::memory_order_relaxed);
+    // 第 0 段总是保留，避免反复追加、清空时反复申请
+    const size_type keep = n == 0 ? 1 : segment_index(n - 1) + 1;
+    for (size_type k = keep; k < segment_count; ++k) {
+        pointer seg = impl_.segments_[k].exchange(nullptr, std::memory_order_relaxed);
+        if (seg != nullptr)
+            alloc_traits::deallocate(alloc_ref(), seg, segment_size(k));
+    }
+}
+
+// 与另一个 concurrent_vector 交换，propagate_on_container_swap 为 false 时要求两者的分配器相等
+template <typename T, typename Alloc>
+void concurrent_vector<T, Alloc>::swap(concurrent_vector& rhs) noexcept {
+    if (this != &rhs) {
+        if (alloc_traits::propagate_on_container_swap::value) {
+            mystl::swap(alloc_ref(), rhs.alloc_ref());
+        } else {
+            MYSTL_DEBUG(alloc_ref() == rhs.alloc_ref());
+        }
+        swap_data(rhs);
+    }
+}
+
+/*****************************************************************************************/
+// helper function
+
+template <typename T, typename Alloc>
+typename concurrent_vector<T, Alloc>::pointer concurrent_vector<T, Alloc>::segment_at(
+    size_type k) {
+    pointer seg = impl_.segments_[k].load(std::memory_order_acquire);
+    if (seg != nullptr)
+        return seg;
+    pointer fresh = alloc_traits::allocate(alloc_ref(), segment_size(k));
+    if (impl_.segments_[k].compare_exchange_strong(
+            seg, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+        return fresh;
+    // 其他线程已经安装了这一段
+    alloc_traits::deallocate(alloc_ref(), fresh, segment_size(k));
+    return seg;
+}
+
+// 先分配段再发布 size_，段分配抛出异常时 size_ 中不会多出没有构造元素的下标。
+// 段只增不减，CAS 失败后只需要为新的区间补上缺少的段
+template <typename T, typename Alloc>
+typename concurrent_vector<T, Alloc>::size_type concurrent_vector<T, Alloc>::claim(size_type n) {
+    size_type start = impl_.size_.load(std::memory_order_acquire);
+    do {
+        THROW_LENGTH_ERROR_IF(n > max_size() - start, "concurrent_vector<T>'s size too big");
+        ensure_segments(start, n);
+    } while (!impl_.size_.compare_exchange_weak(start, start + n, std::memory_order_acq_rel));
+    return start;
+}
+
+template <typename T, typename Alloc>
+void concurrent_vector<T, Alloc>::ensure_segments(size_type start, size_type n) {
+    if (n == 0)
+        return;
+    const size_type last = segment_index(start + n - 1);
+    for (size_type k = segment_index(start); k <= last; ++k) {
+        segment_at(k);
+    }
+}
+
+template <typename T, typename Alloc>
+template <typename Fn>
+void concurrent_vector<T, Alloc>::for_each_span(size_type start, size_type n, Fn fn) {
+    while (n != 0) {
+        const size_type k = segment_index(start);
+        const size_type offset = start - segment_base(k);
+        const size_type room = segment_size(k) - offset;
+        const size_type count = n < room ? n : room;
+        fn(impl_.segments_[k].load(std::memory_order_acquire) + offset, count);
+        start += count;
+        n -= count;
+    }
+}
+
+template <typename T, typename Alloc>
+template <typename Iter>
+typename concurrent_vector<T, Alloc>::iterator concurrent_vector<T, Alloc>::grow_by_range(
+    Iter first, Iter last, input_iterator_tag) {
+    mystl::vector<value_type, allocator_type> tmp(alloc_ref());
+    for (; first != last; ++first) {
+        tmp.emplace_back(*first);
+    }
+    return grow_by_moving(tmp);
+}
+
+template <typename T, typename Alloc>
+template <typename Iter>
+typename concurrent_vector<T, Alloc>::iterator concurrent_vector<T, Alloc>::grow_by_range(
+    Iter first, Iter last, forward_iterator_tag) {
+    using ref = typename iterator_traits<Iter>::reference;
+    if (!std::is_nothrow_constructible<value_type, ref>::value) {
+        mystl::vector<value_type, allocator_type> tmp(first, last, alloc_ref());
+        return grow_by_moving(tmp);
+    }
+    const auto n = static_cast<size_type>(mystl::distance(first, last));
+    const size_type start = claim(n);
+    for_each_span(start, n, [&](pointer p, size_type count) {
+        for (size_type i = 0; i < count; ++i, ++first) {
+            alloc_traits::construct(alloc_ref(), p + i, *first);
+        }
+    });
+    return iterator(this, start);
+}
+
+template <typename T, typename Alloc>
+typename concurrent_vector<T, Alloc>::iterator concurrent_vector<T, Alloc>::grow_by_moving(
+    mystl::vector<value_type, allocator_type>& tmp) {
+    const size_type start = claim(tmp.size());
+    pointer src = tmp.data();
+    for_each_span(start, tmp.size(), [&](pointer p, size_type count) {
+        for (size_type i = 0; i < count; ++i) {
+            alloc_traits::construct(alloc_ref(), p + i, mystl::move(*src++));
+        }
+    });
+    return iterator(this, start);
+}
+
+template <typename T, typename Alloc>
+void concurrent_vector<T, Alloc>::release_all() noexcept {
+    clear();
+    pointer seg = impl_.segments_[0].exchange(nullptr, std::memory_order_relaxed);
+    if (seg != nullptr)
+        alloc_traits::deallocate(alloc_ref(), seg, segment_size(0));
+}
+
+template <typename T, typename Alloc>
+void concurrent_vector<T, Alloc>::swap_data(concurrent_vector& rhs) noexcept {
+    for (size_type k = 0; k < segment_count; ++k) {
+        pointer seg = impl_.segments_[k].load(std::memory_order_relaxed);
+        impl_.segments_[k].store(
+            rhs.impl_.segments_[k].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        rhs.impl_.segments_[k].store(seg, std::memory_order_relaxed);
+    }
+    const size_type n = impl_.size_.load(std::memory_order_relaxed);
+    impl_.size_.store(rhs.impl_.size_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    rhs.impl_.size_.store(n, std::memory_order_relaxed);
+}
+
+// 重载比较操作符，不能与追加操作同时进行
+template <typename T, typename Alloc>
+bool operator==(const concurrent_vector<T, Alloc>& lhs, const concurrent_vector<T, Alloc>& rhs) {
+    return lhs.size() == rhs.size() && mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, typename Alloc>
+bool operator!=(const concurrent_vector<T, Alloc>& lhs, const concurrent_vector<T, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+// 重载 mystl 的 swap
+template <typename T, typename Alloc>
+void swap(concurrent_vector<T, Alloc>& lhs, concurrent_vector<T, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+namespace pmr {
+
+// 使用 polymorphic_allocator 的 concurrent_vector
+template <typename T>
+using concurrent_vector = mystl::concurrent_vector<T, polymorphic_allocator<T>>;
+
+} // namespace pmr
+
+} // namespace mystl
@@ -4,6 +4,7 @@
 // construct : 负责对象的构造
 // destroy   : 负责对象的析构
 
+#include <memory>
 #include <new>
 
 #include "iterator.h"
@@ -12,50 +13,62 @@
 
 namespace mystl {
 
-// 构造对象
+// 构造对象，C++20 起使用可以在常量求值中调用的 std::construct_at
 template <typename T>
-void construct(T* ptr) {
+MYSTL_CONSTEXPR20 void construct(T* ptr) {
+#ifdef MYSTL_HAS_CONSTEXPR20
+    std::construct_at(ptr);
+#else
     ::new (static_cast<void*>(ptr)) T();
+#endif
 }
 
 template <typename T1, typename T2>
-void construct(T1* ptr, const T2& value) {
+MYSTL_CONSTEXPR20 void construct(T1* ptr, const T2& value) {
+#ifdef MYSTL_HAS_CONSTEXPR20
+    std::construct_at(ptr, value);
+#else
     ::new (static_cast<void*>(ptr)) T1(value);
+#endif
 }
 
 template <typename T1, typename... Args>
-void construct(T1* ptr, Args&&... args) {
+MYSTL_CONSTEXPR20 void construct(T1* ptr, Args&&... args) {
+#ifdef MYSTL_HAS_CONSTEXPR20
+    std::construct_at(ptr, mystl::forward<Args>(args)...);
+#else
     ::new (static_cast<void*>(ptr)) T1(mystl::forward<Args>(args)...);
+#endif
 }
 
 // 析构对象
 template <typename T>
-void destroy_one(T*, std::true_type) {}
+MYSTL_CONSTEXPR20 void destroy_one(T*, std::true_type) {}
 
 template <typename T>
-void destroy_one(T* pointer, std::false_type) {
+MYSTL_CONSTEXPR20 void destroy_one(T* pointer, std::false_type) {
     if (pointer != nullptr) {
         pointer->~T();
     }
 }
 
 template <typename T>
-void destroy(T* pointer) {
+MYSTL_CONSTEXPR20 void destroy(T* pointer) {
     destroy_one(pointer, std::is_trivially_destructible<T>{});
 }
 
 template <typename ForwardIter>
-void destroy_cat(ForwardIter, ForwardIter, m_true_type) {}
+MYSTL_CONSTEXPR20 void destroy_cat(ForwardIter, ForwardIter, std::true_type) {}
 
 template <typename ForwardIter>
-void destroy_cat(ForwardIter first, ForwardIter last, m_false_type) {
+MYSTL_CONSTEXPR20 void destroy_cat(ForwardIter first, ForwardIter last, std::false_type) {
     for (; first != last; ++first) {
         destroy(&(*first));
     }
 }
 
 template <typename ForwardIter>
-void destroy(ForwardIter first, ForwardIter last) {
+MYSTL_CONSTEXPR20 void destroy(ForwardIter first, ForwardIter last) {
     destroy_cat(first, last,
         std::is_trivially_destructible<
             typename iterator_traits<ForwardIter>::value_type>{});
@@ -0,0 +1,1388 @@
+#pragma once
+
+// 这个头文件包含一个模板类 deque
+// deque : 双端队列，元素存放在固定大小的块中，由一个中控数组 (map) 记录各个块的地址。
+// 两端的插入和删除都是 O(1)，不会移动已有的元素；迭代器是随机访问迭代器。
+//
+// 两端弹出后空出来的块不会立即还给分配器，而是挂在容器自己的空闲链表上，
+// 之后需要新块时优先从链表中取，FIFO 式的使用 (push_back + pop_front) 在稳定后不再分配内存。
+// 缓存的块只在 shrink_to_fit() 或容器析构时释放，数量不超过容器历史上同时使用的块数
+
+#include <cstring>
+#include <initializer_list>
+
+#include "exceptdef.h"
+#include "iterator.h"
+#include "memory.h"
+#include "memory_resource.h"
+#include "util.h"
+
+namespace mystl {
+
+#ifdef max
+#pragma message("#undefing marco max")
+#undef max
+#endif // max
+
+#ifdef min
+#pragma message("#undefing marco min")
+#undef min
+#endif // min
+
+enum { EDequeBlockBytes = 4096 }; // 每个块的目标字节数
+enum { EDequeMinBlockSize = 16 }; // 每个块至少容纳的元素个数
+enum { EDequeMapInitSize = 8 };   // map 的初始大小
+
+// 每个块容纳的元素个数
+template <typename T>
+struct deque_buf_size {
+    static constexpr size_t bytes = EDequeBlockBytes;
+    static constexpr size_t min_size = EDequeMinBlockSize;
+    static constexpr size_t value = sizeof(T) < bytes / min_size ? bytes / sizeof(T) : min_size;
+};
+
+/*****************************************************************************************/
+// deque_iterator
+// cur 指向当前元素，[first, last) 为当前所在的块，node 指向 map 中记录该块的位置
+/*****************************************************************************************/
+template <typename T, typename Ref, typename Ptr>
+struct deque_iterator : public iterator<random_access_iterator_tag, T> {
+    // clang-format off
+    using iterator          = deque_iterator<T, T&, T*>;
+    using const_iterator    = deque_iterator<T, const T&, const T*>;
+    using self              = deque_iterator;
+
+    using value_type        = T;
+    using pointer           = Ptr;
+    using reference         = Ref;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+    using value_pointer     = T*;
+    using map_pointer       = T**;
+    // clang-format on
+
+    static constexpr size_type buffer_size = deque_buf_size<T>::value;
+
+    value_pointer cur;
+    value_pointer first;
+    value_pointer last;
+    map_pointer node;
+
+    deque_iterator() noexcept
+        : cur(nullptr)
+        , first(nullptr)
+        , last(nullptr)
+        , node(nullptr) {}
+
+    deque_iterator(value_pointer v, map_pointer n) noexcept
+        : cur(v)
+        , first(*n)
+        , last(*n + buffer_size)
+        , node(n) {}
+
+    deque_iterator(const iterator& rhs) noexcept
+        : cur(rhs.cur)
+        , first(rhs.first)
+        , last(rhs.last)
+        , node(rhs.node) {}
+
+    self& operator=(const iterator& rhs) noexcept {
+        cur = rhs.cur;
+        first = rhs.first;
+        last = rhs.last;
+        node = rhs.node;
+        return *this;
+    }
+
+    // 转到另一个块
+    void set_node(map_pointer new_node) noexcept {
+        node = new_node;
+        first = *new_node;
+        last = first + buffer_size;
+    }
+
+    reference operator*() const noexcept {
+        return *cur;
+    }
+
+    pointer operator->() const noexcept {
+        return cur;
+    }
+
+    // 空迭代器的 node 都为空，按这种写法两者的距离为 0
+    difference_type operator-(const self& x) const noexcept {
+        return static_cast<difference_type>(buffer_size) * (node - x.node) + (cur - first) -
+               (x.cur - x.first);
+    }
+
+    self& operator++() noexcept {
+        ++cur;
+        if (cur == last) {
+            set_node(node + 1);
+            cur = first;
+        }
+        return *this;
+    }
+
+    self operator++(int) noexcept {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    self& operator--() noexcept {
+        if (cur == first) {
+            set_node(node - 1);
+            cur = last;
+        }
+        --cur;
+        return *this;
+    }
+
+    self operator--(int) noexcept {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    self& operator+=(difference_type n) noexcept {
+        const auto offset = n + (cur - first);
+        if (offset >= 0 && offset < static_cast<difference_type>(buffer_size)) {
+            cur += n;
+        } else {
+            const auto node_offset =
+                offset > 0 ? offset / static_cast<difference_type>(buffer_size)
+                           : -static_cast<difference_type>((-offset - 1) / buffer_size) - 1;
+            set_node(node + node_offset);
+            cur = first +
+                  (offset - node_offset * static_cast<difference_type>(buffer_size));
+        }
+        return *this;
+    }
+
+    self operator+(difference_type n) const noexcept {
+        self tmp = *this;
+        return tmp += n;
+    }
+
+    self& operator-=(difference_type n) noexcept {
+        return *this += -n;
+    }
+
+    self operator-(difference_type n) const noexcept {
+        self tmp = *this;
+        return tmp -= n;
+    }
+
+    reference operator[](difference_type n) const noexcept {
+        return *(*this + n);
+    }
+
+    bool operator==(const self& rhs) const noexcept {
+        return cur == rhs.cur;
+    }
+    bool operator<(const self& rhs) const noexcept {
+        return node == rhs.node ? (cur < rhs.cur) : (node < rhs.node);
+    }
+    bool operator!=(const self& rhs) const noexcept {
+        return !(*this == rhs);
+    }
+    bool operator>(const self& rhs) const noexcept {
+        return rhs < *this;
+    }
+    bool operator<=(const self& rhs) const noexcept {
+        return !(rhs < *this);
+    }
+    bool operator>=(const self& rhs) const noexcept {
+        return !(*this < rhs);
+    }
+};
+
+template <typename T, typename Ref, typename Ptr>
+deque_iterator<T, Ref, Ptr> operator+(
+    ptrdiff_t n, const deque_iterator<T, Ref, Ptr>& it) noexcept {
+    return it + n;
+}
+
+/*****************************************************************************************/
+// deque
+// 默认构造不申请空间，第一次插入时再建立 map。
+// 建立 map 之后 end_ 总是指向一个已分配的块中的位置，[begin_.node, end_.node] 上的块都已分配
+/*****************************************************************************************/
+template <typename T, typename Alloc = mystl::allocator<T>>
+class deque {
+    static_assert(std::is_same<T, typename Alloc::value_type>::value,
+        "Alloc::value_type must be the same as T");
+
+public:
+    // clang-format off
+    using allocator_type            = Alloc;
+    using alloc_traits              = mystl::allocator_traits<allocator_type>;
+    using map_allocator_type        = typename alloc_traits::template rebind_alloc<T*>;
+    using map_traits                = mystl::allocator_traits<map_allocator_type>;
+
+    using value_type                = T;
+    using pointer                   = typename alloc_traits::pointer;
+    using const_pointer             = typename alloc_traits::const_pointer;
+    using reference                 = value_type&;
+    using const_reference           = const value_type&;
+    using size_type                 = typename alloc_traits::size_type;
+    using difference_type           = typename alloc_traits::difference_type;
+
+    using iterator                  = deque_iterator<T, T&, T*>;
+    using const_iterator            = deque_iterator<T, const T&, const T*>;
+    using reverse_iterator          = mystl::reverse_iterator<iterator>;
+    using const_reverse_iterator    = mystl::reverse_iterator<const_iterator>;
+    using map_pointer               = T**;
+    // clang-format on
+
+    static constexpr size_type buffer_size = deque_buf_size<T>::value;
+
+    allocator_type get_allocator() const {
+        return alloc_ref();
+    }
+
+private:
+    // 分配器作为基类保存，无状态的分配器借助空基类优化不占用额外空间
+    struct deque_impl : public allocator_type {
+        map_pointer map_;     // 中控数组
+        size_type map_size_;  // map 的大小
+        iterator begin_;      // 第一个元素
+        iterator end_;        // 最后一个元素的下一个位置
+        pointer free_blocks_; // 缓存的空闲块组成的单链表，链接指针存放在块的开头
+
+        deque_impl() noexcept(std::is_nothrow_default_constructible<allocator_type>::value)
+            : allocator_type()
+            , map_(nullptr)
+            , map_size_(0)
+            , free_blocks_(nullptr) {}
+
+        explicit deque_impl(const allocator_type& a) noexcept
+            : allocator_type(a)
+            , map_(nullptr)
+            , map_size_(0)
+            , free_blocks_(nullptr) {}
+
+        explicit deque_impl(allocator_type&& a) noexcept
+            : allocator_type(mystl::move(a))
+            , map_(nullptr)
+            , map_size_(0)
+            , free_blocks_(nullptr) {}
+    };
+
+    deque_impl impl_;
+
+public:
+    deque() noexcept(std::is_nothrow_default_constructible<allocator_type>::value)
+        : impl_() {}
+
+    explicit deque(const allocator_type& a) noexcept
+        : impl_(a) {}
+
+    explicit deque(size_type n, const allocator_type& a = allocator_type())
+        : impl_(a) {
+        fill_init(n, value_type());
+    }
+
+    deque(size_type n, const value_type& value, const allocator_type& a = allocator_type())
+        : impl_(a) {
+        fill_init(n, value);
+    }
+
+    template <typename Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type = 0>
+    deque(Iter first, Iter last, const allocator_type& a = allocator_type())
+        : impl_(a) {
+        range_init(first, last, iterator_category(first));
+    }
+
+    deque(std::initializer_list<value_type> ilist,
+        const allocator_type& a = allocator_type())
+        : impl_(a) {
+        range_init(ilist.begin(), ilist.end(), mystl::forward_iterator_tag{});
+    }
+
+    deque(const deque& rhs)
+        : impl_(alloc_traits::select_on_container_copy_construction(rhs.alloc_ref())) {
+        range_init(rhs.begin(), rhs.end(), mystl::forward_iterator_tag{});
+    }
+
+    deque(const deque& rhs, const allocator_type& a)
+        : impl_(a) {
+        range_init(rhs.begin(), rhs.end(), mystl::forward_iterator_tag{});
+    }
+
+    deque(deque&& rhs) noexcept
+        : impl_(mystl::move(rhs.alloc_ref())) {
+        swap_data(rhs);
+    }
+
+    // 分配器不同时不能直接接管 rhs 的空间，只能逐个移动元素
+    deque(deque&& rhs, const allocator_type& a)
+        : impl_(a) {
+        if (alloc_ref() == rhs.alloc_ref()) {
+            swap_data(rhs);
+        } else if (!rhs.empty()) {
+            create_map_and_blocks(rhs.size());
+            try {
+                mystl::uninitialized_move(rhs.begin(), rhs.end(), impl_.begin_);
+            } catch (...) {
+                impl_.end_ = impl_.begin_;
+                release_all();
+                throw;
+            }
+        }
+    }
+
+    deque& operator=(const deque& rhs);
+    deque& operator=(deque&& rhs) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value);
+
+    deque& operator=(std::initializer_list<value_type> ilist) {
+        copy_assign(ilist.begin(), ilist.end(), mystl::forward_iterator_tag{});
+        return *this;
+    }
+
+    ~deque() {
+        release_all();
+    }
+
+public:
+    // 迭代器相关操作
+    iterator begin() noexcept {
+        return impl_.begin_;
+    }
+    const_iterator begin() const noexcept {
+        return impl_.begin_;
+    }
+    iterator end() noexcept {
+        return impl_.end_;
+    }
+    const_iterator end() const noexcept {
+        return impl_.end_;
+    }
+
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+    const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+    const_reverse_iterator crend() const noexcept {
+        return rend();
+    }
+
+    // 容量相关操作
+    bool empty() const noexcept {
+        return impl_.begin_ == impl_.end_;
+    }
+
+    size_type size() const noexcept {
+        return static_cast<size_type>(impl_.end_ - impl_.begin_);
+    }
+
+    size_type max_size() const noexcept {
+        return alloc_traits::max_size(alloc_ref());
+    }
+
+    void resize(size_type new_size) {
+        resize(new_size, value_type());
+    }
+
+    void resize(size_type new_size, const value_type& value);
+
+    // 释放缓存的空闲块
+    void shrink_to_fit() noexcept {
+        release_free_blocks();
+    }
+
+    // 访问元素相关操作
+    reference operator[](size_type n) {
+        MYSTL_DEBUG(n < size());
+        return impl_.begin_[static_cast<difference_type>(n)];
+    }
+
+    const_reference operator[](size_type n) const {
+        MYSTL_DEBUG(n < size());
+        return impl_.begin_[static_cast<difference_type>(n)];
+    }
+
+    reference at(size_type n) {
+        THROW_OUT_OF_RANGE_IF(!(n < size()), "deque<T>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(!(n < size()), "deque<T>::at() subscript out of range");
+        return (*this)[n];
+    }
+
+    reference front() {
+        MYSTL_DEBUG(!empty());
+        return *impl_.begin_.cur;
+    }
+
+    const_reference front() const {
+        MYSTL_DEBUG(!empty());
+        return *impl_.begin_.cur;
+    }
+
+    reference back() {
+        MYSTL_DEBUG(!empty());
+        return *(impl_.end_ - 1);
+    }
+
+    const_reference back() const {
+        MYSTL_DEBUG(!empty());
+        return *(impl_.end_ - 1);
+    }
+
+    // 修改容器相关操作
+
+    // assign
+    void assign(size_type n, const value_type& value) {
+        fill_assign(n, value);
+    }
+
+    template <typename Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type = 0>
+    void assign(Iter first, Iter last) {
+        copy_assign(first, last, iterator_category(first));
+    }
+
+    void assign(std::initializer_list<value_type> ilist) {
+        copy_assign(ilist.begin(), ilist.end(), mystl::forward_iterator_tag{});
+    }
+
+    // emplace_front / emplace_back / emplace
+    template <typename... Args>
+    reference emplace_front(Args&&... args);
+
+    template <typename... Args>
+    reference emplace_back(Args&&... args);
+
+    template <typename... Args>
+    iterator emplace(const_iterator pos, Args&&... args);
+
+    // push_front / push_back
+    void push_front(const value_type& value) {
+        emplace_front(value);
+    }
+
+    void push_front(value_type&& value) {
+        emplace_front(mystl::move(value));
+    }
+
+    void push_back(const value_type& value) {
+        emplace_back(value);
+    }
+
+    void push_back(value_type&& value) {
+        emplace_back(mystl::move(value));
+    }
+
+    // pop_front / pop_back
+    void pop_front();
+    void pop_back();
+
+    // insert
+    iterator insert(const_iterator pos, const value_type& value) {
+        return emplace(pos, value);
+    }
+
+    iterator insert(const_iterator pos, value_type&& value) {
+        return emplace(pos, mystl::move(value));
+    }
+
+    iterator insert(const_iterator pos, size_type n, const value_type& value);
+
+    template <typename Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type = 0>
+    iterator insert(const_iterator pos, Iter first, Iter last) {
+        return copy_insert(to_mutable(pos), first, last, iterator_category(first));
+    }
+
+    iterator insert(const_iterator pos, std::initializer_list<value_type> ilist) {
+        return copy_insert(
+            to_mutable(pos), ilist.begin(), ilist.end(), mystl::forward_iterator_tag{});
+    }
+
+    // erase / clear
+    iterator erase(const_iterator pos);
+    iterator erase(const_iterator first, const_iterator last);
+
+    // 只保留一个块，其余的块放入缓存
+    void clear() noexcept;
+
+    // swap
+    void swap(deque& rhs) noexcept;
+
+private:
+    // helper functions
+
+    allocator_type& alloc_ref() noexcept {
+        return impl_;
+    }
+
+    const allocator_type& alloc_ref() const noexcept {
+        return impl_;
+    }
+
+    iterator to_mutable(const_iterator pos) const noexcept {
+        iterator it;
+        it.cur = const_cast<pointer>(pos.cur);
+        it.first = pos.first;
+        it.last = pos.last;
+        it.node = pos.node;
+        return it;
+    }
+
+    // 块和 map 的分配与释放
+    pointer allocate_block();
+    void deallocate_block(pointer block) noexcept;
+    void release_free_blocks() noexcept;
+
+    map_pointer allocate_map(size_type n);
+    void deallocate_map(map_pointer map, size_type n) noexcept;
+
+    // 为 [nstart, nfinish] 上的每个位置分配块，失败时释放已分配的块
+    void create_blocks(map_pointer nstart, map_pointer nfinish);
+    void destroy_blocks(map_pointer nstart, map_pointer nfinish) noexcept;
+
+    // 建立可以容纳 n 个元素的 map 和块，元素尚未构造
+    void create_map_and_blocks(size_type n);
+
+    // 析构所有元素，释放所有块和 map
+    void release_all() noexcept;
+
+    // initialize
+    void fill_init(size_type n, const value_type& value);
+
+    template <typename Iter>
+    void range_init(Iter first, Iter last, input_iterator_tag);
+
+    template <typename Iter>
+    void range_init(Iter first, Iter last, forward_iterator_tag);
+
+    // 保证 map 在尾部 / 头部至少还有 nodes_to_add 个空位，必要时在 map 内部居中或换一个更大的 map
+    void reserve_map_at_back(size_type nodes_to_add);
+    void reserve_map_at_front(size_type nodes_to_add);
+    void reallocate_map(size_type nodes_to_add, bool add_at_front);
+
+    // 保证尾部 / 头部可以再放下 n 个元素，返回新的尾部 / 头部，元素尚未构造
+    iterator reserve_elements_at_back(size_type n);
+    iterator reserve_elements_at_front(size_type n);
+
+    // assign
+    void fill_assign(size_type n, const value_type& value);
+
+    template <typename Iter>
+    void copy_assign(Iter first, Iter last, input_iterator_tag);
+
+    template <typename Iter>
+    void copy_assign(Iter first, Iter last, forward_iterator_tag);
+
+    // 只交换数据，不交换分配器
+    void swap_data(deque& rhs) noexcept;
+
+    // insert
+    template <typename... Args>
+    iterator insert_aux(iterator pos, Args&&... args);
+
+    void fill_insert_aux(iterator pos, size_type n, const value_type& value);
+
+    template <typename Iter>
+    iterator copy_insert(iterator pos, Iter first, Iter last, input_iterator_tag);
+
+    template <typename Iter>
+    iterator copy_insert(iterator pos, Iter first, Iter last, forward_iterator_tag);
+
+    template <typename FIter>
+    void copy_insert_aux(iterator pos, FIter first, FIter last, size_type n);
+};
+
+/*****************************************************************************************/
+
+// 复制赋值运算符
+template <typename T, typename Alloc>
+deque<T, Alloc>& deque<T, Alloc>::operator=(const deque& rhs) {
+    if (this != &rhs) {
+        if (alloc_traits::propagate_on_container_copy_assignment::value &&
+            alloc_ref() != rhs.alloc_ref()) {
+            // 旧的空间必须由旧的分配器释放
+            release_all();
+        }
+        if (alloc_traits::propagate_on_container_copy_assignment::value)
+            alloc_ref() = rhs.alloc_ref();
+        copy_assign(rhs.begin(), rhs.end(), mystl::forward_iterator_tag{});
+    }
+    return *this;
+}
+
+// 移动赋值运算符，分配器可以传播或者相等时直接接管 rhs 的空间，否则逐个移动元素
+template <typename T, typename Alloc>
+deque<T, Alloc>& deque<T, Alloc>::operator=(deque&& rhs) noexcept(
+    alloc_traits::propagate_on_container_move_assignment::value ||
+    alloc_traits::is_always_equal::value) {
+    if (this == &rhs)
+        return *this;
+    if (alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value || alloc_ref() == rhs.alloc_ref()) {
+        release_all();
+        if (alloc_traits::propagate_on_container_move_assignment::value)
+            alloc_ref() = mystl::move(rhs.alloc_ref());
+        swap_data(rhs);
+    } else {
+        deque tmp(mystl::move(rhs), alloc_ref());
+        release_all();
+        swap_data(tmp);
+    }
+    return *this;
+}
+
+// 重置容器大小
+template <typename T, typename Alloc>
+void deque<T, Alloc>::resize(size_type new_size, const value_type& value) {
+    const auto len = size();
+    if (new_size < len) {
+        erase(impl_.begin_ + new_size, impl_.end_);
+    } else {
+        insert(impl_.end_, new_size - len, value);
+    }
+}
+
+// 在头部就地构建元素
+template <typename T, typename Alloc>
+template <typename... Args>
+typename deque<T, Alloc>::reference deque<T, Alloc>::emplace_front(Args&&... args) {
+    if (impl_.begin_.cur != impl_.begin_.first) {
+        alloc_traits::construct(
+            alloc_ref(), impl_.begin_.cur - 1, mystl::forward<Args>(args)...);
+        --impl_.begin_.cur;
+    } else {
+        auto new_begin = reserve_elements_at_front(1);
+        try {
+            alloc_traits::construct(
+                alloc_ref(), new_begin.cur, mystl::forward<Args>(args)...);
+        } catch (...) {
+            destroy_blocks(new_begin.node, impl_.begin_.node - 1);
+            throw;
+        }
+        impl_.begin_ = new_begin;
+    }
+    return *impl_.begin_.cur;
+}
+
+// 在尾部就地构建元素，块中只剩最后一个位置时先准备好下一个块，保证 end_ 总是指向已分配的块
+template <typename T, typename Alloc>
+template <typename... Args>
+typename deque<T, Alloc>::reference deque<T, Alloc>::emplace_back(Args&&... args) {
+    if (impl_.end_.last - impl_.end_.cur > 1) {
+        alloc_traits::construct(alloc_ref(), impl_.end_.cur, mystl::forward<Args>(args)...);
+        ++impl_.end_.cur;
+    } else {
+        auto new_end = reserve_elements_at_back(1);
+        try {
+            alloc_traits::construct(
+                alloc_ref(), impl_.end_.cur, mystl::forward<Args>(args)...);
+        } catch (...) {
+            destroy_blocks(impl_.end_.node + 1, new_end.node);
+            throw;
+        }
+        impl_.end_ = new_end;
+    }
+    return *(impl_.end_ - 1);
+}
+
+// 在 pos 位置就地构建元素
+template <typename T, typename Alloc>
+template <typename... Args>
+typename deque<T, Alloc>::iterator deque<T, Alloc>::emplace(
+    const_iterator pos, Args&&... args) {
+    if (pos.cur == impl_.begin_.cur) {
+        emplace_front(mystl::forward<Args>(args)...);
+        return impl_.begin_;
+    }
+    if (pos.cur == impl_.end_.cur) {
+        emplace_back(mystl::forward<Args>(args)...);
+        return impl_.end_ - 1;
+    }
+    return insert_aux(to_mutable(pos), mystl::forward<Args>(args)...);
+}
+
+// 弹出头部元素，块用完时放入缓存
+template <typename T, typename Alloc>
+void deque<T, Alloc>::pop_front() {
+    MYSTL_DEBUG(!empty());
+    alloc_traits::destroy(alloc_ref(), impl_.begin_.cur);
+    if (impl_.begin_.cur != impl_.begin_.last - 1) {
+        ++impl_.begin_.cur;
+    } else {
+        deallocate_block(impl_.begin_.first);
+        impl_.begin_.set_node(impl_.begin_.node + 1);
+        impl_.begin_.cur = impl_.begin_.first;
+    }
+}
+
+// 弹出尾部元素，end_ 离开一个块时把该块放入缓存
+template <typename T, typename Alloc>
+void deque<T, Alloc>::pop_back() {
+    MYSTL_DEBUG(!empty());
+    if (impl_.end_.cur != impl_.end_.first) {
+        --impl_.end_.cur;
+    } else {
+        deallocate_block(impl_.end_.first);
+        impl_.end_.set_node(impl_.end_.node - 1);
+        impl_.end_.cur = impl_.end_.last - 1;
+    }
+    alloc_traits::destroy(alloc_ref(), impl_.end_.cur);
+}
+
+// 在 pos 处插入 n 个元素
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::iterator deque<T, Alloc>::insert(
+    const_iterator pos, size_type n, const value_type& value) {
+    const difference_type elems_before = pos - cbegin();
+    if (n == 0)
+        return impl_.begin_ + elems_before;
+    if (pos.cur == impl_.begin_.cur) {
+        const value_type value_copy = value; // value 可能是容器中的元素
+        auto new_begin = reserve_elements_at_front(n);
+        try {
+            mystl::uninitialized_fill(new_begin, impl_.begin_, value_copy);
+        } catch (...) {
+            destroy_blocks(new_begin.node, impl_.begin_.node - 1);
+            throw;
+        }
+        impl_.begin_ = new_begin;
+    } else if (pos.cur == impl_.end_.cur) {
+        const value_type value_copy = value;
+        auto new_end = reserve_elements_at_back(n);
+        try {
+            mystl::uninitialized_fill(impl_.end_, new_end, value_copy);
+        } catch (...) {
+            destroy_blocks(impl_.end_.node + 1, new_end.node);
+            throw;
+        }
+        impl_.end_ = new_end;
+    } else {
+        fill_insert_aux(to_mutable(pos), n, value);
+    }
+    return impl_.begin_ + elems_before;
+}
+
+// 删除 pos 处的元素，移动较少的一侧
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::iterator deque<T, Alloc>::erase(const_iterator pos) {
+    MYSTL_DEBUG(pos >= cbegin() && pos < cend());
+    auto xpos = to_mutable(pos);
+    auto next = xpos;
+    ++next;
+    const size_type elems_before = xpos - impl_.begin_;
+    if (elems_before < (size() >> 1)) {
+        mystl::move_backward(impl_.begin_, xpos, next);
+        pop_front();
+    } else {
+        mystl::move(next, impl_.end_, xpos);
+        pop_back();
+    }
+    return impl_.begin_ + elems_before;
+}
+
+// 删除 [first, last) 上的元素，移动较少的一侧
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::iterator deque<T, Alloc>::erase(
+    const_iterator first, const_iterator last) {
+    MYSTL_DEBUG(first >= cbegin() && last <= cend() && !(last < first));
+    if (first == last)
+        return to_mutable(first);
+    if (first.cur == impl_.begin_.cur && last.cur == impl_.end_.cur) {
+        clear();
+        return impl_.end_;
+    }
+    const size_type len = last - first;
+    const size_type elems_before = first - cbegin();
+    if (elems_before < ((size() - len) >> 1)) {
+        mystl::move_backward(impl_.begin_, to_mutable(first), to_mutable(last));
+        auto new_begin = impl_.begin_ + len;
+        mystl::destroy(impl_.begin_, new_begin);
+        destroy_blocks(impl_.begin_.node, new_begin.node - 1);
+        impl_.begin_ = new_begin;
+    } else {
+        mystl::move(to_mutable(last), impl_.end_, to_mutable(first));
+        auto new_end = impl_.end_ - len;
+        mystl::destroy(new_end, impl_.end_);
+        destroy_blocks(new_end.node + 1, impl_.end_.node);
+        impl_.end_ = new_end;
+    }
+    return impl_.begin_ + elems_before;
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::clear() noexcept {
+    if (impl_.map_ == nullptr)
+        return;
+    mystl::destroy(impl_.begin_, impl_.end_);
+    destroy_blocks(impl_.begin_.node + 1, impl_.end_.node);
+    impl_.end_ = impl_.begin_;
+}
+
+// 与另一个 deque 交换，propagate_on_container_swap 为 false 时要求两者的分配器相等
+template <typename T, typename Alloc>
+void deque<T, Alloc>::swap(deque& rhs) noexcept {
+    if (this != &rhs) {
+        if (alloc_traits::propagate_on_container_swap::value) {
+            mystl::swap(alloc_ref(), rhs.alloc_ref());
+        } else {
+            MYSTL_DEBUG(alloc_ref() == rhs.alloc_ref());
+        }
+        swap_data(rhs);
+    }
+}
+
+/*****************************************************************************************/
+// helper function
+
+// 优先使用缓存的空闲块
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::pointer deque<T, Alloc>::allocate_block() {
+    if (impl_.free_blocks_ != nullptr) {
+        pointer block = impl_.free_blocks_;
+        std::memcpy(static_cast<void*>(&impl_.free_blocks_),
+            static_cast<const void*>(block), sizeof(pointer));
+        return block;
+    }
+    return alloc_traits::allocate(alloc_ref(), buffer_size);
+}
+
+// 块的大小至少为 EDequeMinBlockSize 个元素，放得下一个指针；块不一定按指针对齐，所以用 memcpy
+template <typename T, typename Alloc>
+void deque<T, Alloc>::deallocate_block(pointer block) noexcept {
+    std::memcpy(static_cast<void*>(block), static_cast<const void*>(&impl_.free_blocks_),
+        sizeof(pointer));
+    impl_.free_blocks_ = block;
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::release_free_blocks() noexcept {
+    while (impl_.free_blocks_ != nullptr) {
+        pointer block = impl_.free_blocks_;
+        std::memcpy(static_cast<void*>(&impl_.free_blocks_),
+            static_cast<const void*>(block), sizeof(pointer));
+        alloc_traits::deallocate(alloc_ref(), block, buffer_size);
+    }
+}
+
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::map_pointer deque<T, Alloc>::allocate_map(size_type n) {
+    map_allocator_type map_alloc(alloc_ref());
+    map_pointer map = map_traits::allocate(map_alloc, n);
+    for (size_type i = 0; i < n; ++i) {
+        map[i] = nullptr;
+    }
+    return map;
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::deallocate_map(map_pointer map, size_type n) noexcept {
+    map_allocator_type map_alloc(alloc_ref());
+    map_traits::deallocate(map_alloc, map, n);
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::create_blocks(map_pointer nstart, map_pointer nfinish) {
+    map_pointer cur = nstart;
+    try {
+        for (; cur <= nfinish; ++cur) {
+            *cur = allocate_block();
+        }
+    } catch (...) {
+        destroy_blocks(nstart, cur - 1);
+        throw;
+    }
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::destroy_blocks(map_pointer nstart, map_pointer nfinish) noexcept {
+    for (map_pointer n = nstart; n <= nfinish; ++n) {
+        deallocate_block(*n);
+        *n = nullptr;
+    }
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::create_map_and_blocks(size_type n) {
+    const size_type num_nodes = n / buffer_size + 1;
+    const size_type map_size = mystl::max(
+        static_cast<size_type>(EDequeMapInitSize), num_nodes + 2);
+    map_pointer map = allocate_map(map_size);
+    map_pointer nstart = map + (map_size - num_nodes) / 2;
+    map_pointer nfinish = nstart + num_nodes - 1;
+    try {
+        create_blocks(nstart, nfinish);
+    } catch (...) {
+        deallocate_map(map, map_size);
+        throw;
+    }
+    impl_.map_ = map;
+    impl_.map_size_ = map_size;
+    impl_.begin_.set_node(nstart);
+    impl_.end_.set_node(nfinish);
+    impl_.begin_.cur = impl_.begin_.first;
+    impl_.end_.cur = impl_.end_.first + (n % buffer_size);
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::release_all() noexcept {
+    if (impl_.map_ != nullptr) {
+        mystl::destroy(impl_.begin_, impl_.end_);
+        destroy_blocks(impl_.begin_.node, impl_.end_.node);
+        deallocate_map(impl_.map_, impl_.map_size_);
+        impl_.map_ = nullptr;
+        impl_.map_size_ = 0;
+        impl_.begin_ = iterator();
+        impl_.end_ = iterator();
+    }
+    release_free_blocks();
+}
+
+// fill_init 函数
+template <typename T, typename Alloc>
+void deque<T, Alloc>::fill_init(size_type n, const value_type& value) {
+    if (n == 0)
+        return;
+    create_map_and_blocks(n);
+    try {
+        mystl::uninitialized_fill(impl_.begin_, impl_.end_, value);
+    } catch (...) {
+        impl_.end_ = impl_.begin_;
+        release_all();
+        throw;
+    }
+}
+
+// range_init 函数
+template <typename T, typename Alloc>
+template <typename Iter>
+void deque<T, Alloc>::range_init(Iter first, Iter last, input_iterator_tag) {
+    try {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    } catch (...) {
+        release_all();
+        throw;
+    }
+}
+
+template <typename T, typename Alloc>
+template <typename Iter>
+void deque<T, Alloc>::range_init(Iter first, Iter last, forward_iterator_tag) {
+    const size_type n = mystl::distance(first, last);
+    if (n == 0)
+        return;
+    create_map_and_blocks(n);
+    try {
+        mystl::uninitialized_copy(first, last, impl_.begin_);
+    } catch (...) {
+        impl_.end_ = impl_.begin_;
+        release_all();
+        throw;
+    }
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::reserve_map_at_back(size_type nodes_to_add) {
+    if (nodes_to_add + 1 > impl_.map_size_ - (impl_.end_.node - impl_.map_))
+        reallocate_map(nodes_to_add, false);
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::reserve_map_at_front(size_type nodes_to_add) {
+    if (nodes_to_add > static_cast<size_type>(impl_.begin_.node - impl_.map_))
+        reallocate_map(nodes_to_add, true);
+}
+
+// map 还有一半以上的空位时把已用的部分移到中间，否则换一个至少两倍大的 map
+template <typename T, typename Alloc>
+void deque<T, Alloc>::reallocate_map(size_type nodes_to_add, bool add_at_front) {
+    const size_type old_num_nodes = impl_.end_.node - impl_.begin_.node + 1;
+    const size_type new_num_nodes = old_num_nodes + nodes_to_add;
+    map_pointer new_nstart;
+    if (impl_.map_size_ > 2 * new_num_nodes) {
+        new_nstart = impl_.map_ + (impl_.map_size_ - new_num_nodes) / 2 +
+                     (add_at_front ? nodes_to_add : 0);
+        std::memmove(static_cast<void*>(new_nstart),
+            static_cast<const void*>(impl_.begin_.node), old_num_nodes * sizeof(pointer));
+        // 移动后原来的位置可能有残留，map 中不使用的位置统一为空
+        if (new_nstart < impl_.begin_.node) {
+            for (auto p = new_nstart + old_num_nodes; p <= impl_.end_.node; ++p)
+                *p = nullptr;
+        } else {
+            for (auto p = impl_.begin_.node; p < new_nstart; ++p)
+                *p = nullptr;
+        }
+    } else {
+        const size_type new_map_size =
+            impl_.map_size_ + mystl::max(impl_.map_size_, nodes_to_add) + 2;
+        map_pointer new_map = allocate_map(new_map_size);
+        new_nstart = new_map + (new_map_size - new_num_nodes) / 2 +
+                     (add_at_front ? nodes_to_add : 0);
+        std::memcpy(static_cast<void*>(new_nstart),
+            static_cast<const void*>(impl_.begin_.node), old_num_nodes * sizeof(pointer));
+        deallocate_map(impl_.map_, impl_.map_size_);
+        impl_.map_ = new_map;
+        impl_.map_size_ = new_map_size;
+    }
+    impl_.begin_.set_node(new_nstart);
+    impl_.end_.set_node(new_nstart + old_num_nodes - 1);
+}
+
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::iterator deque<T, Alloc>::reserve_elements_at_back(size_type n) {
+    if (impl_.map_ == nullptr)
+        create_map_and_blocks(0);
+    const size_type vacancies = impl_.end_.last - impl_.end_.cur - 1;
+    if (n > vacancies) {
+        THROW_LENGTH_ERROR_IF(n > max_size() - size(), "deque<T>'s size too big");
+        const size_type new_nodes = (n - vacancies + buffer_size - 1) / buffer_size;
+        reserve_map_at_back(new_nodes);
+        create_blocks(impl_.end_.node + 1, impl_.end_.node + new_nodes);
+    }
+    return impl_.end_ + static_cast<difference_type>(n);
+}
+
+template <typename T, typename Alloc>
+typename deque<T, Alloc>::iterator deque<T, Alloc>::reserve_elements_at_front(size_type n) {
+    if (impl_.map_ == nullptr)
+        create_map_and_blocks(0);
+    const size_type vacancies = impl_.begin_.cur - impl_.begin_.first;
+    if (n > vacancies) {
+        THROW_LENGTH_ERROR_IF(n > max_size() - size(), "deque<T>'s size too big");
+        const size_type new_nodes = (n - vacancies + buffer_size - 1) / buffer_size;
+        reserve_map_at_front(new_nodes);
+        create_blocks(impl_.begin_.node - new_nodes, impl_.begin_.node - 1);
+    }
+    return impl_.begin_ - static_cast<difference_type>(n);
+}
+
+// fill_assign 函数
+template <typename T, typename Alloc>
+void deque<T, Alloc>::fill_assign(size_type n, const value_type& value) {
+    const auto len = size();
+    if (n > len) {
+        mystl::fill(impl_.begin_, impl_.end_, value);
+        insert(impl_.end_, n - len, value);
+    } else {
+        erase(impl_.begin_ + n, impl_.end_);
+        mystl::fill(impl_.begin_, impl_.end_, value);
+    }
+}
+
+// copy_assign 函数
+template <typename T, typename Alloc>
+template <typename Iter>
+void deque<T, Alloc>::copy_assign(Iter first, Iter last, input_iterator_tag) {
+    auto cur = impl_.begin_;
+    for (; first != last && cur != impl_.end_; ++first, ++cur) {
+        *cur = *first;
+    }
+    if (first == last) {
+        erase(cur, impl_.end_);
+    } else {
+        copy_insert(impl_.end_, first, last, input_iterator_tag{});
+    }
+}
+
+template <typename T, typename Alloc>
+template <typename Iter>
+void deque<T, Alloc>::copy_assign(Iter first, Iter last, forward_iterator_tag) {
+    const size_type len1 = size();
+    const size_type len2 = mystl::distance(first, last);
+    if (len1 < len2) {
+        auto next = first;
+        mystl::advance(next, len1);
+        mystl::copy(first, next, impl_.begin_);
+        copy_insert(impl_.end_, next, last, forward_iterator_tag{});
+    } else {
+        erase(mystl::copy(first, last, impl_.begin_), impl_.end_);
+    }
+}
+
+template <typename T, typename Alloc>
+void deque<T, Alloc>::swap_data(deque& rhs) noexcept {
+    mystl::swap(impl_.map_, rhs.impl_.map_);
+    mystl::swap(impl_.map_size_, rhs.impl_.map_size_);
+    mystl::swap(impl_.begin_, rhs.impl_.begin_);
+    mystl::swap(impl_.end_, rhs.impl_.end_);
+    mystl::swap(impl_.free_blocks_, rhs.impl_.free_blocks_);
+}
+
+// 在中间插入一个元素：把较短的一侧向外移动一个位置，再把新元素移入空出的位置
+template <typename T, typename Alloc>
+template <typename... Args>
+typename deque<T, Alloc>::iterator deque<T, Alloc>::insert_aux(
+    iterator pos, Args&&... args) {
+    const difference_type elems_before = pos - impl_.begin_;
+    value_type value_copy(mystl::forward<Args>(args)...); // args 可能引用容器中的元素
+    if (static_cast<size_type>(elems_before) < (size() >> 1)) {
+        emplace_front(mystl::move(front()));
+        auto front1 = impl_.begin_ + 1;
+        auto front2 = front1 + 1;
+        pos = impl_.begin_ + elems_before;
+        mystl::move(front2, pos + 1, front1);
+    } else {
+        emplace_back(mystl::move(back()));
+        auto back1 = impl_.end_ - 1;
+        auto back2 = back1 - 1;
+        pos = impl_.begin_ + elems_before;
+        mystl::move_backward(pos, back2, back1);
+    }
+    *pos = mystl::move(value_copy);
+    return pos;
+}
+
+// 在中间插入 n 个元素，把较短的一侧向外移动 n 个位置
+template <typename T, typename Alloc>
+void deque<T, Alloc>::fill_insert_aux(iterator pos, size_type n, const value_type& value) {
+    const size_type elems_before = pos - impl_.begin_;
+    const size_type len = size();
+    const value_type value_copy = value;
+    if (elems_before < (len >> 1)) {
+        auto new_begin = reserve_elements_at_front(n); // 可能重新分配 map
+        auto old_begin = impl_.begin_;
+        pos = impl_.begin_ + elems_before;
+        try {
+            if (elems_before >= n) {
+                auto begin_n = impl_.begin_ + n;
+                mystl::uninitialized_move(impl_.begin_, begin_n, new_begin);
+                impl_.begin_ = new_begin;
+                mystl::move(begin_n, pos, old_begin);
+                mystl::fill(pos - n, pos, value_copy);
+            } else {
+                auto mid = mystl::uninitialized_move(impl_.begin_, pos, new_begin);
+                try {
+                    mystl::uninitialized_fill(mid, impl_.begin_, value_copy);
+                } catch (...) {
+                    mystl::destroy(new_begin, mid);
+                    throw;
+                }
+                impl_.begin_ = new_begin;
+                mystl::fill(old_begin, pos, value_copy);
+            }
+        } catch (...) {
+            if (impl_.begin_ != new_begin)
+                destroy_blocks(new_begin.node, impl_.begin_.node - 1);
+            throw;
+        }
+    } else {
+        auto new_end = reserve_elements_at_back(n);
+        auto old_end = impl_.end_;
+        const size_type elems_after = len - elems_before;
+        pos = impl_.end_ - elems_after;
+        try {
+            if (elems_after > n) {
+                auto end_n = impl_.end_ - n;
+                mystl::uninitialized_move(end_n, impl_.end_, impl_.end_);
+                impl_.end_ = new_end;
+                mystl::move_backward(pos, end_n, old_end);
+                mystl::fill(pos, pos + n, value_copy);
+            } else {
+                auto mid = pos + n;
+                mystl::uninitialized_fill(impl_.end_, mid, value_copy);
+                try {
+                    mystl::uninitialized_move(pos, impl_.end_, mid);
+                } catch (...) {
+                    mystl::destroy(impl_.end_, mid);
+                    throw;
+                }
+                impl_.end_ = new_end;
+                mystl::fill(pos, old_end, value_copy);
+            }
+        } catch (...) {
+            if (impl_.end_ != new_end)
+                destroy_blocks(impl_.end_.node + 1, new_end.node);
+            throw;
+        }
+    }
+}
+
+// 元素个数未知：追加到尾部时逐个 emplace_back，否则先收集到临时的 deque 再一次插入
+template <typename T, typename Alloc>
+template <typename Iter>
+typename deque<T, Alloc>::iterator deque<T, Alloc>::copy_insert(
+    iterator pos, Iter first, Iter last, input_iterator_tag) {
+    const difference_type elems_before = pos - impl_.begin_;
+    if (pos.cur == impl_.end_.cur) {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+        return impl_.begin_ + elems_before;
+    }
+    deque tmp(first, last, alloc_ref());
+    return copy_insert(pos, tmp.begin(), tmp.end(), forward_iterator_tag{});
+}
+
+template <typename T, typename Alloc>
+template <typename Iter>
+typename deque<T, Alloc>::iterator deque<T, Alloc>::copy_insert(
+    iterator pos, Iter first, Iter last, forward_iterator_tag) {
+    const difference_type elems_before = pos - impl_.begin_;
+    const size_type n = mystl::distance(first, last);
+    if (n == 0)
+        return pos;
+    if (pos.cur == impl_.begin_.cur) {
+        auto new_begin = reserve_elements_at_front(n);
+        try {
+            mystl::uninitialized_copy(first, last, new_begin);
+        } catch (...) {
+            destroy_blocks(new_begin.node, impl_.begin_.node - 1);
+            throw;
+        }
+        impl_.begin_ = new_begin;
+    } else if (pos.cur == impl_.end_.cur) {
+        auto new_end = reserve_elements_at_back(n);
+        try {
+            mystl::uninitialized_copy(first, last, impl_.end_);
+        } catch (...) {
+            destroy_blocks(impl_.end_.node + 1, new_end.node);
+            throw;
+        }
+        impl_.end_ = new_end;
+    } else {
+        copy_insert_aux(pos, first, last, n);
+    }
+    return impl_.begin_ + elems_before;
+}
+
+// 与 fill_insert_aux 相同，新元素来自 [first, last)
+template <typename T, typename Alloc>
+template <typename FIter>
+void deque<T, Alloc>::copy_insert_aux(iterator pos, FIter first, FIter last, size_type n) {
+    const size_type elems_before = pos - impl_.begin_;
+    const size_type len = size();
+    if (elems_before < (len >> 1)) {
+        auto new_begin = reserve_elements_at_front(n); // 可能重新分配 map
+        auto old_begin = impl_.begin_;
+        pos = impl_.begin_ + elems_before;
+        try {
+            if (elems_before >= n) {
+                auto begin_n = impl_.begin_ + n;
+                mystl::uninitialized_move(impl_.begin_, begin_n, new_begin);
+                impl_.begin_ = new_begin;
+                mystl::move(begin_n, pos, old_begin);
+                mystl::copy(first, last, pos - n);
+            } else {
+                auto mid = first;
+                mystl::advance(mid, n - elems_before);
+                auto built = mystl::uninitialized_move(impl_.begin_, pos, new_begin);
+                try {
+                    mystl::uninitialized_copy(first, mid, built);
+                } catch (...) {
+                    mystl::destroy(new_begin, built);
+                    throw;
+                }
+                impl_.begin_ = new_begin;
+                mystl::copy(mid, last, old_begin);
+            }
+        } catch (...) {
+            if (impl_.begin_ != new_begin)
+                destroy_blocks(new_begin.node, impl_.begin_.node - 1);
+            throw;
+        }
+    } else {
+        auto new_end = reserve_elements_at_back(n);
+        auto old_end = impl_.end_;
+        const size_type elems_after = len - elems_before;
+        pos = impl_.end_ - elems_after;
+        try {
+            if (elems_after > n) {
+                auto end_n = impl_.end_ - n;
+                mystl::uninitialized_move(end_n, impl_.end_, impl_.end_);
+                impl_.end_ = new_end;
+                mystl::move_backward(pos, end_n, old_end);
+                mystl::copy(first, last, pos);
+            } else {
+                auto mid = first;
+                mystl::advance(mid, elems_after);
+                auto built = mystl::uninitialized_copy(mid, last, impl_.end_);
+                try {
+                    mystl::uninitialized_move(pos, impl_.end_, built);
+                } catch (...) {
+                    mystl::destroy(impl_.end_, built);
+                    throw;
+                }
+                impl_.end_ = new_end;
+                mystl::copy(first, mid, pos);
+            }
+        } catch (...) {
+            if (impl_.end_ != new_end)
+                destroy_blocks(impl_.end_.node + 1, new_end.node);
+            throw;
+        }
+    }
+}
+
+// 重载比较操作符
+template <typename T, typename Alloc>
+bool operator==(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+    return lhs.size() == rhs.size() && mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, typename Alloc>
+bool operator<(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+    return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+template <typename T, typename Alloc>
+bool operator!=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T, typename Alloc>
+bool operator>(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+    return rhs < lhs;
+}
+
+template <typename T, typename Alloc>
+bool operator<=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+    return !(rhs < lhs);
+}
+
+template <typename T, typename Alloc>
+bool operator>=(const deque<T, Alloc>& lhs, const deque<T, Alloc>& rhs) {
+    return !(lhs < rhs);
+}
+
+// 重载 mystl 的 swap
+template <typename T, typename Alloc>
+void swap(deque<T, Alloc>& lhs, deque<T, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+namespace pmr {
+
+// 使用 polymorphic_allocator 的 deque，不同内存资源上的 deque 属于同一类型
+template <typename T>
+using deque = mystl::deque<T, polymorphic_allocator<T>>;
+
+} // namespace pmr
+
+} // namespace mystl
@@ -0,0 +1,338 @@
+#pragma once
+
+// 这个头文件包含执行策略以及并行算法使用的线程池
+//
+// seq       : 在调用线程上顺序执行
+// par       : 把区间分段，交给线程池并行执行
+// par_unseq : 与 par 相同
+//
+// 区间的总字节数低于阈值时并行版本也在调用线程上执行，阈值默认为 MYSTL_PARALLEL_CUTOFF，
+// 可以用 set_parallel_cutoff 在运行时调整。线程数默认为硬件线程数，可以在编译时用
+// MYSTL_PARALLEL_THREADS 指定。调用线程在等待期间自己也执行分段，
+// 因此在线程池的工作线程中调用并行算法不会死锁。
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+#ifndef MYSTL_PARALLEL_CUTOFF
+#define MYSTL_PARALLEL_CUTOFF (static_cast<size_t>(1) << 20)
+#endif
+
+namespace mystl {
+namespace execution {
+
+/*****************************************************************************************/
+// 执行策略
+/*****************************************************************************************/
+struct sequenced_policy {};
+struct parallel_policy {};
+struct parallel_unsequenced_policy {};
+
+constexpr sequenced_policy seq{};
+constexpr parallel_policy par{};
+constexpr parallel_unsequenced_policy par_unseq{};
+
+template <class T>
+struct is_execution_policy : std::false_type {};
+
+template <>
+struct is_execution_policy<sequenced_policy> : std::true_type {};
+
+template <>
+struct is_execution_policy<parallel_policy> : std::true_type {};
+
+template <>
+struct is_execution_policy<parallel_unsequenced_policy> : std::true_type {};
+
+// 策略是否允许并行执行
+template <class T>
+struct is_parallel_policy
+    : std::integral_constant<bool, std::is_same<T, parallel_policy>::value ||
+                                       std::is_same<T, parallel_unsequenced_policy>::value> {};
+
+// 用于带执行策略的重载，ExecutionPolicy 是执行策略时类型为 T
+template <class ExecutionPolicy, class T>
+using enable_if_execution_policy = typename std::enable_if<
+    is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value, T>::type;
+
+/*****************************************************************************************/
+// 并行阈值
+/*****************************************************************************************/
+enum { EParallelGrainBytes = 262144 }; // 每一段至少处理的字节数
+enum { ECacheLineBytes = 64 };         // 段的边界按缓存行对齐，避免相邻两段写同一行
+
+inline std::atomic<size_t>& parallel_cutoff_holder() noexcept {
+    static std::atomic<size_t> cutoff(MYSTL_PARALLEL_CUTOFF);
+    return cutoff;
+}
+
+inline size_t get_parallel_cutoff() noexcept {
+    return parallel_cutoff_holder().load(std::memory_order_relaxed);
+}
+
+// 设置并行阈值，返回原来的阈值
+inline size_t set_parallel_cutoff(size_t bytes) noexcept {
+    return parallel_cutoff_holder().exchange(bytes, std::memory_order_relaxed);
+}
+
+/*****************************************************************************************/
+// thread_pool
+// 固定数目的工作线程，任务是一个可以被多个线程同时执行的并行作业，
+// 每个线程从作业中领取下一个分段，直到分段领完
+/*****************************************************************************************/
+class thread_pool {
+private:
+    struct job_base {
+        std::atomic<size_t> next;   // 下一个待领取的分段
+        std::atomic<size_t> done;   // 已完成的分段数
+        size_t count;               // 分段总数
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::exception_ptr error;   // 第一个抛出的异常
+
+        explicit job_base(size_t n) noexcept
+            : next(0)
+            , done(0)
+            , count(n) {}
+
+        virtual ~job_base() = default;
+        virtual void run(size_t i) = 0;
+
+        void work();
+        void wait();
+    };
+
+    template <class Fn>
+    struct job : public job_base {
+        Fn fn;
+
+        job(size_t n, Fn& f)
+            : job_base(n)
+            , fn(f) {}
+
+        void run(size_t i) override {
+            fn(i);
+        }
+    };
+
+    struct task_node {
+        std::shared_ptr<job_base> job;
+        task_node* next;
+    };
+
+public:
+    // 进程内共享的线程池，工作线程数为线程数减一，调用线程补足剩下的一个
+    static thread_pool& instance();
+
+    explicit thread_pool(size_t workers);
+    ~thread_pool();
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    // 能同时执行的线程数，包括调用线程
+    size_t concurrency() const noexcept {
+        return workers_ + 1;
+    }
+
+    // 对 [0, count) 中的每个 i 执行 fn(i)，全部完成后返回
+    // 某个 fn(i) 抛出异常时其余分段照常执行，最后重新抛出第一个异常
+    template <class Fn>
+    void parallel_for(size_t count, Fn fn);
+
+private:
+    void M_submit(const std::shared_ptr<job_base>& j, size_t copies);
+    void M_loop();
+
+    size_t workers_;
+    std::unique_ptr<std::thread[]> threads_;
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    task_node* head_;
+    task_node* tail_;
+    bool stop_;
+};
+
+inline thread_pool& thread_pool::instance() {
+    // 故意不析构，避免进程退出时还有线程在使用线程池
+    static thread_pool* pool = [] {
+#ifdef MYSTL_PARALLEL_THREADS
+        const size_t n = MYSTL_PARALLEL_THREADS;
+#else
+        const size_t n = std::thread::hardware_concurrency();
+#endif
+        return new thread_pool(n > 1 ? n - 1 : 0);
+    }();
+    return *pool;
+}
+
+inline thread_pool::thread_pool(size_t workers)
+    : workers_(0)
+    , threads_(new std::thread[workers])
+    , head_(nullptr)
+    , tail_(nullptr)
+    , stop_(false) {
+    try {
+        for (; workers_ < workers; ++workers_) {
+            threads_[workers_] = std::thread([this] { M_loop(); });
+        }
+    } catch (...) {
+        // 创建线程失败时只使用已经创建的线程
+    }
+}
+
+inline thread_pool::~thread_pool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    ready_.notify_all();
+    for (size_t i = 0; i < workers_; ++i) {
+        threads_[i].join();
+    }
+    while (head_ != nullptr) {
+        task_node* next = head_->next;
+        delete head_;
+        head_ = next;
+    }
+}
+
+template <class Fn>
+void thread_pool::parallel_for(size_t count, Fn fn) {
+    if (count == 0)
+        return;
+    if (count == 1 || workers_ == 0) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+    std::shared_ptr<job_base> j = std::make_shared<job<Fn>>(count, fn);
+    try {
+        M_submit(j, (count - 1 < workers_ ? count - 1 : workers_));
+    } catch (...) {
+        // 提交失败时由调用线程完成剩下的分段
+    }
+    j->work();
+    j->wait();
+    if (j->error)
+        std::rethrow_exception(j->error);
+}
+
+inline void thread_pool::M_submit(const std::shared_ptr<job_base>& j, size_t copies) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < copies; ++i) {
+            task_node* node = new task_node{j, nullptr};
+            if (tail_ == nullptr) {
+                head_ = tail_ = node;
+            } else {
+                tail_->next = node;
+                tail_ = node;
+            }
+        }
+    }
+    if (copies == 1) {
+        ready_.notify_one();
+    } else {
+        ready_.notify_all();
+    }
+}
+
+inline void thread_pool::M_loop() {
+    for (;;) {
+        task_node* node = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            ready_.wait(lock, [this] { return stop_ || head_ != nullptr; });
+            if (head_ == nullptr)
+                return;
+            node = head_;
+            head_ = node->next;
+            if (head_ == nullptr)
+                tail_ = nullptr;
+        }
+        node->job->work();
+        delete node;
+    }
+}
+
+inline void thread_pool::job_base::work() {
+    for (;;) {
+        const size_t i = next.fetch_add(1, std::memory_order_relaxed);
+        if (i >= count)
+            return;
+        try {
+            run(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error)
+                error = std::current_exception();
+        }
+        if (done.fetch_add(1, std::memory_order_acq_rel) + 1 == count) {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.notify_all();
+        }
+    }
+}
+
+inline void thread_pool::job_base::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this] { return done.load(std::memory_order_acquire) == count; });
+}
+
+/*****************************************************************************************/
+// range_split
+// 把 n 个元素分成 count 段，第 i 段为 [begin(i), end(i))，count 为 1 时应当顺序执行
+/*****************************************************************************************/
+struct range_split {
+    size_t n;     // 元素个数
+    size_t per;   // 每段的元素个数
+    size_t count; // 段数
+
+    size_t begin(size_t i) const noexcept {
+        return i * per;
+    }
+
+    size_t end(size_t i) const noexcept {
+        return i + 1 == count ? n : (i + 1) * per;
+    }
+};
+
+// 按元素大小、并行阈值和线程数决定如何分段
+inline range_split split_range(size_t n, size_t elem_size) {
+    range_split split = {n, n, 1};
+    const size_t bytes = n * elem_size;
+    if (elem_size == 0 || bytes / elem_size != n || bytes < get_parallel_cutoff())
+        return split;
+    const size_t threads = thread_pool::instance().concurrency();
+    const size_t grain = static_cast<size_t>(EParallelGrainBytes);
+    size_t count = bytes / grain < threads ? bytes / grain : threads;
+    if (count < 2)
+        return split;
+    // 每段的元素个数上调为整缓存行
+    const size_t line = elem_size < static_cast<size_t>(ECacheLineBytes)
+                            ? static_cast<size_t>(ECacheLineBytes) / elem_size
+                            : 1;
+    size_t per = (n + count - 1) / count;
+    per = (per + line - 1) / line * line;
+    split.per = per;
+    split.count = (n + per - 1) / per;
+    return split;
+}
+
+// 按 split 的分段并行执行 fn(first, last)
+template <class Fn>
+void parallel_ranges(const range_split& split, Fn fn) {
+    thread_pool::instance().parallel_for(
+        split.count, [&split, &fn](size_t i) { fn(split.begin(i), split.end(i)); });
+}
+
+} // namespace execution
+} // namespace mystl
@@ -0,0 +1,186 @@
+#pragma once
+
+// 这个头文件包含一个模板类 flat_hash_map
+// flat_hash_map : 基于开放寻址哈希表 flat_hashtable 的映射，元素为 mystl::pair<const Key, T>，
+// 直接存放在连续的槽位数组中，查找时按组比较控制字节，不需要沿着链表逐个访问节点。
+//
+// 与 std::unordered_map 的不同之处：
+// - 插入时扩容会移动元素，所有迭代器、指针和引用都会失效；删除不会移动其他元素
+// - 哈希函数和比较函数都定义了 is_transparent 时，查找类的函数可以直接使用其他类型的键
+// - 没有桶的接口，bucket_count() 返回槽位数，最大负载因子固定为 7/8
+
+#include <cstring>
+#include <functional>
+#include <tuple>
+
+#include "flat_hashtable.h"
+#include "memory_resource.h"
+
+namespace mystl {
+
+// 元素的键为 first；移动元素时从即将析构的旧元素中移出键，避免复制
+template <typename Key, typename T>
+struct flat_map_policy {
+    // clang-format off
+    using key_type      = Key;
+    using mapped_type   = T;
+    using value_type    = mystl::pair<const Key, T>;
+    // clang-format on
+
+    static constexpr bool constant_iterator = false;
+
+    static const Key& key(const value_type& value) noexcept {
+        return value.first;
+    }
+
+    template <typename Alloc>
+    static void transfer(Alloc& a, value_type* dst, value_type* src) {
+        if (is_trivially_relocatable<value_type>::value) {
+            std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src),
+                sizeof(value_type));
+            return;
+        }
+        mystl::allocator_traits<Alloc>::construct(a, dst,
+            mystl::move(const_cast<Key&>(src->first)), mystl::move(src->second));
+        mystl::allocator_traits<Alloc>::destroy(a, src);
+    }
+};
+
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+    typename KeyEqual = std::equal_to<Key>,
+    typename Alloc = mystl::allocator<mystl::pair<const Key, T>>>
+class flat_hash_map : public flat_hashtable<flat_map_policy<Key, T>, Hash, KeyEqual, Alloc> {
+    using base = flat_hashtable<flat_map_policy<Key, T>, Hash, KeyEqual, Alloc>;
+
+    template <typename K>
+    using key_arg = typename key_arg_helper<is_transparent<Hash>::value &&
+                                            is_transparent<KeyEqual>::value>::template type<K,
+        Key>;
+
+public:
+    // clang-format off
+    using mapped_type       = T;
+    using key_type          = typename base::key_type;
+    using value_type        = typename base::value_type;
+    using size_type         = typename base::size_type;
+    using iterator          = typename base::iterator;
+    using const_iterator    = typename base::const_iterator;
+    // clang-format on
+
+    using base::base;
+    using base::operator=;
+    using base::insert;
+
+    flat_hash_map() = default;
+
+    // 可以转换为 value_type 的参数，如 mystl::make_pair(k, v)
+    template <typename P,
+        typename std::enable_if<std::is_constructible<value_type, P&&>::value &&
+                                    !std::is_same<typename std::decay<P>::type,
+                                        value_type>::value,
+            int>::type = 0>
+    pair<iterator, bool> insert(P&& value) {
+        return this->emplace(mystl::forward<P>(value));
+    }
+
+    // try_emplace，键不存在时才用 args 构造映射值，键存在时 args 不会被移动
+    template <typename... Args>
+    pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+        return try_emplace_impl(key, mystl::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+        return try_emplace_impl(mystl::move(key), mystl::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    iterator try_emplace(const_iterator, const key_type& key, Args&&... args) {
+        return try_emplace(key, mystl::forward<Args>(args)...).first;
+    }
+
+    template <typename... Args>
+    iterator try_emplace(const_iterator, key_type&& key, Args&&... args) {
+        return try_emplace(mystl::move(key), mystl::forward<Args>(args)...).first;
+    }
+
+    // insert_or_assign，键存在时把 obj 赋给映射值
+    template <typename M>
+    pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj) {
+        return insert_or_assign_impl(key, mystl::forward<M>(obj));
+    }
+
+    template <typename M>
+    pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj) {
+        return insert_or_assign_impl(mystl::move(key), mystl::forward<M>(obj));
+    }
+
+    // 访问元素相关操作
+    mapped_type& operator[](const key_type& key) {
+        return try_emplace(key).first->second;
+    }
+
+    mapped_type& operator[](key_type&& key) {
+        return try_emplace(mystl::move(key)).first->second;
+    }
+
+    template <typename K = key_type>
+    mapped_type& at(const key_arg<K>& key) {
+        auto it = this->find(key);
+        THROW_OUT_OF_RANGE_IF(it == this->end(), "flat_hash_map<Key, T>::at() key not found");
+        return it->second;
+    }
+
+    template <typename K = key_type>
+    const mapped_type& at(const key_arg<K>& key) const {
+        auto it = this->find(key);
+        THROW_OUT_OF_RANGE_IF(it == this->end(), "flat_hash_map<Key, T>::at() key not found");
+        return it->second;
+    }
+
+    void swap(flat_hash_map& rhs) noexcept {
+        base::swap(rhs);
+    }
+
+private:
+    template <typename K, typename... Args>
+    pair<iterator, bool> try_emplace_impl(K&& key, Args&&... args) {
+        const auto r = this->find_or_prepare_insert(key);
+        if (r.second) {
+            this->construct_at_slot(r.first, std::piecewise_construct,
+                std::forward_as_tuple(mystl::forward<K>(key)),
+                std::forward_as_tuple(mystl::forward<Args>(args)...));
+        }
+        return {this->iterator_at(r.first), r.second};
+    }
+
+    template <typename K, typename M>
+    pair<iterator, bool> insert_or_assign_impl(K&& key, M&& obj) {
+        const auto r = this->find_or_prepare_insert(key);
+        if (r.second) {
+            this->construct_at_slot(r.first, mystl::forward<K>(key), mystl::forward<M>(obj));
+        } else {
+            this->iterator_at(r.first)->second = mystl::forward<M>(obj);
+        }
+        return {this->iterator_at(r.first), r.second};
+    }
+};
+
+// 重载 mystl 的 swap
+template <typename Key, typename T, typename Hash, typename KeyEqual, typename Alloc>
+void swap(flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& lhs,
+    flat_hash_map<Key, T, Hash, KeyEqual, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+namespace pmr {
+
+// 使用 polymorphic_allocator 的 flat_hash_map，不同内存资源上的 flat_hash_map 属于同一类型
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+    typename KeyEqual = std::equal_to<Key>>
+using flat_hash_map = mystl::flat_hash_map<Key, T, Hash, KeyEqual,
+    polymorphic_allocator<mystl::pair<const Key, T>>>;
+
+} // namespace pmr
+
+} // namespace mystl
@@ -0,0 +1,72 @@
+#pragma once
+
+// 这个头文件包含一个模板类 flat_hash_set
+// flat_hash_set : 基于开放寻址哈希表 flat_hashtable 的集合，元素直接存放在连续的槽位数组中。
+// 迭代器只能读取元素；插入时扩容会使所有迭代器失效，删除不会移动其他元素。
+// 哈希函数和比较函数都定义了 is_transparent 时，查找类的函数可以直接使用其他类型的键
+
+#include <cstring>
+#include <functional>
+
+#include "flat_hashtable.h"
+#include "memory_resource.h"
+
+namespace mystl {
+
+template <typename Key>
+struct flat_set_policy {
+    // clang-format off
+    using key_type      = Key;
+    using value_type    = Key;
+    // clang-format on
+
+    static constexpr bool constant_iterator = true;
+
+    static const Key& key(const value_type& value) noexcept {
+        return value;
+    }
+
+    template <typename Alloc>
+    static void transfer(Alloc& a, value_type* dst, value_type* src) {
+        if (is_trivially_relocatable<value_type>::value) {
+            std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src),
+                sizeof(value_type));
+            return;
+        }
+        mystl::allocator_traits<Alloc>::construct(a, dst, mystl::move(*src));
+        mystl::allocator_traits<Alloc>::destroy(a, src);
+    }
+};
+
+template <typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>,
+    typename Alloc = mystl::allocator<Key>>
+class flat_hash_set : public flat_hashtable<flat_set_policy<Key>, Hash, KeyEqual, Alloc> {
+    using base = flat_hashtable<flat_set_policy<Key>, Hash, KeyEqual, Alloc>;
+
+public:
+    using base::base;
+    using base::operator=;
+
+    flat_hash_set() = default;
+
+    void swap(flat_hash_set& rhs) noexcept {
+        base::swap(rhs);
+    }
+};
+
+// 重载 mystl 的 swap
+template <typename Key, typename Hash, typename KeyEqual, typename Alloc>
+void swap(flat_hash_set<Key, Hash, KeyEqual, Alloc>& lhs,
+    flat_hash_set<Key, Hash, KeyEqual, Alloc>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+namespace pmr {
+
+// 使用 polymorphic_allocator 的 flat_hash_set，不同内存资源上的 flat_hash_set 属于同一类型
+template <typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+using flat_hash_set = mystl::flat_hash_set<Key, Hash, KeyEqual, polymorphic_allocator<Key>>;
+
+} // namespace pmr
+
+} // namespace mystl
@@ -0,0 +1,1154 @@
+#pragma once
+
+// 这个头文件包含 flat_hash_map 与 flat_hash_set 共用的开放寻址哈希表 flat_hashtable
+//
+// 元素存放在一段连续的槽位数组中，另有一个同样长度的控制字节数组记录每个槽位的状态：
+//   ECtrlEmpty    : 空槽位
+//   ECtrlDeleted  : 被删除的槽位 (墓碑)
+//   ECtrlSentinel : 位于控制字节数组末尾的哨兵，迭代到这里结束
+//   0 ~ 127       : 已使用的槽位，值为元素哈希值的低 7 位 (h2)
+// 查找时按哈希值的高位 (h1) 确定起点，以一组控制字节为单位探测：先用 SIMD 指令一次比较一组中的
+// 所有控制字节与 h2，只有匹配的槽位才需要比较键；组中出现空槽位即说明键不存在。
+// x86-64 上一组为 16 bytes (SSE2)，其他平台或者定义了 MYSTL_NO_SIMD 时为 8 bytes，按机器字比较。
+//
+// 槽位数 (capacity) 总是 2^k - 1，控制字节数组末尾在哨兵之后复制了开头的 group_width - 1 个字节，
+// 因此从任意位置加载一组都不会越界，也不需要处理回绕。
+// 最大负载因子为 7/8，并且表中总是至少留有一个空槽位，保证探测一定能结束。
+// 元素的移动构造在扩容时不应抛出异常。
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+
+#include "exceptdef.h"
+#include "iterator.h"
+#include "memory.h"
+#include "simd.h"
+#include "util.h"
+
+namespace mystl {
+
+namespace hash_detail {
+
+using ctrl_t = signed char;
+
+// clang-format off
+enum : ctrl_t {
+    ECtrlEmpty      = -128,
+    ECtrlDeleted    = -2,
+    ECtrlSentinel   = -1
+};
+// clang-format on
+
+inline uint32_t countr_zero(uint64_t x) noexcept {
+#if defined(__GNUC__)
+    return x == 0 ? 64u : static_cast<uint32_t>(__builtin_ctzll(x));
+#else
+    uint32_t n = 0;
+    for (; n < 64 && (x & 1) == 0; ++n) {
+        x >>= 1;
+    }
+    return n;
+#endif
+}
+
+inline uint32_t countl_zero(uint64_t x) noexcept {
+#if defined(__GNUC__)
+    return x == 0 ? 64u : static_cast<uint32_t>(__builtin_clzll(x));
+#else
+    uint32_t n = 0;
+    for (; n < 64 && (x & (uint64_t(1) << 63)) == 0; ++n) {
+        x <<= 1;
+    }
+    return n;
+#endif
+}
+
+// 一组控制字节的比较结果，每个控制字节对应 2^Shift 位，其中最高的一位表示是否匹配
+template <typename T, uint32_t Width, uint32_t Shift>
+class bitmask {
+public:
+    explicit bitmask(T mask) noexcept
+        : mask_(mask) {}
+
+    explicit operator bool() const noexcept {
+        return mask_ != 0;
+    }
+
+    // 最低的匹配位置，只能在有匹配时调用
+    uint32_t lowest() const noexcept {
+        return countr_zero(mask_) >> Shift;
+    }
+
+    void clear_lowest() noexcept {
+        mask_ &= mask_ - 1;
+    }
+
+    // 开头 / 末尾连续不匹配的控制字节个数
+    uint32_t trailing_zeros() const noexcept {
+        return mask_ == 0 ? Width : lowest();
+    }
+
+    uint32_t leading_zeros() const noexcept {
+        constexpr uint32_t extra = 64 - (Width << Shift);
+        return (countl_zero(static_cast<uint64_t>(mask_)) - extra) >> Shift;
+    }
+
+private:
+    T mask_;
+};
+
+#ifdef MYSTL_SIMD_X86
+
+// SSE2 版本，一组 16 个控制字节，比较结果为 movemask 得到的 16 位掩码
+struct group_sse2 {
+    static constexpr size_t width = 16;
+    using mask_type = bitmask<uint32_t, 16, 0>;
+
+    explicit group_sse2(const ctrl_t* pos) noexcept
+        : ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+    mask_type match(ctrl_t h2) const noexcept {
+        return mask_type(static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl))));
+    }
+
+    mask_type match_empty() const noexcept {
+        return match(ECtrlEmpty);
+    }
+
+    // 空槽位和墓碑都小于哨兵
+    mask_type match_empty_or_deleted() const noexcept {
+        return mask_type(static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(ECtrlSentinel), ctrl))));
+    }
+
+    // 开头连续的空槽位和墓碑的个数，迭代时用来跳过它们
+    uint32_t count_leading_empty_or_deleted() const noexcept {
+        const auto mask = static_cast<uint32_t>(
+            _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(ECtrlSentinel), ctrl)));
+        return countr_zero(mask + 1);
+    }
+
+    __m128i ctrl;
+};
+
+using group = group_sse2;
+
+#else
+
+// 标量版本，一组 8 个控制字节放在一个 64 位整数中，每个字节的最高位表示是否匹配
+// match 可能把紧跟在匹配字节之后的字节误报为匹配，调用者总要再比较键，所以不影响结果
+struct group_portable {
+    static constexpr size_t width = 8;
+    using mask_type = bitmask<uint64_t, 8, 3>;
+
+    static constexpr uint64_t lsbs = 0x0101010101010101ULL;
+    static constexpr uint64_t msbs = 0x8080808080808080ULL;
+
+    explicit group_portable(const ctrl_t* pos) noexcept {
+        std::memcpy(&ctrl, pos, sizeof(ctrl));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        ctrl = __builtin_bswap64(ctrl);
+#endif
+    }
+
+    mask_type match(ctrl_t h2) const noexcept {
+        const uint64_t x = ctrl ^ (lsbs * static_cast<unsigned char>(h2));
+        return mask_type((x - lsbs) & ~x & msbs);
+    }
+
+    // 空槽位为 0b10000000，是唯一最高位为 1 而第 1 位为 0 的控制字节
+    mask_type match_empty() const noexcept {
+        return mask_type((ctrl & (~ctrl << 6)) & msbs);
+    }
+
+    // 空槽位和墓碑的最高位为 1 而最低位为 0
+    mask_type match_empty_or_deleted() const noexcept {
+        return mask_type((ctrl & (~ctrl << 7)) & msbs);
+    }
+
+    uint32_t count_leading_empty_or_deleted() const noexcept {
+        constexpr uint64_t gaps = 0x00FEFEFEFEFEFEFEULL;
+        return (countr_zero(((~ctrl & (ctrl >> 7)) | gaps) + 1) + 7) >> 3;
+    }
+
+    uint64_t ctrl;
+};
+
+using group = group_portable;
+
+#endif // MYSTL_SIMD_X86
+
+constexpr size_t group_width = group::width;
+
+// 对用户提供的哈希值再做一次混合，std::hash 对整数是恒等映射，直接使用时 h1 和 h2 的分布很差
+inline size_t hash_mix(size_t h) noexcept {
+#if defined(__SIZEOF_INT128__)
+    if (sizeof(size_t) == sizeof(uint64_t)) {
+        // __int128 是 GCC/Clang 的扩展，用 __extension__ 避免 -Wpedantic 警告
+        __extension__ typedef unsigned __int128 uint128_type;
+        const uint128_type m = static_cast<uint128_type>(h) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<size_t>(static_cast<uint64_t>(m) ^
+                                   static_cast<uint64_t>(m >> 64));
+    }
+#endif
+    uint64_t x = static_cast<uint64_t>(h);
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDULL;
+    x ^= x >> 33;
+    return static_cast<size_t>(x);
+}
+
+// 高位决定探测起点，低 7 位存入控制字节
+inline size_t h1(size_t hash) noexcept {
+    return hash >> 7;
+}
+
+inline ctrl_t h2(size_t hash) noexcept {
+    return static_cast<ctrl_t>(hash & 0x7f);
+}
+
+inline bool is_full(ctrl_t c) noexcept {
+    return c >= 0;
+}
+
+// 探测序列，以组为单位按三角数步进：起点、起点 + 1 组、起点 + 3 组 ...
+// 槽位数为 2^k - 1 时这个序列会经过每一组
+class probe_seq {
+public:
+    probe_seq(size_t hash, size_t mask) noexcept
+        : mask_(mask)
+        , offset_(hash & mask)
+        , index_(0) {}
+
+    size_t offset() const noexcept {
+        return offset_;
+    }
+
+    size_t offset(size_t i) const noexcept {
+        return (offset_ + i) & mask_;
+    }
+
+    void next() noexcept {
+        index_ += group_width;
+        offset_ = (offset_ + index_) & mask_;
+    }
+
+private:
+    size_t mask_;
+    size_t offset_;
+    size_t index_;
+};
+
+// 不小于 n 的 2^k - 1，最小为 3
+inline size_t normalize_capacity(size_t n) noexcept {
+    if (n <= 3)
+        return 3;
+    return static_cast<size_t>(~uint64_t(0) >> countl_zero(static_cast<uint64_t>(n)));
+}
+
+// 槽位数为 capacity 时最多可以存放的元素个数，至少留下一个空槽位
+inline size_t capacity_to_growth(size_t capacity) noexcept {
+    return capacity < 8 ? capacity - 1 : capacity - capacity / 8;
+}
+
+// 存放 n 个元素需要的槽位数
+inline size_t growth_to_capacity(size_t n) noexcept {
+    size_t capacity = 3;
+    while (capacity_to_growth(capacity) < n) {
+        capacity = capacity * 2 + 1;
+    }
+    return capacity;
+}
+
+} // namespace hash_detail
+
+/*****************************************************************************************/
+// flat_hash_iterator
+// ctrl 指向当前槽位的控制字节，slot 指向当前槽位；end() 的 ctrl 指向哨兵
+// Policy::constant_iterator 为真时 (flat_hash_set) 两种迭代器都只能读取元素
+/*****************************************************************************************/
+template <typename Policy, bool Const>
+struct flat_hash_iterator
+    : public iterator<forward_iterator_tag, typename Policy::value_type> {
+    // clang-format off
+    using self              = flat_hash_iterator;
+    using ctrl_t            = hash_detail::ctrl_t;
+
+    using value_type        = typename Policy::value_type;
+    using pointer           = typename std::conditional<Const || Policy::constant_iterator,
+                                const value_type*, value_type*>::type;
+    using reference         = typename std::conditional<Const || Policy::constant_iterator,
+                                const value_type&, value_type&>::type;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+    // clang-format on
+
+    ctrl_t* ctrl;
+    value_type* slot;
+
+    flat_hash_iterator() noexcept
+        : ctrl(nullptr)
+        , slot(nullptr) {}
+
+    flat_hash_iterator(ctrl_t* c, value_type* s) noexcept
+        : ctrl(c)
+        , slot(s) {}
+
+    // iterator 可以转换为 const_iterator
+    template <bool C = Const, typename std::enable_if<C, int>::type = 0>
+    flat_hash_iterator(const flat_hash_iterator<Policy, false>& rhs) noexcept
+        : ctrl(rhs.ctrl)
+        , slot(rhs.slot) {}
+
+    reference operator*() const noexcept {
+        return *slot;
+    }
+
+    pointer operator->() const noexcept {
+        return slot;
+    }
+
+    self& operator++() noexcept {
+        ++ctrl;
+        ++slot;
+        skip_empty_or_deleted();
+        return *this;
+    }
+
+    self operator++(int) noexcept {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    // 末尾的哨兵保证这里不会越过控制字节数组
+    void skip_empty_or_deleted() noexcept {
+        while (*ctrl < hash_detail::ECtrlSentinel) {
+            const uint32_t shift = hash_detail::group(ctrl).count_leading_empty_or_deleted();
+            ctrl += shift;
+            slot += shift;
+        }
+    }
+
+    bool operator==(const self& rhs) const noexcept {
+        return ctrl == rhs.ctrl;
+    }
+    bool operator!=(const self& rhs) const noexcept {
+        return ctrl != rhs.ctrl;
+    }
+};
+
+/*****************************************************************************************/
+// flat_hashtable
+// Policy 描述元素的类型：
+//   key_type / value_type           键和元素的类型
+//   constant_iterator               迭代器是否只读
+//   key(value)                      取出元素的键
+//   transfer(alloc, dst, src)       把 src 处的元素移动到未初始化的 dst，并析构 src
+// 默认构造不申请空间，第一次插入时再分配槽位
+/*****************************************************************************************/
+template <typename Policy, typename Hash, typename KeyEqual, typename Alloc>
+class flat_hashtable {
+    static_assert(std::is_same<typename Policy::value_type, typename Alloc::value_type>::value,
+        "Alloc::value_type must be the same as value_type");
+
+public:
+    // clang-format off
+    using policy_type               = Policy;
+    using key_type                  = typename Policy::key_type;
+    using value_type                = typename Policy::value_type;
+    using hasher                    = Hash;
+    using key_equal                 = KeyEqual;
+
+    using allocator_type            = Alloc;
+    using alloc_traits              = mystl::allocator_traits<allocator_type>;
+    using ctrl_t                    = hash_detail::ctrl_t;
+    using ctrl_allocator_type       = typename alloc_traits::template rebind_alloc<ctrl_t>;
+    using ctrl_traits               = mystl::allocator_traits<ctrl_allocator_type>;
+
+    using pointer                   = typename alloc_traits::pointer;
+    using const_pointer             = typename alloc_traits::const_pointer;
+    using reference                 = value_type&;
+    using const_reference           = const value_type&;
+    using size_type                 = typename alloc_traits::size_type;
+    using difference_type           = typename alloc_traits::difference_type;
+
+    using iterator                  = flat_hash_iterator<Policy, false>;
+    using const_iterator            = flat_hash_iterator<Policy, true>;
+    // clang-format on
+
+protected:
+    // 哈希函数和比较函数都透明时为 K，否则为 key_type
+    template <typename K>
+    using key_arg = typename key_arg_helper<is_transparent<Hash>::value &&
+                                            is_transparent<KeyEqual>::value>::template type<K,
+        key_type>;
+
+private:
+    // 分配器作为基类保存，无状态的分配器借助空基类优化不占用额外空间
+    struct table_impl : public allocator_type {
+        ctrl_t* ctrl_;        // 控制字节数组，长度为 capacity_ + group_width
+        pointer slots_;       // 槽位数组，长度为 capacity_
+        size_type size_;      // 元素个数
+        size_type capacity_;  // 槽位数，为 0 或 2^k - 1
+        size_type growth_left_; // 不扩容时还能插入的元素个数
+
+        table_impl() noexcept(std::is_nothrow_default_constructible<allocator_type>::value)
+            : allocator_type()
+            , ctrl_(nullptr)
+            , slots_(nullptr)
+            , size_(0)
+            , capacity_(0)
+            , growth_left_(0) {}
+
+        explicit table_impl(const allocator_type& a) noexcept
+            : allocator_type(a)
+            , ctrl_(nullptr)
+            , slots_(nullptr)
+            , size_(0)
+            , capacity_(0)
+            , growth_left_(0) {}
+
+        explicit table_impl(allocator_type&& a) noexcept
+            : allocator_type(mystl::move(a))
+            , ctrl_(nullptr)
+            , slots_(nullptr)
+            , size_(0)
+            , capacity_(0)
+            , growth_left_(0) {}
+    };
+
+    table_impl impl_;
+    hasher hash_;
+    key_equal equal_;
+
+public:
+    flat_hashtable() noexcept(std::is_nothrow_default_constructible<allocator_type>::value &&
+                              std::is_nothrow_default_constructible<hasher>::value &&
+                              std::is_nothrow_default_constructible<key_equal>::value)
+        : impl_()
+        , hash_()
+        , equal_() {}
+
+    explicit flat_hashtable(size_type bucket_count, const hasher& hash = hasher(),
+        const key_equal& equal = key_equal(), const allocator_type& a = allocator_type())
+        : impl_(a)
+        , hash_(hash)
+        , equal_(equal) {
+        if (bucket_count != 0)
+            resize(hash_detail::normalize_capacity(bucket_count));
+    }
+
+    explicit flat_hashtable(const allocator_type& a)
+        : impl_(a)
+        , hash_()
+        , equal_() {}
+
+    flat_hashtable(size_type bucket_count, const allocator_type& a)
+        : flat_hashtable(bucket_count, hasher(), key_equal(), a) {}
+
+    flat_hashtable(size_type bucket_count, const hasher& hash, const allocator_type& a)
+        : flat_hashtable(bucket_count, hash, key_equal(), a) {}
+
+    template <typename Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type = 0>
+    flat_hashtable(Iter first, Iter last, size_type bucket_count = 0,
+        const hasher& hash = hasher(), const key_equal& equal = key_equal(),
+        const allocator_type& a = allocator_type())
+        : flat_hashtable(bucket_count, hash, equal, a) {
+        range_init(first, last, iterator_category(first));
+    }
+
+    flat_hashtable(std::initializer_list<value_type> ilist, size_type bucket_count = 0,
+        const hasher& hash = hasher(), const key_equal& equal = key_equal(),
+        const allocator_type& a = allocator_type())
+        : flat_hashtable(ilist.begin(), ilist.end(), bucket_count, hash, equal, a) {}
+
+    flat_hashtable(const flat_hashtable& rhs)
+        : impl_(alloc_traits::select_on_container_copy_construction(rhs.alloc_ref()))
+        , hash_(rhs.hash_)
+        , equal_(rhs.equal_) {
+        copy_init(rhs);
+    }
+
+    flat_hashtable(const flat_hashtable& rhs, const allocator_type& a)
+        : impl_(a)
+        , hash_(rhs.hash_)
+        , equal_(rhs.equal_) {
+        copy_init(rhs);
+    }
+
+    flat_hashtable(flat_hashtable&& rhs) noexcept
+        : impl_(mystl::move(rhs.alloc_ref()))
+        , hash_(rhs.hash_)
+        , equal_(rhs.equal_) {
+        swap_data(rhs);
+    }
+
+    // 分配器不同时不能直接接管 rhs 的空间，只能逐个移动元素
+    flat_hashtable(flat_hashtable&& rhs, const allocator_type& a)
+        : impl_(a)
+        , hash_(rhs.hash_)
+        , equal_(rhs.equal_) {
+        if (alloc_ref() == rhs.alloc_ref()) {
+            swap_data(rhs);
+        } else {
+            move_init(rhs);
+        }
+    }
+
+    flat_hashtable& operator=(const flat_hashtable& rhs);
+    flat_hashtable& operator=(flat_hashtable&& rhs) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value);
+
+    flat_hashtable& operator=(std::initializer_list<value_type> ilist) {
+        clear();
+        insert(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    ~flat_hashtable() {
+        release_all();
+    }
+
+public:
+    // 迭代器相关操作
+    iterator begin() noexcept {
+        if (impl_.size_ == 0)
+            return end();
+        iterator it(impl_.ctrl_, impl_.slots_);
+        it.skip_empty_or_deleted();
+        return it;
+    }
+    const_iterator begin() const noexcept {
+        return const_cast<flat_hashtable*>(this)->begin();
+    }
+    iterator end() noexcept {
+        return iterator(impl_.ctrl_ + impl_.capacity_, impl_.slots_ + impl_.capacity_);
+    }
+    const_iterator end() const noexcept {
+        return const_cast<flat_hashtable*>(this)->end();
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+
+    // 容量相关操作
+    bool empty() const noexcept {
+        return impl_.size_ == 0;
+    }
+
+    size_type size() const noexcept {
+        return impl_.size_;
+    }
+
+    size_type max_size() const noexcept {
+        return alloc_traits::max_size(alloc_ref());
+    }
+
+    // 修改容器相关操作
+
+    // emplace / insert，键已存在时不插入，返回已有元素的位置
+    template <typename... Args>
+    pair<iterator, bool> emplace(Args&&... args);
+
+    template <typename... Args>
+    iterator emplace_hint(const_iterator, Args&&... args) {
+        return emplace(mystl::forward<Args>(args)...).first;
+    }
+
+    pair<iterator, bool> insert(const value_type& value) {
+        return insert_value(value);
+    }
+
+    pair<iterator, bool> insert(value_type&& value) {
+        return insert_value(mystl::move(value));
+    }
+
+    iterator insert(const_iterator, const value_type& value) {
+        return insert_value(value).first;
+    }
+
+    iterator insert(const_iterator, value_type&& value) {
+        return insert_value(mystl::move(value)).first;
+    }
+
+    template <typename Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type = 0>
+    void insert(Iter first, Iter last) {
+        range_init(first, last, iterator_category(first));
+    }
+
+    void insert(std::initializer_list<value_type> ilist) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    // erase / clear，删除不会移动其他元素，其他迭代器保持有效
+    iterator erase(const_iterator pos);
+    iterator erase(iterator pos) {
+        return erase(const_iterator(pos));
+    }
+    iterator erase(const_iterator first, const_iterator last);
+
+    template <typename K = key_type>
+    size_type erase(const key_arg<K>& key) {
+        const size_type i = find_index(key, hash_of(key));
+        if (i == impl_.capacity_)
+            return 0;
+        erase_at(i);
+        return 1;
+    }
+
+    // 析构所有元素，保留槽位；需要释放空间时调用 rehash(0)
+    void clear() noexcept;
+
+    void swap(flat_hashtable& rhs) noexcept;
+
+    // 查找相关操作
+    template <typename K = key_type>
+    iterator find(const key_arg<K>& key) {
+        return iterator_at(find_index(key, hash_of(key)));
+    }
+
+    template <typename K = key_type>
+    const_iterator find(const key_arg<K>& key) const {
+        return const_cast<flat_hashtable*>(this)->find(key);
+    }
+
+    template <typename K = key_type>
+    bool contains(const key_arg<K>& key) const {
+        return find_index(key, hash_of(key)) != impl_.capacity_;
+    }
+
+    template <typename K = key_type>
+    size_type count(const key_arg<K>& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    template <typename K = key_type>
+    pair<iterator, iterator> equal_range(const key_arg<K>& key) {
+        auto it = find(key);
+        if (it == end())
+            return {it, it};
+        auto next = it;
+        return {it, ++next};
+    }
+
+    template <typename K = key_type>
+    pair<const_iterator, const_iterator> equal_range(const key_arg<K>& key) const {
+        auto r = const_cast<flat_hashtable*>(this)->equal_range(key);
+        return {r.first, r.second};
+    }
+
+    // bucket interface
+    size_type bucket_count() const noexcept {
+        return impl_.capacity_;
+    }
+
+    size_type max_bucket_count() const noexcept {
+        return max_size();
+    }
+
+    // hash policy，最大负载因子固定为 7/8，设置的值被忽略
+    float load_factor() const noexcept {
+        return impl_.capacity_ == 0 ? 0.0f
+                                    : static_cast<float>(impl_.size_) /
+                                          static_cast<float>(impl_.capacity_);
+    }
+
+    float max_load_factor() const noexcept {
+        return 0.875f;
+    }
+
+    void max_load_factor(float) noexcept {}
+
+    // 保证不扩容也可以存放 n 个元素
+    void reserve(size_type n) {
+        if (n > impl_.size_ + impl_.growth_left_)
+            resize(hash_detail::growth_to_capacity(n));
+    }
+
+    // 把槽位数调整为不小于 n，并且足够存放现有的元素；n 为 0 时收缩到刚好够用，空表释放全部空间
+    void rehash(size_type n);
+
+    hasher hash_function() const {
+        return hash_;
+    }
+
+    key_equal key_eq() const {
+        return equal_;
+    }
+
+    allocator_type get_allocator() const {
+        return alloc_ref();
+    }
+
+protected:
+    allocator_type& alloc_ref() noexcept {
+        return impl_;
+    }
+
+    const allocator_type& alloc_ref() const noexcept {
+        return impl_;
+    }
+
+    template <typename K>
+    size_t hash_of(const K& key) const {
+        return hash_detail::hash_mix(hash_(key));
+    }
+
+    iterator iterator_at(size_type i) noexcept {
+        return iterator(impl_.ctrl_ + i, impl_.slots_ + i);
+    }
+
+    // 返回 key 所在的槽位，不存在时返回 capacity_
+    template <typename K>
+    size_type find_index(const K& key, size_t hash) const;
+
+    // 查找 key，不存在时为它准备好一个槽位 (控制字节已设置，元素尚未构造)
+    // 返回槽位和是否为新槽位
+    template <typename K>
+    pair<size_type, bool> find_or_prepare_insert(const K& key);
+
+    // 在 find_or_prepare_insert 准备好的槽位上构造元素，失败时撤销该槽位
+    template <typename... Args>
+    void construct_at_slot(size_type i, Args&&... args);
+
+private:
+    // helper functions
+
+    size_type find_first_non_full(size_t hash) const noexcept;
+    size_type prepare_insert(size_t hash);
+
+    // 设置控制字节，同时更新末尾的副本
+    void set_ctrl(size_type i, ctrl_t h) noexcept {
+        const size_type cloned = hash_detail::group_width - 1;
+        impl_.ctrl_[i] = h;
+        impl_.ctrl_[((i - cloned) & impl_.capacity_) + (cloned & impl_.capacity_)] = h;
+    }
+
+    // 析构 i 处的元素并把槽位标记为空或墓碑
+    void erase_at(size_type i) noexcept {
+        alloc_traits::destroy(alloc_ref(), impl_.slots_ + i);
+        erase_meta_only(i);
+    }
+
+    void erase_meta_only(size_type i) noexcept;
+
+    template <typename V>
+    pair<iterator, bool> insert_value(V&& value);
+
+    // 把容器调整为 new_capacity 个槽位，重新放置所有元素
+    void resize(size_type new_capacity);
+    void rehash_and_grow();
+
+    // 分配与释放槽位数组和控制字节数组
+    void allocate_table(size_type capacity);
+    void deallocate_table(ctrl_t* ctrl, pointer slots, size_type capacity) noexcept;
+
+    void destroy_elements() noexcept;
+    void release_all() noexcept;
+
+    // initialize
+    template <typename Iter>
+    void range_init(Iter first, Iter last, input_iterator_tag);
+
+    template <typename Iter>
+    void range_init(Iter first, Iter last, forward_iterator_tag);
+
+    void copy_init(const flat_hashtable& rhs);
+    void move_init(flat_hashtable& rhs);
+
+    // 只交换数据，不交换分配器
+    void swap_data(flat_hashtable& rhs) noexcept;
+};
+
+/*****************************************************************************************/
+
+// 复制赋值运算符
+template <typename P, typename H, typename E, typename A>
+flat_hashtable<P, H, E, A>& flat_hashtable<P, H, E, A>::operator=(const flat_hashtable& rhs) {
+    if (this != &rhs) {
+        if (alloc_traits::propagate_on_container_copy_assignment::value &&
+            alloc_ref() != rhs.alloc_ref()) {
+            // 旧的空间必须由旧的分配器释放
+            release_all();
+        }
+        if (alloc_traits::propagate_on_container_copy_assignment::value)
+            alloc_ref() = rhs.alloc_ref();
+        clear();
+        hash_ = rhs.hash_;
+        equal_ = rhs.equal_;
+        copy_init(rhs);
+    }
+    return *this;
+}
+
+// 移动赋值运算符，分配器可以传播或者相等时直接接管 rhs 的空间，否则逐个移动元素
+template <typename P, typename H, typename E, typename A>
+flat_hashtable<P, H, E, A>& flat_hashtable<P, H, E, A>::operator=(
+    flat_hashtable&& rhs) noexcept(alloc_traits::propagate_on_container_move_assignment::value ||
+                                   alloc_traits::is_always_equal::value) {
+    if (this == &rhs)
+        return *this;
+    hash_ = rhs.hash_;
+    equal_ = rhs.equal_;
+    if (alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value || alloc_ref() == rhs.alloc_ref()) {
+        release_all();
+        if (alloc_traits::propagate_on_container_move_assignment::value)
+            alloc_ref() = mystl::move(rhs.alloc_ref());
+        swap_data(rhs);
+    } else {
+        clear();
+        move_init(rhs);
+    }
+    return *this;
+}
+
+// 就地构建元素，先构造出元素才能得到它的键，键已存在时这个元素被丢弃
+template <typename P, typename H, typename E, typename A>
+template <typename... Args>
+pair<typename flat_hashtable<P, H, E, A>::iterator, bool> flat_hashtable<P, H, E, A>::emplace(
+    Args&&... args) {
+    value_type tmp(mystl::forward<Args>(args)...);
+    return insert_value(mystl::move(tmp));
+}
+
+template <typename P, typename H, typename E, typename A>
+template <typename V>
+pair<typename flat_hashtable<P, H, E, A>::iterator, bool>
+flat_hashtable<P, H, E, A>::insert_value(V&& value) {
+    const auto r = find_or_prepare_insert(P::key(value));
+    if (r.second)
+        construct_at_slot(r.first, mystl::forward<V>(value));
+    return {iterator_at(r.first), r.second};
+}
+
+// 删除 pos 处的元素，返回下一个元素的位置
+template <typename P, typename H, typename E, typename A>
+typename flat_hashtable<P, H, E, A>::iterator flat_hashtable<P, H, E, A>::erase(
+    const_iterator pos) {
+    MYSTL_DEBUG(pos != cend());
+    const auto i = static_cast<size_type>(pos.ctrl - impl_.ctrl_);
+    erase_at(i);
+    auto next = iterator_at(i);
+    ++next;
+    return next;
+}
+
+template <typename P, typename H, typename E, typename A>
+typename flat_hashtable<P, H, E, A>::iterator flat_hashtable<P, H, E, A>::erase(
+    const_iterator first, const_iterator last) {
+    if (first == cbegin() && last == cend()) {
+        clear();
+        return end();
+    }
+    while (first != last) {
+        first = erase(first);
+    }
+    return iterator_at(static_cast<size_type>(last.ctrl - impl_.ctrl_));
+}
+
+template <typename P, typename H, typename E, typename A>
+void flat_hashtable<P, H, E, A>::clear() noexcept {
+    if (impl_.capacity_ == 0)
+        return;
+    destroy_elements();
+    std::memset(impl_.ctrl_, hash_detail::ECtrlEmpty,
+        impl_.capacity_ + hash_detail::group_width);
+    impl_.ctrl_[impl_.capacity_] = hash_detail::ECtrlSentinel;
+    impl_.size_ = 0;
+    impl_.growth_left_ = hash_detail::capacity_to_growth(impl_.capacity_);
+}
+
+// 与另一个容器交换，propagate_on_container_swap 为 false 时要求两者的分配器相等
+template <typename P, typename H, typename E, typename A>
+void flat_hashtable<P, H, E, A>::swap(flat_hashtable& rhs) noexcept {
+    if (this != &rhs) {
+        if (alloc_traits::propagate_on_container_swap::value) {
+            mystl::swap(alloc_ref(), rhs.alloc_ref());
+        } else {
+            MYSTL_DEBUG(alloc_ref() == rhs.alloc_ref());
+        }
+        mystl::swap(hash_, rhs.hash_);
+        mystl::swap(equal_, rhs.equal_);
+        swap_data(rhs);
+    }
+}
+
+template <typename P, typename H, typename E, typename A>
+void flat_hashtable<P, H, E, A>::rehash(size_type n) {
+    if (n == 0 && impl_.size_ == 0) {
+        release_all();
+        return;
+    }
+    const size_type needed = hash_detail::growth_to_capacity(impl_.size_);
+    size_type target = n == 0 ? needed : hash_detail::normalize_capacity(n);
+    if (target < needed)
+        target = needed;
+    if (n == 0 ? target < impl_.capacity_ : target > impl_.capacity_)
+        resize(target);
+}
+
+/*****************************************************************************************/
+// helper function
+
+// 按组探测，组内只比较 h2 相同的槽位，遇到空槽位说明键不存在
+template <typename P, typename H, typename E, typename A>
+template <typename K>
+typename flat_hashtable<P, H, E, A>::size_type flat_hashtable<P, H, E, A>::find_index(
+    const K& key, size_t hash) const {
+    if (impl_.size_ == 0)
+        return impl_.capacity_;
+    hash_detail::probe_seq seq(hash_detail::h1(hash), impl_.capacity_);
+    while (true) {
+        const hash_detail::group g(impl_.ctrl_ + seq.offset());
+        for (auto bits = g.match(hash_detail::h2(hash)); bits; bits.clear_lowest()) {
+            const size_type i = seq.offset(bits.lowest());
+            if (equal_(P::key(impl_.slots_[i]), key))
+                return i;
+        }
+        if (g.match_empty())
+            return impl_.capacity_;
+        seq.next();
+    }
+}
+
+template <typename P, typename H, typename E, typename A>
+template <typename K>
+pair<typename flat_hashtable<P, H, E, A>::size_type, bool>
+flat_hashtable<P, H, E, A>::find_or_prepare_insert(const K& key) {
+    const size_t hash = hash_of(key);
+    const size_type i = find_index(key, hash);
+    if (i != impl_.capacity_)
+        return {i, false};
+    return {prepare_insert(hash), true};
+}
+
+template <typename P, typename H, typename E, typename A>
+template <typename... Args>
+void flat_hashtable<P, H, E, A>::construct_at_slot(size_type i, Args&&... args) {
+    try {
+        alloc_traits::construct(alloc_ref(), impl_.slots_ + i, mystl::forward<Args>(args)...);
+    } catch (...) {
+        erase_meta_only(i);
+        throw;
+    }
+}
+
+// 第一个空槽位或墓碑
+template <typename P, typename H, typename E, typename A>
+typename flat_hashtable<P, H, E, A>::size_type flat_hashtable<P, H, E, A>::find_first_non_full(
+    size_t hash) const noexcept {
+    hash_detail::probe_seq seq(hash_detail::h1(hash), impl_.capacity_);
+    while (true) {
+        const auto mask = hash_detail::group(impl_.ctrl_ + seq.offset()).match_empty_or_deleted();
+        if (mask)
+            return seq.offset(mask.lowest());
+        seq.next();
+    }
+}
+
+// 墓碑可以直接复用，只有占用空槽位时才消耗 growth_left_
+template <typename P, typename H, typename E, typename A>
+typename flat_hashtable<P, H, E, A>::size_type flat_hashtable<P, H, E, A>::prepare_insert(
+    size_t hash) {
+    size_type target = impl_.capacity_ == 0 ? 0 : find_first_non_full(hash);
+    if (impl_.capacity_ == 0 ||
+        (impl_.growth_left_ == 0 && impl_.ctrl_[target] != hash_detail::ECtrlDeleted)) {
+        rehash_and_grow();
+        target = find_first_non_full(hash);
+    }
+    ++impl_.size_;
+    impl_.growth_left_ -= impl_.ctrl_[target] == hash_detail::ECtrlEmpty ? 1 : 0;
+    set_ctrl(target, hash_detail::h2(hash));
+    return target;
+}
+
+// 如果从 i 向前和向后都能在一组之内遇到空槽位，说明包含 i 的任何一组都不曾满过，
+// 没有探测序列会越过 i，可以直接标记为空；否则必须留下墓碑
+template <typename P, typename H, typename E, typename A>
+void flat_hashtable<P, H, E, A>::erase_meta_only(size_type i) noexcept {
+    --impl_.size_;
+    const size_type before = (i - hash_detail::group_width) & impl_.capacity_;
+    const auto empty_after = hash_detail::group(impl_.ctrl_ + i).match_empty();
+    const auto empty_before = hash_detail::group(impl_.ctrl_ + before).match_empty();
+    const bool was_never_full = empty_before && empty_after &&
+                                (empty_after.trailing_zeros() + empty_before.leading_zeros()) <
+                                    hash_detail::group_width;
+    set_ctrl(i, was_never_full ? hash_detail::ECtrlEmpty : hash_detail::ECtrlDeleted);
+    impl_.growth_left_ += was_never_full ? 1 : 0;
+}
+
+template <typename P, typename H, typename E, typename A>
+void flat_hashtable<P, H, E, A>::resize(size_type new_capacity) {
+    ctrl_t* old_ctrl = impl_.ctrl_;
+    pointer old_slots = impl_.slots_;
+    const size_type old_capacity = impl_.capacity_;
+    allocate_table(new_capacity);
+    impl_.growth_left_ = hash_detail::capacity_to_growth(new_capacity) - impl_.size_;
+    for (size_type i = 0; i != old_capacity; ++i) {
+        if (hash_detail::is_full(old_ctrl[i])) {
+            const size_t hash = hash_of(P::key(old_slots[i]));
+            const size_type target = find_first_non_full(hash);
+            set_ctrl(target, hash_detail::h2(hash));
+            P::transfer(alloc_ref(), impl_.slots_ + target, old_slots + i);
+        }
+    }
+    deallocate_table(old_ctrl, old_slots, old_capacity);
+}
+
+// 墓碑较多时按原来的槽位数重建即可清除墓碑，否则槽位数翻倍
+template <typename P, typename H, typename E, typename A>
+void flat_hashtable<P, H, E, A>::rehash_and_grow() {
+    if (impl_.capacity_ == 0) {
+        resize(hash_detail::normalize_capacity(0));
+    } else if (impl_.capacity_ > hash_detail::group_width &&
+               impl_.size_ * 32 <= impl_.capacity_ * 25) {
+        resize(impl_.capacity_);
+    } else {
+        resize(impl_.capacity_ * 2 + 1);
+    }
+}
+
+// 分配新的数组并初始化控制字节，不释放旧的数组
+template <typename P, typename H, typename E, typename A>
+void flat_hashtable<P, H, E, A>::allocate_table(size_type capacity) {
+    ctrl_allocator_type ctrl_alloc(alloc_ref());
+    const size_type ctrl_size = capacity + hash_detail::group_width;
+    ctrl_t* ctrl = ctrl_traits::allocate(ctrl_alloc, ctrl_size);
+    try {
+        impl_.slots_ = alloc_traits::allocate(alloc_ref(), capacity);
+    } catch (...) {
+        ctrl_traits::deallocate(ctrl_alloc, ctrl, ctrl_size);
+        throw;
+    }
+    std::memset(ctrl, hash_detail::ECtrlEmpty, ctrl_size);
+    ctrl[capacity] = hash_detail::ECtrlSentinel;
+    impl_.ctrl_ = ctrl;
+    impl_.capacity_ = capacity;
+}
+
+template <typename P, typename H, typename E, typename A>
+void flat_hashtable<P, H, E, A>::deallocate_table(
+    ctrl_t* ctrl, pointer slots, size_type capacity) noexcept {
+    if (capacity == 0)
+        return;
+    ctrl_allocator_type ctrl_alloc(alloc_ref());
+    ctrl_traits::deallocate(ctrl_alloc, ctrl, capacity + hash_detail::group_width);
+    alloc_traits::deallocate(alloc_ref(), slots, capacity);
+}
+
+template <typename P, typename H, typename E, typename A>
+void flat_hashtable<P, H, E, A>::destroy_elements() noexcept {
+    if (std::is_trivially_destructible<value_type>::value)
+        return;
+    for (size_type i = 0; i != impl_.capacity_; ++i) {
+        if (hash_detail::is_full(impl_.ctrl_[i]))
+            alloc_traits::destroy(alloc_ref(), impl_.slots_ + i);
+    }
+}
+
+template <typename P, typename H, typename E, typename A>
+void flat_hashtable<P, H, E, A>::release_all() noexcept {
+    if (impl_.capacity_ == 0)
+        return;
+    destroy_elements();
+    deallocate_table(impl_.ctrl_, impl_.slots_, impl_.capacity_);
+    impl_.ctrl_ = nullptr;
+    impl_.slots_ = nullptr;
+    impl_.size_ = 0;
+    impl_.capacity_ = 0;
+    impl_.growth_left_ = 0;
+}
+
+template <typename P, typename H, typename E, typename A>
+template <typename Iter>
+void flat_hashtable<P, H, E, A>::range_init(Iter first, Iter last, input_iterator_tag) {
+    for (; first != last; ++first) {
+        insert_value(*first);
+    }
+}
+
+// 前向迭代器可以预先得到元素个数，一次预留足够的槽位
+template <typename P, typename H, typename E, typename A>
+template <typename Iter>
+void flat_hashtable<P, H, E, A>::range_init(Iter first, Iter last, forward_iterator_tag) {
+    reserve(impl_.size_ + static_cast<size_type>(mystl::distance(first, last)));
+    range_init(first, last, input_iterator_tag{});
+}
+
+// rhs 中的键互不相同，不需要查找，直接放到第一个空槽位；在构造函数中调用时失败要自己释放空间
+template <typename P, typename H, typename E, typename A>
+void flat_hashtable<P, H, E, A>::copy_init(const flat_hashtable& rhs) {
+    reserve(rhs.size());
+    try {
+        for (const auto& value : rhs) {
+            const size_t hash = hash_of(P::key(value));
+            const size_type target = find_first_non_full(hash);
+            ++impl_.size_;
+            --impl_.growth_left_;
+            set_ctrl(target, hash_detail::h2(hash));
+            construct_at_slot(target, value);
+        }
+    } catch (...) {
+        release_all();
+        throw;
+    }
+}
+
+template <typename P, typename H, typename E, typename A>
+void flat_hashtable<P, H, E, A>::move_init(flat_hashtable& rhs) {
+    reserve(rhs.size());
+    try {
+        for (auto it = rhs.begin(); it != rhs.end(); ++it) {
+            const size_t hash = hash_of(P::key(*it));
+            const size_type target = find_first_non_full(hash);
+            ++impl_.size_;
+            --impl_.growth_left_;
+            set_ctrl(target, hash_detail::h2(hash));
+            construct_at_slot(target, mystl::move(*it.slot));
+        }
+    } catch (...) {
+        release_all();
+        throw;
+    }
+    rhs.clear();
+}
+
+template <typename P, typename H, typename E, typename A>
+void flat_hashtable<P, H, E, A>::swap_data(flat_hashtable& rhs) noexcept {
+    mystl::swap(impl_.ctrl_, rhs.impl_.ctrl_);
+    mystl::swap(impl_.slots_, rhs.impl_.slots_);
+    mystl::swap(impl_.size_, rhs.impl_.size_);
+    mystl::swap(impl_.capacity_, rhs.impl_.capacity_);
+    mystl::swap(impl_.growth_left_, rhs.impl_.growth_left_);
+}
+
+// 重载比较操作符，元素个数相同并且 lhs 中的每个元素都能在 rhs 中找到相等的元素
+template <typename P, typename H, typename E, typename A>
+bool operator==(const flat_hashtable<P, H, E, A>& lhs, const flat_hashtable<P, H, E, A>& rhs) {
+    if (lhs.size() != rhs.size())
+        return false;
+    for (const auto& value : lhs) {
+        auto it = rhs.find(P::key(value));
+        if (it == rhs.end() || !(*it == value))
+            return false;
+    }
+    return true;
+}
+
+template <typename P, typename H, typename E, typename A>
+bool operator!=(const flat_hashtable<P, H, E, A>& lhs, const flat_hashtable<P, H, E, A>& rhs) {
+    return !(lhs == rhs);
+}
+
+} // namespace mystl
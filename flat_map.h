@@ -0,0 +1,747 @@
+#pragma once
+
+// 这个头文件包含一个模板类 flat_map
+// flat_map : 基于有序数组的映射，键和映射值分别存放在两个容器 (默认为 mystl::vector) 中，
+// 下标相同的键和值组成一个元素。查找是在连续的键数组上做无分支的二分查找，适合构建一次、
+// 查找很多次的字典。
+//
+// 单个元素的插入和删除需要移动其后的所有元素，为 O(n)；批量插入先把新元素排序、去重，
+// 再与已有的元素归并一次，为 O(n + m log m)。以 sorted_unique 为第一个参数时，
+// 调用者保证输入已经按键排好序并且没有重复，省去排序。
+// 输入中有重复的键时保留最先出现的一个，已有的键不会被覆盖。
+//
+// 迭代器是随机访问迭代器，解引用得到 mystl::pair<const Key&, T&>，不是 value_type 的引用。
+// 批量插入时如果抛出异常，容器被清空。
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+
+#include "algobase.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "util.h"
+#include "vector.h"
+
+namespace mystl {
+
+/*****************************************************************************************/
+// flat_map_iterator
+// 同时指向键数组和值数组中相同下标的位置，operator-> 返回一个保存着引用对的代理对象
+/*****************************************************************************************/
+template <typename KeyIter, typename MappedIter>
+struct flat_map_iterator
+    : public iterator<random_access_iterator_tag,
+          pair<typename iterator_traits<KeyIter>::value_type,
+              typename iterator_traits<MappedIter>::value_type>> {
+    // clang-format off
+    using self              = flat_map_iterator;
+    using key_reference     = typename iterator_traits<KeyIter>::reference;
+    using mapped_reference  = typename iterator_traits<MappedIter>::reference;
+
+    using value_type        = pair<typename iterator_traits<KeyIter>::value_type,
+                                typename iterator_traits<MappedIter>::value_type>;
+    using reference         = pair<key_reference, mapped_reference>;
+    using difference_type   = ptrdiff_t;
+    // clang-format on
+
+    struct pointer {
+        reference ref;
+
+        const reference* operator->() const noexcept {
+            return &ref;
+        }
+    };
+
+    KeyIter key_it;
+    MappedIter mapped_it;
+
+    flat_map_iterator()
+        : key_it()
+        , mapped_it() {}
+
+    flat_map_iterator(KeyIter k, MappedIter m)
+        : key_it(k)
+        , mapped_it(m) {}
+
+    // iterator 可以转换为 const_iterator
+    template <typename OtherIter,
+        typename std::enable_if<!std::is_same<OtherIter, MappedIter>::value &&
+                                    std::is_convertible<OtherIter, MappedIter>::value,
+            int>::type = 0>
+    flat_map_iterator(const flat_map_iterator<KeyIter, OtherIter>& rhs)
+        : key_it(rhs.key_it)
+        , mapped_it(rhs.mapped_it) {}
+
+    reference operator*() const {
+        return reference(*key_it, *mapped_it);
+    }
+
+    pointer operator->() const {
+        return pointer{**this};
+    }
+
+    self& operator++() {
+        ++key_it;
+        ++mapped_it;
+        return *this;
+    }
+
+    self operator++(int) {
+        self tmp = *this;
+        ++*this;
+        return tmp;
+    }
+
+    self& operator--() {
+        --key_it;
+        --mapped_it;
+        return *this;
+    }
+
+    self operator--(int) {
+        self tmp = *this;
+        --*this;
+        return tmp;
+    }
+
+    self& operator+=(difference_type n) {
+        key_it += n;
+        mapped_it += n;
+        return *this;
+    }
+
+    self operator+(difference_type n) const {
+        self tmp = *this;
+        return tmp += n;
+    }
+
+    self& operator-=(difference_type n) {
+        return *this += -n;
+    }
+
+    self operator-(difference_type n) const {
+        self tmp = *this;
+        return tmp -= n;
+    }
+
+    difference_type operator-(const self& rhs) const {
+        return key_it - rhs.key_it;
+    }
+
+    reference operator[](difference_type n) const {
+        return *(*this + n);
+    }
+
+    bool operator==(const self& rhs) const {
+        return key_it == rhs.key_it;
+    }
+    bool operator!=(const self& rhs) const {
+        return key_it != rhs.key_it;
+    }
+    bool operator<(const self& rhs) const {
+        return key_it < rhs.key_it;
+    }
+    bool operator>(const self& rhs) const {
+        return rhs < *this;
+    }
+    bool operator<=(const self& rhs) const {
+        return !(rhs < *this);
+    }
+    bool operator>=(const self& rhs) const {
+        return !(*this < rhs);
+    }
+};
+
+template <typename KeyIter, typename MappedIter>
+flat_map_iterator<KeyIter, MappedIter> operator+(
+    ptrdiff_t n, const flat_map_iterator<KeyIter, MappedIter>& it) {
+    return it + n;
+}
+
+/*****************************************************************************************/
+// flat_map
+/*****************************************************************************************/
+template <typename Key, typename T, typename Compare = std::less<Key>,
+    typename KeyContainer = mystl::vector<Key>, typename MappedContainer = mystl::vector<T>>
+class flat_map {
+    static_assert(std::is_same<Key, typename KeyContainer::value_type>::value,
+        "KeyContainer::value_type must be the same as Key");
+    static_assert(std::is_same<T, typename MappedContainer::value_type>::value,
+        "MappedContainer::value_type must be the same as T");
+
+public:
+    // clang-format off
+    using key_type                  = Key;
+    using mapped_type               = T;
+    using value_type                = mystl::pair<Key, T>;
+    using key_compare               = Compare;
+    using reference                 = mystl::pair<const Key&, T&>;
+    using const_reference           = mystl::pair<const Key&, const T&>;
+    using size_type                 = size_t;
+    using difference_type           = ptrdiff_t;
+    using key_container_type        = KeyContainer;
+    using mapped_container_type     = MappedContainer;
+
+    using iterator                  = flat_map_iterator<typename KeyContainer::const_iterator,
+                                        typename MappedContainer::iterator>;
+    using const_iterator            = flat_map_iterator<typename KeyContainer::const_iterator,
+                                        typename MappedContainer::const_iterator>;
+    using reverse_iterator          = mystl::reverse_iterator<iterator>;
+    using const_reverse_iterator    = mystl::reverse_iterator<const_iterator>;
+    // clang-format on
+
+    // 按键比较两个元素
+    class value_compare {
+    public:
+        template <typename P1, typename P2>
+        bool operator()(const P1& lhs, const P2& rhs) const {
+            return comp_(lhs.first, rhs.first);
+        }
+
+    private:
+        friend class flat_map;
+
+        explicit value_compare(const key_compare& comp)
+            : comp_(comp) {}
+
+        key_compare comp_;
+    };
+
+    // extract() 的返回值
+    struct containers {
+        key_container_type keys;
+        mapped_container_type values;
+    };
+
+private:
+    // 比较函数定义了 is_transparent 时，查找类的函数接受任意类型的键
+    template <typename K>
+    using key_arg =
+        typename key_arg_helper<is_transparent<Compare>::value>::template type<K, key_type>;
+
+    key_container_type keys_;
+    mapped_container_type values_;
+    key_compare comp_;
+
+public:
+    flat_map()
+        : keys_()
+        , values_()
+        , comp_() {}
+
+    explicit flat_map(const key_compare& comp)
+        : keys_()
+        , values_()
+        , comp_(comp) {}
+
+    // 由两个等长的容器构造，键不要求有序
+    flat_map(key_container_type keys, mapped_container_type values,
+        const key_compare& comp = key_compare())
+        : keys_(mystl::move(keys))
+        , values_(mystl::move(values))
+        , comp_(comp) {
+        THROW_LENGTH_ERROR_IF(keys_.size() != values_.size(),
+            "flat_map<Key, T>: keys and values have different sizes");
+        sort_and_unique();
+    }
+
+    flat_map(sorted_unique_t, key_container_type keys, mapped_container_type values,
+        const key_compare& comp = key_compare())
+        : keys_(mystl::move(keys))
+        , values_(mystl::move(values))
+        , comp_(comp) {
+        THROW_LENGTH_ERROR_IF(keys_.size() != values_.size(),
+            "flat_map<Key, T>: keys and values have different sizes");
+        MYSTL_DEBUG(is_sorted_unique());
+    }
+
+    template <typename Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type = 0>
+    flat_map(Iter first, Iter last, const key_compare& comp = key_compare())
+        : keys_()
+        , values_()
+        , comp_(comp) {
+        insert(first, last);
+    }
+
+    template <typename Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type = 0>
+    flat_map(sorted_unique_t, Iter first, Iter last, const key_compare& comp = key_compare())
+        : keys_()
+        , values_()
+        , comp_(comp) {
+        insert(sorted_unique, first, last);
+    }
+
+    flat_map(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare())
+        : flat_map(ilist.begin(), ilist.end(), comp) {}
+
+    flat_map(sorted_unique_t, std::initializer_list<value_type> ilist,
+        const key_compare& comp = key_compare())
+        : flat_map(sorted_unique, ilist.begin(), ilist.end(), comp) {}
+
+    flat_map(const flat_map&) = default;
+    flat_map(flat_map&&) = default;
+
+    flat_map& operator=(const flat_map&) = default;
+    flat_map& operator=(flat_map&&) = default;
+
+    flat_map& operator=(std::initializer_list<value_type> ilist) {
+        clear();
+        insert(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+public:
+    // 迭代器相关操作
+    iterator begin() noexcept {
+        return iterator(keys_.cbegin(), values_.begin());
+    }
+    const_iterator begin() const noexcept {
+        return const_iterator(keys_.cbegin(), values_.cbegin());
+    }
+    iterator end() noexcept {
+        return iterator(keys_.cend(), values_.end());
+    }
+    const_iterator end() const noexcept {
+        return const_iterator(keys_.cend(), values_.cend());
+    }
+
+    reverse_iterator rbegin() noexcept {
+        return reverse_iterator(end());
+    }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator rend() noexcept {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+    const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+    const_reverse_iterator crend() const noexcept {
+        return rend();
+    }
+
+    // 容量相关操作
+    bool empty() const noexcept {
+        return keys_.empty();
+    }
+
+    size_type size() const noexcept {
+        return keys_.size();
+    }
+
+    size_type max_size() const noexcept {
+        return keys_.max_size() < values_.max_size() ? keys_.max_size() : values_.max_size();
+    }
+
+    void reserve(size_type n) {
+        keys_.reserve(n);
+        values_.reserve(n);
+    }
+
+    void shrink_to_fit() {
+        keys_.shrink_to_fit();
+        values_.shrink_to_fit();
+    }
+
+    // 访问元素相关操作
+    mapped_type& operator[](const key_type& key) {
+        return try_emplace(key).first->second;
+    }
+
+    mapped_type& operator[](key_type&& key) {
+        return try_emplace(mystl::move(key)).first->second;
+    }
+
+    template <typename K = key_type>
+    mapped_type& at(const key_arg<K>& key) {
+        auto it = find(key);
+        THROW_OUT_OF_RANGE_IF(it == end(), "flat_map<Key, T>::at() key not found");
+        return *it.mapped_it;
+    }
+
+    template <typename K = key_type>
+    const mapped_type& at(const key_arg<K>& key) const {
+        auto it = find(key);
+        THROW_OUT_OF_RANGE_IF(it == end(), "flat_map<Key, T>::at() key not found");
+        return *it.mapped_it;
+    }
+
+    // 底层容器
+    const key_container_type& keys() const noexcept {
+        return keys_;
+    }
+
+    const mapped_container_type& values() const noexcept {
+        return values_;
+    }
+
+    // 取出底层容器，之后容器为空
+    containers extract() {
+        containers c{mystl::move(keys_), mystl::move(values_)};
+        clear();
+        return c;
+    }
+
+    // 替换底层容器，调用者保证键已经排好序并且没有重复
+    void replace(key_container_type&& keys, mapped_container_type&& values) {
+        THROW_LENGTH_ERROR_IF(keys.size() != values.size(),
+            "flat_map<Key, T>: keys and values have different sizes");
+        keys_ = mystl::move(keys);
+        values_ = mystl::move(values);
+        MYSTL_DEBUG(is_sorted_unique());
+    }
+
+    // 修改容器相关操作
+
+    // emplace / insert，键已存在时不插入
+    template <typename... Args>
+    pair<iterator, bool> emplace(Args&&... args) {
+        value_type tmp(mystl::forward<Args>(args)...);
+        return try_emplace(mystl::move(tmp.first), mystl::move(tmp.second));
+    }
+
+    template <typename... Args>
+    iterator emplace_hint(const_iterator, Args&&... args) {
+        return emplace(mystl::forward<Args>(args)...).first;
+    }
+
+    pair<iterator, bool> insert(const value_type& value) {
+        return try_emplace(value.first, value.second);
+    }
+
+    pair<iterator, bool> insert(value_type&& value) {
+        return try_emplace(mystl::move(value.first), mystl::move(value.second));
+    }
+
+    iterator insert(const_iterator, const value_type& value) {
+        return insert(value).first;
+    }
+
+    iterator insert(const_iterator, value_type&& value) {
+        return insert(mystl::move(value)).first;
+    }
+
+    // 批量插入：排序、去重后与已有的元素归并
+    template <typename Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type = 0>
+    void insert(Iter first, Iter last) {
+        mystl::vector<value_type> buf(first, last);
+        std::stable_sort(buf.begin(), buf.end(), value_compare(comp_));
+        merge_sorted(buf.begin(), buf.end());
+    }
+
+    template <typename Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type = 0>
+    void insert(sorted_unique_t, Iter first, Iter last) {
+        mystl::vector<value_type> buf(first, last);
+        merge_sorted(buf.begin(), buf.end());
+    }
+
+    void insert(std::initializer_list<value_type> ilist) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    void insert(sorted_unique_t, std::initializer_list<value_type> ilist) {
+        insert(sorted_unique, ilist.begin(), ilist.end());
+    }
+
+    // try_emplace，键不存在时才用 args 构造映射值
+    template <typename... Args>
+    pair<iterator, bool> try_emplace(const key_type& key, Args&&... args) {
+        return try_emplace_impl(key, mystl::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    pair<iterator, bool> try_emplace(key_type&& key, Args&&... args) {
+        return try_emplace_impl(mystl::move(key), mystl::forward<Args>(args)...);
+    }
+
+    template <typename... Args>
+    iterator try_emplace(const_iterator, const key_type& key, Args&&... args) {
+        return try_emplace(key, mystl::forward<Args>(args)...).first;
+    }
+
+    template <typename... Args>
+    iterator try_emplace(const_iterator, key_type&& key, Args&&... args) {
+        return try_emplace(mystl::move(key), mystl::forward<Args>(args)...).first;
+    }
+
+    // insert_or_assign，键存在时把 obj 赋给映射值
+    template <typename M>
+    pair<iterator, bool> insert_or_assign(const key_type& key, M&& obj) {
+        auto r = try_emplace(key, mystl::forward<M>(obj));
+        if (!r.second)
+            *r.first.mapped_it = mystl::forward<M>(obj);
+        return r;
+    }
+
+    template <typename M>
+    pair<iterator, bool> insert_or_assign(key_type&& key, M&& obj) {
+        auto r = try_emplace(mystl::move(key), mystl::forward<M>(obj));
+        if (!r.second)
+            *r.first.mapped_it = mystl::forward<M>(obj);
+        return r;
+    }
+
+    // erase / clear
+    iterator erase(iterator pos) {
+        return erase(const_iterator(pos));
+    }
+
+    iterator erase(const_iterator pos) {
+        MYSTL_DEBUG(pos != cend());
+        const auto i = pos - cbegin();
+        keys_.erase(keys_.cbegin() + i);
+        values_.erase(values_.cbegin() + i);
+        return begin() + i;
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        const auto i = first - cbegin();
+        const auto j = last - cbegin();
+        keys_.erase(keys_.cbegin() + i, keys_.cbegin() + j);
+        values_.erase(values_.cbegin() + i, values_.cbegin() + j);
+        return begin() + i;
+    }
+
+    template <typename K = key_type>
+    size_type erase(const key_arg<K>& key) {
+        auto it = find(key);
+        if (it == end())
+            return 0;
+        erase(it);
+        return 1;
+    }
+
+    void clear() noexcept {
+        keys_.clear();
+        values_.clear();
+    }
+
+    void swap(flat_map& rhs) noexcept {
+        keys_.swap(rhs.keys_);
+        values_.swap(rhs.values_);
+        mystl::swap(comp_, rhs.comp_);
+    }
+
+    // 查找相关操作
+    template <typename K = key_type>
+    iterator find(const key_arg<K>& key) {
+        auto it = lower_bound(key);
+        return it != end() && !comp_(key, *it.key_it) ? it : end();
+    }
+
+    template <typename K = key_type>
+    const_iterator find(const key_arg<K>& key) const {
+        return const_cast<flat_map*>(this)->find(key);
+    }
+
+    template <typename K = key_type>
+    bool contains(const key_arg<K>& key) const {
+        return find(key) != end();
+    }
+
+    template <typename K = key_type>
+    size_type count(const key_arg<K>& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    template <typename K = key_type>
+    iterator lower_bound(const key_arg<K>& key) {
+        return begin() + lower_index(key);
+    }
+
+    template <typename K = key_type>
+    const_iterator lower_bound(const key_arg<K>& key) const {
+        return begin() + lower_index(key);
+    }
+
+    template <typename K = key_type>
+    iterator upper_bound(const key_arg<K>& key) {
+        return begin() + upper_index(key);
+    }
+
+    template <typename K = key_type>
+    const_iterator upper_bound(const key_arg<K>& key) const {
+        return begin() + upper_index(key);
+    }
+
+    template <typename K = key_type>
+    pair<iterator, iterator> equal_range(const key_arg<K>& key) {
+        auto it = lower_bound(key);
+        if (it == end() || comp_(key, *it.key_it))
+            return {it, it};
+        return {it, it + 1};
+    }
+
+    template <typename K = key_type>
+    pair<const_iterator, const_iterator> equal_range(const key_arg<K>& key) const {
+        auto r = const_cast<flat_map*>(this)->equal_range(key);
+        return {r.first, r.second};
+    }
+
+    // observers
+    key_compare key_comp() const {
+        return comp_;
+    }
+
+    value_compare value_comp() const {
+        return value_compare(comp_);
+    }
+
+private:
+    // helper functions
+
+    template <typename K>
+    difference_type lower_index(const K& key) const {
+        const auto& comp = comp_;
+        return branchless_partition_point(keys_.cbegin(), keys_.size(),
+                   [&](const key_type& k) { return comp(k, key); }) -
+               keys_.cbegin();
+    }
+
+    template <typename K>
+    difference_type upper_index(const K& key) const {
+        const auto& comp = comp_;
+        return branchless_partition_point(keys_.cbegin(), keys_.size(),
+                   [&](const key_type& k) { return !comp(key, k); }) -
+               keys_.cbegin();
+    }
+
+    bool is_sorted_unique() const {
+        for (size_type i = 1; i < keys_.size(); ++i) {
+            if (!comp_(keys_[i - 1], keys_[i]))
+                return false;
+        }
+        return true;
+    }
+
+    template <typename K, typename... Args>
+    pair<iterator, bool> try_emplace_impl(K&& key, Args&&... args);
+
+    // 构造时传入的容器可能无序，把元素合成 value_type 排序后重新放回
+    void sort_and_unique();
+
+    // 把有序 (可以有重复) 的 [first, last) 上的元素归并进来
+    template <typename Iter>
+    void merge_sorted(Iter first, Iter last);
+};
+
+/*****************************************************************************************/
+
+template <typename Key, typename T, typename Compare, typename KC, typename MC>
+template <typename K, typename... Args>
+pair<typename flat_map<Key, T, Compare, KC, MC>::iterator, bool>
+flat_map<Key, T, Compare, KC, MC>::try_emplace_impl(K&& key, Args&&... args) {
+    const auto i = lower_index(key);
+    if (i != static_cast<difference_type>(size()) && !comp_(key, keys_[i]))
+        return {begin() + i, false};
+    auto kit = keys_.insert(keys_.cbegin() + i, mystl::forward<K>(key));
+    try {
+        values_.emplace(values_.cbegin() + i, mystl::forward<Args>(args)...);
+    } catch (...) {
+        keys_.erase(kit);
+        throw;
+    }
+    return {begin() + i, true};
+}
+
+template <typename Key, typename T, typename Compare, typename KC, typename MC>
+void flat_map<Key, T, Compare, KC, MC>::sort_and_unique() {
+    if (is_sorted_unique())
+        return;
+    mystl::vector<value_type> buf;
+    buf.reserve(keys_.size());
+    for (size_type i = 0; i < keys_.size(); ++i) {
+        buf.emplace_back(mystl::move(keys_[i]), mystl::move(values_[i]));
+    }
+    clear();
+    std::stable_sort(buf.begin(), buf.end(), value_compare(comp_));
+    merge_sorted(buf.begin(), buf.end());
+}
+
+// 新元素都排在已有元素之后时直接追加，否则归并到一对新的容器中；
+// 归并时与已有元素或前一个新元素相等的新元素被丢弃
+template <typename Key, typename T, typename Compare, typename KC, typename MC>
+template <typename Iter>
+void flat_map<Key, T, Compare, KC, MC>::merge_sorted(Iter first, Iter last) {
+    if (first == last)
+        return;
+    const size_type n = size();
+    const auto m = static_cast<size_type>(last - first);
+    try {
+        if (n == 0 || comp_(keys_.back(), first->first)) {
+            reserve(n + m);
+            for (; first != last; ++first) {
+                if (keys_.size() == n || comp_(keys_.back(), first->first)) {
+                    keys_.push_back(mystl::move(first->first));
+                    values_.push_back(mystl::move(first->second));
+                }
+            }
+            return;
+        }
+        key_container_type new_keys(keys_.get_allocator());
+        mapped_container_type new_values(values_.get_allocator());
+        new_keys.reserve(n + m);
+        new_values.reserve(n + m);
+        size_type i = 0;
+        while (i < n || first != last) {
+            if (first == last || (i < n && !comp_(first->first, keys_[i]))) {
+                // 已有的元素较小或者相等，相等时丢弃新元素
+                if (first != last && !comp_(keys_[i], first->first))
+                    ++first;
+                new_keys.push_back(mystl::move(keys_[i]));
+                new_values.push_back(mystl::move(values_[i]));
+                ++i;
+            } else if (new_keys.empty() || comp_(new_keys.back(), first->first)) {
+                new_keys.push_back(mystl::move(first->first));
+                new_values.push_back(mystl::move(first->second));
+                ++first;
+            } else {
+                ++first;
+            }
+        }
+        keys_ = mystl::move(new_keys);
+        values_ = mystl::move(new_values);
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+// 重载比较操作符
+template <typename Key, typename T, typename Compare, typename KC, typename MC>
+bool operator==(
+    const flat_map<Key, T, Compare, KC, MC>& lhs, const flat_map<Key, T, Compare, KC, MC>& rhs) {
+    return lhs.size() == rhs.size() &&
+           mystl::equal(lhs.keys().begin(), lhs.keys().end(), rhs.keys().begin()) &&
+           mystl::equal(lhs.values().begin(), lhs.values().end(), rhs.values().begin());
+}
+
+template <typename Key, typename T, typename Compare, typename KC, typename MC>
+bool operator!=(
+    const flat_map<Key, T, Compare, KC, MC>& lhs, const flat_map<Key, T, Compare, KC, MC>& rhs) {
+    return !(lhs == rhs);
+}
+
+// 重载 mystl 的 swap
+template <typename Key, typename T, typename Compare, typename KC, typename MC>
+void swap(flat_map<Key, T, Compare, KC, MC>& lhs, flat_map<Key, T, Compare, KC, MC>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // namespace mystl
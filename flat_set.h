@@ -0,0 +1,399 @@
+#pragma once
+
+// 这个头文件包含一个模板类 flat_set
+// flat_set : 基于有序数组的集合，元素存放在一个容器 (默认为 mystl::vector) 中，
+// 查找是无分支的二分查找。批量插入先把新元素排序、去重，再与已有的元素归并一次；
+// 以 sorted_unique 为第一个参数时，调用者保证输入已经排好序并且没有重复，省去排序。
+// 批量插入时如果抛出异常，容器被清空。
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+
+#include "algobase.h"
+#include "exceptdef.h"
+#include "iterator.h"
+#include "util.h"
+#include "vector.h"
+
+namespace mystl {
+
+template <typename Key, typename Compare = std::less<Key>,
+    typename KeyContainer = mystl::vector<Key>>
+class flat_set {
+    static_assert(std::is_same<Key, typename KeyContainer::value_type>::value,
+        "KeyContainer::value_type must be the same as Key");
+
+public:
+    // clang-format off
+    using key_type                  = Key;
+    using value_type                = Key;
+    using key_compare               = Compare;
+    using value_compare             = Compare;
+    using reference                 = value_type&;
+    using const_reference           = const value_type&;
+    using size_type                 = size_t;
+    using difference_type           = ptrdiff_t;
+    using container_type            = KeyContainer;
+
+    // 元素不能被修改，两种迭代器都是只读的
+    using iterator                  = typename KeyContainer::const_iterator;
+    using const_iterator            = typename KeyContainer::const_iterator;
+    using reverse_iterator          = mystl::reverse_iterator<iterator>;
+    using const_reverse_iterator    = mystl::reverse_iterator<const_iterator>;
+    // clang-format on
+
+private:
+    // 比较函数定义了 is_transparent 时，查找类的函数接受任意类型的键
+    template <typename K>
+    using key_arg =
+        typename key_arg_helper<is_transparent<Compare>::value>::template type<K, key_type>;
+
+    container_type keys_;
+    key_compare comp_;
+
+public:
+    flat_set()
+        : keys_()
+        , comp_() {}
+
+    explicit flat_set(const key_compare& comp)
+        : keys_()
+        , comp_(comp) {}
+
+    // 由一个容器构造，元素不要求有序
+    explicit flat_set(container_type keys, const key_compare& comp = key_compare())
+        : keys_(mystl::move(keys))
+        , comp_(comp) {
+        sort_and_unique();
+    }
+
+    flat_set(sorted_unique_t, container_type keys, const key_compare& comp = key_compare())
+        : keys_(mystl::move(keys))
+        , comp_(comp) {
+        MYSTL_DEBUG(is_sorted_unique());
+    }
+
+    template <typename Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type = 0>
+    flat_set(Iter first, Iter last, const key_compare& comp = key_compare())
+        : keys_()
+        , comp_(comp) {
+        insert(first, last);
+    }
+
+    template <typename Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type = 0>
+    flat_set(sorted_unique_t, Iter first, Iter last, const key_compare& comp = key_compare())
+        : keys_()
+        , comp_(comp) {
+        insert(sorted_unique, first, last);
+    }
+
+    flat_set(std::initializer_list<value_type> ilist, const key_compare& comp = key_compare())
+        : flat_set(ilist.begin(), ilist.end(), comp) {}
+
+    flat_set(sorted_unique_t, std::initializer_list<value_type> ilist,
+        const key_compare& comp = key_compare())
+        : flat_set(sorted_unique, ilist.begin(), ilist.end(), comp) {}
+
+    flat_set(const flat_set&) = default;
+    flat_set(flat_set&&) = default;
+
+    flat_set& operator=(const flat_set&) = default;
+    flat_set& operator=(flat_set&&) = default;
+
+    flat_set& operator=(std::initializer_list<value_type> ilist) {
+        clear();
+        insert(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+public:
+    // 迭代器相关操作
+    const_iterator begin() const noexcept {
+        return keys_.cbegin();
+    }
+    const_iterator end() const noexcept {
+        return keys_.cend();
+    }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+    const_iterator cbegin() const noexcept {
+        return begin();
+    }
+    const_iterator cend() const noexcept {
+        return end();
+    }
+    const_reverse_iterator crbegin() const noexcept {
+        return rbegin();
+    }
+    const_reverse_iterator crend() const noexcept {
+        return rend();
+    }
+
+    // 容量相关操作
+    bool empty() const noexcept {
+        return keys_.empty();
+    }
+
+    size_type size() const noexcept {
+        return keys_.size();
+    }
+
+    size_type max_size() const noexcept {
+        return keys_.max_size();
+    }
+
+    void reserve(size_type n) {
+        keys_.reserve(n);
+    }
+
+    void shrink_to_fit() {
+        keys_.shrink_to_fit();
+    }
+
+    // 取出底层容器，之后容器为空
+    container_type extract() {
+        container_type c(mystl::move(keys_));
+        keys_.clear();
+        return c;
+    }
+
+    // 替换底层容器，调用者保证元素已经排好序并且没有重复
+    void replace(container_type&& keys) {
+        keys_ = mystl::move(keys);
+        MYSTL_DEBUG(is_sorted_unique());
+    }
+
+    // 修改容器相关操作
+
+    // emplace / insert，元素已存在时不插入
+    template <typename... Args>
+    pair<iterator, bool> emplace(Args&&... args) {
+        return insert_unique(value_type(mystl::forward<Args>(args)...));
+    }
+
+    template <typename... Args>
+    iterator emplace_hint(const_iterator, Args&&... args) {
+        return emplace(mystl::forward<Args>(args)...).first;
+    }
+
+    pair<iterator, bool> insert(const value_type& value) {
+        return insert_unique(value);
+    }
+
+    pair<iterator, bool> insert(value_type&& value) {
+        return insert_unique(mystl::move(value));
+    }
+
+    iterator insert(const_iterator, const value_type& value) {
+        return insert_unique(value).first;
+    }
+
+    iterator insert(const_iterator, value_type&& value) {
+        return insert_unique(mystl::move(value)).first;
+    }
+
+    // 批量插入：排序、去重后与已有的元素归并
+    template <typename Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type = 0>
+    void insert(Iter first, Iter last) {
+        container_type buf(first, last);
+        std::stable_sort(buf.begin(), buf.end(), comp_);
+        merge_sorted(buf.begin(), buf.end());
+    }
+
+    template <typename Iter,
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type = 0>
+    void insert(sorted_unique_t, Iter first, Iter last) {
+        container_type buf(first, last);
+        merge_sorted(buf.begin(), buf.end());
+    }
+
+    void insert(std::initializer_list<value_type> ilist) {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    void insert(sorted_unique_t, std::initializer_list<value_type> ilist) {
+        insert(sorted_unique, ilist.begin(), ilist.end());
+    }
+
+    // erase / clear
+    iterator erase(const_iterator pos) {
+        MYSTL_DEBUG(pos != cend());
+        return keys_.erase(pos);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+        return keys_.erase(first, last);
+    }
+
+    template <typename K = key_type>
+    size_type erase(const key_arg<K>& key) {
+        auto it = find(key);
+        if (it == end())
+            return 0;
+        erase(it);
+        return 1;
+    }
+
+    void clear() noexcept {
+        keys_.clear();
+    }
+
+    void swap(flat_set& rhs) noexcept {
+        keys_.swap(rhs.keys_);
+        mystl::swap(comp_, rhs.comp_);
+    }
+
+    // 查找相关操作
+    template <typename K = key_type>
+    const_iterator find(const key_arg<K>& key) const {
+        auto it = lower_bound(key);
+        return it != end() && !comp_(key, *it) ? it : end();
+    }
+
+    template <typename K = key_type>
+    bool contains(const key_arg<K>& key) const {
+        return find(key) != end();
+    }
+
+    template <typename K = key_type>
+    size_type count(const key_arg<K>& key) const {
+        return contains(key) ? 1 : 0;
+    }
+
+    template <typename K = key_type>
+    const_iterator lower_bound(const key_arg<K>& key) const {
+        const auto& comp = comp_;
+        return branchless_partition_point(
+            begin(), size(), [&](const key_type& k) { return comp(k, key); });
+    }
+
+    template <typename K = key_type>
+    const_iterator upper_bound(const key_arg<K>& key) const {
+        const auto& comp = comp_;
+        return branchless_partition_point(
+            begin(), size(), [&](const key_type& k) { return !comp(key, k); });
+    }
+
+    template <typename K = key_type>
+    pair<const_iterator, const_iterator> equal_range(const key_arg<K>& key) const {
+        auto it = lower_bound(key);
+        if (it == end() || comp_(key, *it))
+            return {it, it};
+        return {it, it + 1};
+    }
+
+    // observers
+    key_compare key_comp() const {
+        return comp_;
+    }
+
+    value_compare value_comp() const {
+        return comp_;
+    }
+
+private:
+    // helper functions
+
+    bool is_sorted_unique() const {
+        for (size_type i = 1; i < keys_.size(); ++i) {
+            if (!comp_(keys_[i - 1], keys_[i]))
+                return false;
+        }
+        return true;
+    }
+
+    template <typename V>
+    pair<iterator, bool> insert_unique(V&& value) {
+        auto it = lower_bound(value);
+        if (it != end() && !comp_(value, *it))
+            return {it, false};
+        return {keys_.insert(it, mystl::forward<V>(value)), true};
+    }
+
+    void sort_and_unique() {
+        if (is_sorted_unique())
+            return;
+        container_type buf(mystl::move(keys_));
+        keys_.clear();
+        std::stable_sort(buf.begin(), buf.end(), comp_);
+        merge_sorted(buf.begin(), buf.end());
+    }
+
+    // 把有序 (可以有重复) 的 [first, last) 上的元素归并进来，与 flat_map::merge_sorted 相同
+    template <typename Iter>
+    void merge_sorted(Iter first, Iter last);
+};
+
+/*****************************************************************************************/
+
+template <typename Key, typename Compare, typename KC>
+template <typename Iter>
+void flat_set<Key, Compare, KC>::merge_sorted(Iter first, Iter last) {
+    if (first == last)
+        return;
+    const size_type n = size();
+    const auto m = static_cast<size_type>(last - first);
+    try {
+        if (n == 0 || comp_(keys_.back(), *first)) {
+            keys_.reserve(n + m);
+            for (; first != last; ++first) {
+                if (keys_.size() == n || comp_(keys_.back(), *first))
+                    keys_.push_back(mystl::move(*first));
+            }
+            return;
+        }
+        container_type merged(keys_.get_allocator());
+        merged.reserve(n + m);
+        size_type i = 0;
+        while (i < n || first != last) {
+            if (first == last || (i < n && !comp_(*first, keys_[i]))) {
+                // 已有的元素较小或者相等，相等时丢弃新元素
+                if (first != last && !comp_(keys_[i], *first))
+                    ++first;
+                merged.push_back(mystl::move(keys_[i]));
+                ++i;
+            } else if (merged.empty() || comp_(merged.back(), *first)) {
+                merged.push_back(mystl::move(*first));
+                ++first;
+            } else {
+                ++first;
+            }
+        }
+        keys_ = mystl::move(merged);
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+// 重载比较操作符
+template <typename Key, typename Compare, typename KC>
+bool operator==(const flat_set<Key, Compare, KC>& lhs, const flat_set<Key, Compare, KC>& rhs) {
+    return lhs.size() == rhs.size() && mystl::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename Key, typename Compare, typename KC>
+bool operator!=(const flat_set<Key, Compare, KC>& lhs, const flat_set<Key, Compare, KC>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename Key, typename Compare, typename KC>
+bool operator<(const flat_set<Key, Compare, KC>& lhs, const flat_set<Key, Compare, KC>& rhs) {
+    return mystl::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+}
+
+// 重载 mystl 的 swap
+template <typename Key, typename Compare, typename KC>
+void swap(flat_set<Key, Compare, KC>& lhs, flat_set<Key, Compare, KC>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+} // namespace mystl
@@ -0,0 +1,147 @@
+#ifndef MYTINYSTL_HEAP_ALGO_H_
+#define MYTINYSTL_HEAP_ALGO_H_
+
+// 这个头文件包含 heap 的四个算法 : push_heap, pop_heap, sort_heap, make_heap
+// 堆为最大堆 (comp 意义下最大的元素在首位)，迭代器必须是随机访问迭代器。
+// 不带 comp 的版本使用 value_less，即 operator<
+
+#include "iterator.h"
+#include "util.h"
+
+namespace mystl {
+
+// 默认的比较函数对象，调用 operator<
+struct value_less {
+    template <class T1, class T2>
+    MYSTL_CONSTEXPR20 bool operator()(const T1& lhs, const T2& rhs) const {
+        return lhs < rhs;
+    }
+};
+
+/*****************************************************************************************/
+// push_heap
+// 该函数接受两个迭代器，表示一个 heap 容器的首尾，并且新元素已经插入到底部容器的最尾端，调整 heap
+/*****************************************************************************************/
+template <class RandomIter, class Distance, class T, class Compare>
+MYSTL_CONSTEXPR20 void push_heap_aux(
+    RandomIter first, Distance hole, Distance top, T value, Compare comp) {
+    Distance parent = (hole - 1) / 2;
+    while (hole > top && comp(*(first + parent), value)) {
+        // 上溯：父节点较小时下移到洞的位置
+        *(first + hole) = mystl::move(*(first + parent));
+        hole = parent;
+        parent = (hole - 1) / 2;
+    }
+    *(first + hole) = mystl::move(value);
+}
+
+template <class RandomIter, class Compare>
+MYSTL_CONSTEXPR20 void push_heap(RandomIter first, RandomIter last, Compare comp) {
+    using distance = typename iterator_traits<RandomIter>::difference_type;
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    const distance len = last - first;
+    if (len > 1) {
+        value_type value(mystl::move(*(last - 1)));
+        mystl::push_heap_aux(first, len - 1, distance(0), mystl::move(value), comp);
+    }
+}
+
+template <class RandomIter>
+MYSTL_CONSTEXPR20 void push_heap(RandomIter first, RandomIter last) {
+    mystl::push_heap(first, last, value_less());
+}
+
+/*****************************************************************************************/
+// pop_heap
+// 该函数接受两个迭代器，表示 heap 容器的首尾，将 heap 的根节点取出放到容器尾部，调整 heap
+/*****************************************************************************************/
+
+// 从 hole 开始一直下沉到叶子 (每层只比较两个子节点)，再把 value 从叶子处上溯，
+// 比每层都与 value 比较少一半的比较次数
+template <class RandomIter, class Distance, class T, class Compare>
+MYSTL_CONSTEXPR20 void adjust_heap(
+    RandomIter first, Distance hole, Distance len, T value, Compare comp) {
+    const Distance top = hole;
+    Distance child = 2 * hole + 2;
+    while (child < len) {
+        if (comp(*(first + child), *(first + (child - 1))))
+            --child;
+        *(first + hole) = mystl::move(*(first + child));
+        hole = child;
+        child = 2 * child + 2;
+    }
+    if (child == len) {
+        // 只有左子节点
+        *(first + hole) = mystl::move(*(first + (child - 1)));
+        hole = child - 1;
+    }
+    mystl::push_heap_aux(first, hole, top, mystl::move(value), comp);
+}
+
+// 把根节点移到 result，原来 result 处的元素重新放入 [first, last)
+template <class RandomIter, class Compare>
+MYSTL_CONSTEXPR20 void pop_heap_aux(
+    RandomIter first, RandomIter last, RandomIter result, Compare comp) {
+    using distance = typename iterator_traits<RandomIter>::difference_type;
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    value_type value(mystl::move(*result));
+    *result = mystl::move(*first);
+    mystl::adjust_heap(first, distance(0), distance(last - first), mystl::move(value), comp);
+}
+
+template <class RandomIter, class Compare>
+MYSTL_CONSTEXPR20 void pop_heap(RandomIter first, RandomIter last, Compare comp) {
+    if (last - first > 1)
+        mystl::pop_heap_aux(first, last - 1, last - 1, comp);
+}
+
+template <class RandomIter>
+MYSTL_CONSTEXPR20 void pop_heap(RandomIter first, RandomIter last) {
+    mystl::pop_heap(first, last, value_less());
+}
+
+/*****************************************************************************************/
+// sort_heap
+// 该函数接受两个迭代器，表示 heap 容器的首尾，不断执行 pop_heap 操作，直到首尾最多相差1
+/*****************************************************************************************/
+template <class RandomIter, class Compare>
+MYSTL_CONSTEXPR20 void sort_heap(RandomIter first, RandomIter last, Compare comp) {
+    // 每执行一次 pop_heap，最大的元素都被放到尾部，直到容器最多只有一个元素，完成排序
+    while (last - first > 1) {
+        mystl::pop_heap(first, last--, comp);
+    }
+}
+
+template <class RandomIter>
+MYSTL_CONSTEXPR20 void sort_heap(RandomIter first, RandomIter last) {
+    mystl::sort_heap(first, last, value_less());
+}
+
+/*****************************************************************************************/
+// make_heap
+// 该函数接受两个迭代器，表示 heap 容器的首尾，把容器内的数据变为一个 heap
+/*****************************************************************************************/
+template <class RandomIter, class Compare>
+MYSTL_CONSTEXPR20 void make_heap(RandomIter first, RandomIter last, Compare comp) {
+    using distance = typename iterator_traits<RandomIter>::difference_type;
+    using value_type = typename iterator_traits<RandomIter>::value_type;
+    const distance len = last - first;
+    if (len < 2)
+        return;
+    // 从最后一个有子节点的节点开始，逐个下沉
+    for (distance hole = (len - 2) / 2;; --hole) {
+        value_type value(mystl::move(*(first + hole)));
+        mystl::adjust_heap(first, hole, len, mystl::move(value), comp);
+        if (hole == 0)
+            return;
+    }
+}
+
+template <class RandomIter>
+MYSTL_CONSTEXPR20 void make_heap(RandomIter first, RandomIter last) {
+    mystl::make_heap(first, last, value_less());
+}
+
+} // namespace mystl
+
+#endif // !MYTINYSTL_HEAP_ALGO_H_
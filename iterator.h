@@ -152,7 +152,8 @@ struct is_iterator : public m_bool_constant<is_input_iterator<Iterator>::value |
 
 // 萃取某个迭代器的category
 template <typename Iterator>
-typename iterator_traits<Iterator>::iterator_category iterator_category(const Iterator&) {
+MYSTL_CONSTEXPR20 typename iterator_traits<Iterator>::iterator_category iterator_category(
+    const Iterator&) {
     using category = typename iterator_traits<Iterator>::iterator_category;
     return category();
 }
@@ -174,8 +175,8 @@ typename iterator_traits<Iterator>::value_type* value_type(const Iterator&) {
 // 计算迭代器之间的距离
 // 重载计算距离的函数模板，根据不同迭代器的特征来简化操作
 template <typename InputIterator>
-typename iterator_traits<InputIterator>::difference_type distance_dispatch(
-    InputIterator first, InputIterator last, input_iterator_tag) {
+MYSTL_CONSTEXPR20 typename iterator_traits<InputIterator>::difference_type
+distance_dispatch(InputIterator first, InputIterator last, input_iterator_tag) {
     typename iterator_traits<InputIterator>::difference_type n = 0;
     while (first != last) {
         ++n;
@@ -185,27 +186,27 @@ typename iterator_traits<InputIterator>::difference_type distance_dispatch(
 }
 
 template <typename RandomIterator>
-typename iterator_traits<RandomIterator>::difference_type distance_dispatch(
-    RandomIterator first, RandomIterator last, random_access_iterator_tag) {
+MYSTL_CONSTEXPR20 typename iterator_traits<RandomIterator>::difference_type
+distance_dispatch(RandomIterator first, RandomIterator last, random_access_iterator_tag) {
     return last - first;
 }
 
 template <typename InputIterator>
-typename iterator_traits<InputIterator>::difference_type distance(
+MYSTL_CONSTEXPR20 typename iterator_traits<InputIterator>::difference_type distance(
     InputIterator first, InputIterator last) {
     return distance_dispatch(first, last, iterator_category(first));
 }
 
 // 用于让迭代器前进 n 个距离
 template <typename InputIterator, typename Distance>
-void advance_dispatch(InputIterator& i, Distance n, input_iterator_tag) {
+MYSTL_CONSTEXPR20 void advance_dispatch(InputIterator& i, Distance n, input_iterator_tag) {
     while (n--) {
         ++i;
     }
 }
 
 template <typename BiIter, typename Distance>
-void advance_dispatch(BiIter& i, Distance n, bidirectional_iterator_tag) {
+MYSTL_CONSTEXPR20 void advance_dispatch(BiIter& i, Distance n, bidirectional_iterator_tag) {
     if (n >= 0) {
         while (n-- > 0) {
             ++i;
@@ -218,12 +219,13 @@ void advance_dispatch(BiIter& i, Distance n, bidirectional_iterator_tag) {
 }
 
 template <typename RandomIter, typename Distance>
-void advance_dispatch(RandomIter& i, Distance n, random_access_iterator_tag) {
+MYSTL_CONSTEXPR20 void advance_dispatch(
+    RandomIter& i, Distance n, random_access_iterator_tag) {
     i += n;
 }
 
 template <typename InputIterator, typename Distance>
-void advance(InputIterator& i, Distance n) {
+MYSTL_CONSTEXPR20 void advance(InputIterator& i, Distance n) {
     advance_dispatch(i, n, iterator_category(i));
 }
 
@@ -249,114 +251,114 @@ public:
 public:
     // 构造函数
     reverse_iterator() = default;
-    explicit reverse_iterator(iterator_type i)
+    MYSTL_CONSTEXPR20 explicit reverse_iterator(iterator_type i)
         : current(i) {}
-    reverse_iterator(const self& rhs)
+    MYSTL_CONSTEXPR20 reverse_iterator(const self& rhs)
         : current(rhs.current) {}
 
 public:
     // 取出对应的正向迭代器
-    iterator_type base() const {
+    MYSTL_CONSTEXPR20 iterator_type base() const {
         return current;
     }
 
     // 重载操作符
-    reference operator*() const {
+    MYSTL_CONSTEXPR20 reference operator*() const {
         // 实际上对应正向迭代器的前一个位置
         Iterator tmp = current;
         return *(--tmp);
     }
 
-    pointer operator->() const {
+    MYSTL_CONSTEXPR20 pointer operator->() const {
         return &(operator*());
     }
 
     // 前进++变成后退
-    self& operator++() {
+    MYSTL_CONSTEXPR20 self& operator++() {
         --current;
         return *this;
     }
 
-    self operator++(int) {
+    MYSTL_CONSTEXPR20 self operator++(int) {
         self tmp = *this;
         --current;
         return tmp;
     }
 
     // 后退变为前进
-    self& operator--() {
+    MYSTL_CONSTEXPR20 self& operator--() {
         ++current;
         return *this;
     }
 
-    self operator--(int) {
+    MYSTL_CONSTEXPR20 self operator--(int) {
         self tmp = *this;
         ++current;
         return tmp;
     }
 
-    self& operator+=(difference_type n) {
+    MYSTL_CONSTEXPR20 self& operator+=(difference_type n) {
         current -= n;
         return *this;
     }
 
-    self operator+(difference_type n) const {
+    MYSTL_CONSTEXPR20 self operator+(difference_type n) const {
         return self(current - n);
     }
 
-    self& operator-=(difference_type n) {
+    MYSTL_CONSTEXPR20 self& operator-=(difference_type n) {
         current += n;
         return *this;
     }
 
-    self operator-(difference_type n) const {
+    MYSTL_CONSTEXPR20 self operator-(difference_type n) const {
         return self(current + n);
     }
 
-    reference operator[](difference_type n) const {
+    MYSTL_CONSTEXPR20 reference operator[](difference_type n) const {
         return *(*this + n);
     }
 };
 
 template <typename Iterator>
-typename reverse_iterator<Iterator>::difference_type operator-(
+MYSTL_CONSTEXPR20 typename reverse_iterator<Iterator>::difference_type operator-(
     const reverse_iterator<Iterator>& lhs, const reverse_iterator<Iterator>& rhs) {
     return rhs.base() - lhs.base();
 }
 
 // 重载比较操作符
 template <typename Iterator>
-bool operator==(
+MYSTL_CONSTEXPR20 bool operator==(
     const reverse_iterator<Iterator>& lhs, const reverse_iterator<Iterator>& rhs) {
     return lhs.base() == rhs.base();
 }
 
 template <typename Iterator>
-bool operator<(
+MYSTL_CONSTEXPR20 bool operator<(
     const reverse_iterator<Iterator>& lhs, const reverse_iterator<Iterator>& rhs) {
     return lhs.base() > rhs.base();
 }
 
 template <typename Iterator>
-bool operator!=(
+MYSTL_CONSTEXPR20 bool operator!=(
     const reverse_iterator<Iterator>& lhs, const reverse_iterator<Iterator>& rhs) {
     return !(lhs == rhs);
 }
 
 template <typename Iterator>
-bool operator>(
+MYSTL_CONSTEXPR20 bool operator>(
     const reverse_iterator<Iterator>& lhs, const reverse_iterator<Iterator>& rhs) {
     return rhs < lhs;
 }
 
 template <typename Iterator>
-bool operator<=(
+MYSTL_CONSTEXPR20 bool operator<=(
     const reverse_iterator<Iterator>& lhs, const reverse_iterator<Iterator>& rhs) {
     return !(rhs < lhs);
 }
 
 template <typename Iterator>
-bool operator>=(
+MYSTL_CONSTEXPR20 bool operator>=(
     const reverse_iterator<Iterator>& lhs, const reverse_iterator<Iterator>& rhs) {
     return !(lhs < rhs);
 }
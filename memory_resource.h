@@ -0,0 +1,592 @@
+#pragma once
+
+// 这个头文件包含类型擦除的内存资源以及使用它们的分配器 polymorphic_allocator
+//
+// memory_resource              : 内存资源的抽象接口
+// new_delete_resource          : 使用 ::operator new / ::operator delete 的资源
+// null_memory_resource         : 任何分配都抛出 std::bad_alloc 的资源
+// monotonic_buffer_resource    : 单调增长的资源，只做指针递增，不单独回收，release 时整体释放
+// unsynchronized_pool_resource : 按块大小分级的池资源，非线程安全
+// polymorphic_allocator        : 通过 memory_resource* 分配内存的分配器，
+//                                使用不同资源的容器属于同一个类型
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+#include "exceptdef.h"
+#include "util.h"
+
+namespace mystl {
+namespace pmr {
+
+/*****************************************************************************************/
+// memory_resource
+/*****************************************************************************************/
+class memory_resource {
+    static constexpr size_t max_align = alignof(std::max_align_t);
+
+public:
+    virtual ~memory_resource() = default;
+
+    void* allocate(size_t bytes, size_t alignment = max_align) {
+        return do_allocate(bytes, alignment);
+    }
+
+    void deallocate(void* p, size_t bytes, size_t alignment = max_align) {
+        do_deallocate(p, bytes, alignment);
+    }
+
+    bool is_equal(const memory_resource& other) const noexcept {
+        return do_is_equal(other);
+    }
+
+private:
+    virtual void* do_allocate(size_t bytes, size_t alignment) = 0;
+    virtual void do_deallocate(void* p, size_t bytes, size_t alignment) = 0;
+    virtual bool do_is_equal(const memory_resource& other) const noexcept = 0;
+};
+
+inline bool operator==(const memory_resource& lhs, const memory_resource& rhs) noexcept {
+    return &lhs == &rhs || lhs.is_equal(rhs);
+}
+
+inline bool operator!=(const memory_resource& lhs, const memory_resource& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+// 把 n 上调为 align 的倍数，align 必须是 2 的幂
+inline size_t resource_align_up(size_t n, size_t align) noexcept {
+    return (n + align - 1) & ~(align - 1);
+}
+
+/*****************************************************************************************/
+// new_delete_resource / null_memory_resource
+/*****************************************************************************************/
+class new_delete_memory_resource : public memory_resource {
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+#ifdef __cpp_aligned_new
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            return ::operator new(bytes, std::align_val_t(alignment));
+#endif
+        (void)alignment;
+        return ::operator new(bytes);
+    }
+
+    void do_deallocate(void* p, size_t, size_t alignment) override {
+#ifdef __cpp_aligned_new
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+            ::operator delete(p, std::align_val_t(alignment));
+            return;
+        }
+#endif
+        (void)alignment;
+        ::operator delete(p);
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+class null_memory_resource_impl : public memory_resource {
+private:
+    void* do_allocate(size_t, size_t) override {
+        throw std::bad_alloc();
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+// 以下两个资源对象只构造不析构，程序退出过程中仍然可以使用
+inline memory_resource* new_delete_resource() noexcept {
+    static memory_resource* resource = ::new new_delete_memory_resource();
+    return resource;
+}
+
+inline memory_resource* null_memory_resource() noexcept {
+    static memory_resource* resource = ::new null_memory_resource_impl();
+    return resource;
+}
+
+// 默认资源，未指定上游资源的对象都使用它
+inline std::atomic<memory_resource*>& default_resource_holder() noexcept {
+    static std::atomic<memory_resource*> resource(new_delete_resource());
+    return resource;
+}
+
+inline memory_resource* get_default_resource() noexcept {
+    return default_resource_holder().load(std::memory_order_acquire);
+}
+
+// 设置默认资源，传入 nullptr 时恢复为 new_delete_resource，返回原来的默认资源
+inline memory_resource* set_default_resource(memory_resource* r) noexcept {
+    if (r == nullptr)
+        r = new_delete_resource();
+    return default_resource_holder().exchange(r, std::memory_order_acq_rel);
+}
+
+/*****************************************************************************************/
+// monotonic_buffer_resource
+// 从当前缓冲区递增地切出内存，deallocate 不做任何事，缓冲区用完后向上游申请更大的缓冲区
+// release 把所有向上游申请的缓冲区一次性归还，并回到初始缓冲区
+/*****************************************************************************************/
+class monotonic_buffer_resource : public memory_resource {
+private:
+    // 向上游申请的缓冲区，头部放在缓冲区末尾，不影响缓冲区起始处的对齐
+    struct chunk_header {
+        chunk_header* next;
+        void* base;
+        size_t size;
+        size_t alignment;
+    };
+
+    enum { EInitialSize = 1024 };
+
+public:
+    explicit monotonic_buffer_resource(memory_resource* upstream = get_default_resource())
+        : monotonic_buffer_resource(nullptr, 0, EInitialSize, upstream) {}
+
+    monotonic_buffer_resource(size_t initial_size, memory_resource* upstream)
+        : monotonic_buffer_resource(nullptr, 0, initial_size, upstream) {}
+
+    explicit monotonic_buffer_resource(size_t initial_size)
+        : monotonic_buffer_resource(nullptr, 0, initial_size, get_default_resource()) {}
+
+    monotonic_buffer_resource(void* buffer, size_t buffer_size,
+        memory_resource* upstream = get_default_resource())
+        : monotonic_buffer_resource(buffer, buffer_size, buffer_size, upstream) {}
+
+    monotonic_buffer_resource(const monotonic_buffer_resource&) = delete;
+    monotonic_buffer_resource& operator=(const monotonic_buffer_resource&) = delete;
+
+    ~monotonic_buffer_resource() override {
+        release();
+    }
+
+    // 归还所有向上游申请的缓冲区，之后重新从初始缓冲区开始分配
+    void release() noexcept {
+        while (chunks_ != nullptr) {
+            chunk_header* next = chunks_->next;
+            upstream_->deallocate(chunks_->base, chunks_->size, chunks_->alignment);
+            chunks_ = next;
+        }
+        cur_ = static_cast<char*>(initial_buffer_);
+        end_ = cur_ + initial_buffer_size_;
+        next_size_ = initial_size_ == 0 ? static_cast<size_t>(EInitialSize) : initial_size_;
+    }
+
+    memory_resource* upstream_resource() const noexcept {
+        return upstream_;
+    }
+
+private:
+    monotonic_buffer_resource(void* buffer, size_t buffer_size, size_t initial_size,
+        memory_resource* upstream)
+        : upstream_(upstream)
+        , initial_buffer_(buffer)
+        , initial_buffer_size_(buffer == nullptr ? 0 : buffer_size)
+        , initial_size_(initial_size)
+        , next_size_(initial_size == 0 ? static_cast<size_t>(EInitialSize) : initial_size)
+        , cur_(static_cast<char*>(buffer))
+        , end_(static_cast<char*>(buffer) + initial_buffer_size_)
+        , chunks_(nullptr) {}
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        if (bytes == 0)
+            bytes = 1;
+        void* p = try_bump(bytes, alignment);
+        if (p == nullptr) {
+            new_chunk(bytes, alignment);
+            p = try_bump(bytes, alignment);
+        }
+        return p;
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    // 在当前缓冲区中切出一块，空间不足时返回 nullptr
+    void* try_bump(size_t bytes, size_t alignment) noexcept {
+        if (cur_ == nullptr)
+            return nullptr;
+        const size_t addr = reinterpret_cast<size_t>(cur_);
+        char* p = cur_ + (resource_align_up(addr, alignment) - addr);
+        if (p > end_ || static_cast<size_t>(end_ - p) < bytes)
+            return nullptr;
+        cur_ = p + bytes;
+        return p;
+    }
+
+    // 向上游申请新的缓冲区，大小按几何级数增长且至少能容纳本次请求。
+    // 缓冲区大小不超过 max_chunk_size()，翻倍到上限后不再增长，避免溢出后死循环
+    void new_chunk(size_t bytes, size_t alignment) {
+        const size_t header_align = alignof(chunk_header);
+        if (bytes > max_chunk_size())
+            throw std::bad_alloc();
+        size_t size = next_size_ < max_chunk_size() ? next_size_ : max_chunk_size();
+        while (size < bytes)
+            size = size > max_chunk_size() / 2 ? max_chunk_size() : size << 1;
+        const size_t header_offset = resource_align_up(size, header_align);
+        const size_t total = header_offset + sizeof(chunk_header);
+        const size_t chunk_align = alignment > header_align ? alignment : header_align;
+
+        char* base = static_cast<char*>(upstream_->allocate(total, chunk_align));
+        chunk_header* header = reinterpret_cast<chunk_header*>(base + header_offset);
+        header->next = chunks_;
+        header->base = base;
+        header->size = total;
+        header->alignment = chunk_align;
+        chunks_ = header;
+
+        cur_ = base;
+        end_ = base + size;
+        next_size_ = size > max_chunk_size() / 2 ? max_chunk_size() : size << 1;
+    }
+
+    // 加上 chunk_header 之后总大小仍不会溢出
+    static size_t max_chunk_size() noexcept {
+        return static_cast<size_t>(-1) / 2;
+    }
+
+private:
+    memory_resource* upstream_;
+    void* initial_buffer_;
+    size_t initial_buffer_size_;
+    size_t initial_size_;
+    size_t next_size_;
+    char* cur_;
+    char* end_;
+    chunk_header* chunks_;
+};
+
+/*****************************************************************************************/
+// unsynchronized_pool_resource
+// 为 2 的幂大小的块各维护一个池，每个池从上游批量申请 chunk 后切成等大的块，
+// 回收的块挂回池的自由链表；超过 largest_required_pool_block 的请求直接交给上游
+/*****************************************************************************************/
+struct pool_options {
+    size_t max_blocks_per_chunk = 0;
+    size_t largest_required_pool_block = 0;
+};
+
+class unsynchronized_pool_resource : public memory_resource {
+private:
+    struct free_block {
+        free_block* next;
+    };
+
+    struct chunk_header {
+        chunk_header* next;
+        void* base;
+        size_t size;
+        size_t alignment;
+    };
+
+    struct pool {
+        free_block* free_list;
+        chunk_header* chunks;
+        size_t blocks_per_chunk; // 下一次申请 chunk 时切出的块数
+    };
+
+    // 直接交给上游的大块，头部放在用户内存之前，用双向链表串联以便 release
+    struct large_header {
+        large_header* prev;
+        large_header* next;
+        void* base;
+        size_t size;
+        size_t alignment;
+    };
+
+    enum { EMinBlock = 8 };
+    enum { EDefaultLargestBlock = 4096 };
+    enum { EDefaultMaxBlocks = 1024 };
+    enum { EInitialBlocks = 16 };
+
+public:
+    unsynchronized_pool_resource()
+        : unsynchronized_pool_resource(pool_options(), get_default_resource()) {}
+
+    explicit unsynchronized_pool_resource(memory_resource* upstream)
+        : unsynchronized_pool_resource(pool_options(), upstream) {}
+
+    explicit unsynchronized_pool_resource(const pool_options& opts)
+        : unsynchronized_pool_resource(opts, get_default_resource()) {}
+
+    unsynchronized_pool_resource(const pool_options& opts, memory_resource* upstream)
+        : upstream_(upstream)
+        , pools_(nullptr)
+        , pool_count_(0)
+        , large_(nullptr) {
+        options_.max_blocks_per_chunk =
+            opts.max_blocks_per_chunk == 0 ? static_cast<size_t>(EDefaultMaxBlocks)
+                                            : opts.max_blocks_per_chunk;
+        size_t largest = opts.largest_required_pool_block == 0
+                             ? static_cast<size_t>(EDefaultLargestBlock)
+                             : opts.largest_required_pool_block;
+        // 块大小最大取 size_t 能表示的最大的 2 的幂，继续翻倍会溢出为 0
+        size_t block = EMinBlock;
+        pool_count_ = 1;
+        while (block < largest && block <= static_cast<size_t>(-1) / 2) {
+            block <<= 1;
+            ++pool_count_;
+        }
+        options_.largest_required_pool_block = block;
+    }
+
+    unsynchronized_pool_resource(const unsynchronized_pool_resource&) = delete;
+    unsynchronized_pool_resource& operator=(const unsynchronized_pool_resource&) = delete;
+
+    ~unsynchronized_pool_resource() override {
+        release();
+    }
+
+    // 把所有内存归还给上游，包括尚未 deallocate 的块
+    void release() noexcept {
+        if (pools_ != nullptr) {
+            for (size_t i = 0; i < pool_count_; ++i) {
+                chunk_header* c = pools_[i].chunks;
+                while (c != nullptr) {
+                    chunk_header* next = c->next;
+                    upstream_->deallocate(c->base, c->size, c->alignment);
+                    c = next;
+                }
+            }
+            upstream_->deallocate(pools_, pool_count_ * sizeof(pool), alignof(pool));
+            pools_ = nullptr;
+        }
+        while (large_ != nullptr) {
+            large_header* next = large_->next;
+            upstream_->deallocate(large_->base, large_->size, large_->alignment);
+            large_ = next;
+        }
+    }
+
+    memory_resource* upstream_resource() const noexcept {
+        return upstream_;
+    }
+
+    pool_options options() const noexcept {
+        return options_;
+    }
+
+private:
+    // 块的大小超过 largest_required_pool_block 的请求直接交给上游。
+    // largest_required_pool_block 为 2 的幂，先判断再取整，过大的 bytes 不会让 block_size 溢出
+    bool is_large(size_t bytes, size_t alignment) const noexcept {
+        return bytes > options_.largest_required_pool_block ||
+               alignment > options_.largest_required_pool_block;
+    }
+
+    // 块的大小：不小于 bytes 和 alignment 的 2 的幂，块按自身大小对齐，
+    // 只对不超过 largest_required_pool_block 的请求调用
+    static size_t block_size(size_t bytes, size_t alignment) noexcept {
+        size_t block = EMinBlock;
+        while (block < bytes || block < alignment)
+            block <<= 1;
+        return block;
+    }
+
+    static size_t pool_index(size_t block) noexcept {
+        size_t index = 0;
+        while ((static_cast<size_t>(EMinBlock) << index) < block)
+            ++index;
+        return index;
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        if (is_large(bytes, alignment))
+            return allocate_large(bytes, alignment);
+        const size_t block = block_size(bytes == 0 ? 1 : bytes, alignment);
+
+        if (pools_ == nullptr)
+            init_pools();
+        pool& p = pools_[pool_index(block)];
+        if (p.free_list == nullptr)
+            refill(p, block);
+        free_block* result = p.free_list;
+        p.free_list = result->next;
+        return result;
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        if (ptr == nullptr)
+            return;
+        if (is_large(bytes, alignment)) {
+            deallocate_large(ptr);
+            return;
+        }
+        const size_t block = block_size(bytes == 0 ? 1 : bytes, alignment);
+        pool& p = pools_[pool_index(block)];
+        free_block* q = static_cast<free_block*>(ptr);
+        q->next = p.free_list;
+        p.free_list = q;
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    void init_pools() {
+        pools_ = static_cast<pool*>(
+            upstream_->allocate(pool_count_ * sizeof(pool), alignof(pool)));
+        for (size_t i = 0; i < pool_count_; ++i) {
+            pools_[i].free_list = nullptr;
+            pools_[i].chunks = nullptr;
+            pools_[i].blocks_per_chunk = EInitialBlocks;
+        }
+    }
+
+    // 申请一个 chunk 切成 blocks_per_chunk 个块，下一次申请的块数翻倍直到上限
+    void refill(pool& p, size_t block) {
+        const size_t nblock = p.blocks_per_chunk;
+        if (block > (static_cast<size_t>(-1) - sizeof(chunk_header)) / nblock)
+            throw std::bad_alloc();
+        const size_t header_offset = nblock * block;
+        const size_t total = header_offset + sizeof(chunk_header);
+        const size_t chunk_align =
+            block > alignof(chunk_header) ? block : alignof(chunk_header);
+        char* base = static_cast<char*>(upstream_->allocate(total, chunk_align));
+
+        chunk_header* header = reinterpret_cast<chunk_header*>(base + header_offset);
+        header->next = p.chunks;
+        header->base = base;
+        header->size = total;
+        header->alignment = chunk_align;
+        p.chunks = header;
+
+        for (size_t i = nblock; i > 0; --i) {
+            free_block* q = reinterpret_cast<free_block*>(base + (i - 1) * block);
+            q->next = p.free_list;
+            p.free_list = q;
+        }
+        if (p.blocks_per_chunk < options_.max_blocks_per_chunk) {
+            p.blocks_per_chunk <<= 1;
+            if (p.blocks_per_chunk > options_.max_blocks_per_chunk)
+                p.blocks_per_chunk = options_.max_blocks_per_chunk;
+        }
+    }
+
+    void* allocate_large(size_t bytes, size_t alignment) {
+        const size_t align =
+            alignment > alignof(large_header) ? alignment : alignof(large_header);
+        const size_t offset = resource_align_up(sizeof(large_header), align);
+        if (bytes > static_cast<size_t>(-1) - offset)
+            throw std::bad_alloc();
+        const size_t total = offset + bytes;
+        char* base = static_cast<char*>(upstream_->allocate(total, align));
+        large_header* header = reinterpret_cast<large_header*>(base + offset) - 1;
+        header->prev = nullptr;
+        header->next = large_;
+        header->base = base;
+        header->size = total;
+        header->alignment = align;
+        if (large_ != nullptr)
+            large_->prev = header;
+        large_ = header;
+        return base + offset;
+    }
+
+    void deallocate_large(void* ptr) {
+        large_header* header = static_cast<large_header*>(ptr) - 1;
+        if (header->prev != nullptr)
+            header->prev->next = header->next;
+        else
+            large_ = header->next;
+        if (header->next != nullptr)
+            header->next->prev = header->prev;
+        upstream_->deallocate(header->base, header->size, header->alignment);
+    }
+
+private:
+    memory_resource* upstream_;
+    pool_options options_;
+    pool* pools_;
+    size_t pool_count_;
+    large_header* large_;
+};
+
+/*****************************************************************************************/
+// polymorphic_allocator
+// 复制容器时不传播，副本使用默认资源；移动和交换也不传播分配器
+/*****************************************************************************************/
+template <typename T>
+class polymorphic_allocator {
+public:
+    // clang-format off
+    using value_type        = T;
+    using pointer           = T*;
+    using const_pointer     = const T*;
+    using reference         = T&;
+    using const_reference   = const T&;
+    using size_type         = size_t;
+    using difference_type   = ptrdiff_t;
+    // clang-format on
+
+    template <typename U>
+    struct rebind {
+        using other = polymorphic_allocator<U>;
+    };
+
+public:
+    polymorphic_allocator() noexcept
+        : resource_(get_default_resource()) {}
+
+    polymorphic_allocator(memory_resource* r) noexcept
+        : resource_(r) {
+        MYSTL_DEBUG(r != nullptr);
+    }
+
+    polymorphic_allocator(const polymorphic_allocator&) = default;
+
+    template <typename U>
+    polymorphic_allocator(const polymorphic_allocator<U>& other) noexcept
+        : resource_(other.resource()) {}
+
+    polymorphic_allocator& operator=(const polymorphic_allocator&) = default;
+
+public:
+    T* allocate(size_type n) {
+        THROW_LENGTH_ERROR_IF(n > static_cast<size_type>(-1) / sizeof(T),
+            "polymorphic_allocator<T>::allocate(n) n is too large");
+        return static_cast<T*>(resource_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_type n) {
+        resource_->deallocate(ptr, n * sizeof(T), alignof(T));
+    }
+
+    polymorphic_allocator select_on_container_copy_construction() const {
+        return polymorphic_allocator();
+    }
+
+    memory_resource* resource() const noexcept {
+        return resource_;
+    }
+
+private:
+    memory_resource* resource_;
+};
+
+template <typename T, typename U>
+bool operator==(
+    const polymorphic_allocator<T>& lhs, const polymorphic_allocator<U>& rhs) noexcept {
+    return *lhs.resource() == *rhs.resource();
+}
+
+template <typename T, typename U>
+bool operator!=(
+    const polymorphic_allocator<T>& lhs, const polymorphic_allocator<U>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+} // namespace pmr
+} // namespace mystl
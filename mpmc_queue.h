@@ -0,0 +1,296 @@
+#pragma once
+
+// 这个头文件包含一个模板类 mpmc_queue
+// mpmc_queue : 多生产者多消费者的有界无锁队列 (Vyukov 的有界队列)。
+//
+// 每个槽位带一个序号 seq，第 pos 次入队使用第 pos & mask 个槽位：
+// - seq == pos        槽位为空，可以写入第 pos 个元素，写完后 seq 改为 pos + 1
+// - seq == pos + 1    槽位中有第 pos 个元素，可以读出，读完后 seq 改为 pos + capacity
+// 生产者和消费者各自用一个原子计数 (CAS) 领取位置，之后只访问自己领到的槽位，
+// 不同位置上的入队和出队互不阻塞。两个计数放在不同的 cache 行上。
+//
+// try_ 系列在队列满 (或空) 时立即返回 false；push / pop 会一直重试，
+// 先自旋若干次，之后每次重试前让出 CPU。
+//
+// 领到位置后不能放弃，所以要求 T 的移动构造不抛出异常：
+// 构造可能抛出异常时先在槽位外构造好，领到位置后再移动进去。
+
+#include <atomic>
+#include <thread>
+
+#include "construct.h"
+#include "exceptdef.h"
+#include "memory.h"
+#include "memory_resource.h"
+#include "simd.h"
+#include "util.h"
+
+namespace mystl {
+
+enum { EMpmcSpinCount = 64 }; // push / pop 开始让出 CPU 之前自旋的次数
+
+template <typename T, typename Alloc = mystl::allocator<T>>
+class alignas(simd::ECacheLineSize) mpmc_queue {
+    static_assert(std::is_same<T, typename Alloc::value_type>::value,
+        "Alloc::value_type must be the same as T");
+    static_assert(std::is_nothrow_move_constructible<T>::value,
+        "mpmc_queue<T> requires T to be nothrow move constructible");
+
+public:
+    // clang-format off
+    using allocator_type    = Alloc;
+    using value_type        = T;
+    using reference         = value_type&;
+    using const_reference   = const value_type&;
+    using size_type         = size_t;
+    // clang-format on
+
+private:
+    struct cell {
+        std::atomic<size_type> seq;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() noexcept {
+            return reinterpret_cast<T*>(storage);
+        }
+    };
+
+    using cell_alloc_type = typename allocator_traits<allocator_type>::template rebind_alloc<cell>;
+    using cell_traits = mystl::allocator_traits<cell_alloc_type>;
+
+    // 构造后不再修改的部分
+    struct queue_impl : public cell_alloc_type {
+        cell* cells_;    // 槽位数组
+        size_type mask_; // 槽位数 - 1
+
+        explicit queue_impl(const allocator_type& a) noexcept
+            : cell_alloc_type(a)
+            , cells_(nullptr)
+            , mask_(0) {}
+    };
+
+    queue_impl impl_;
+
+    alignas(simd::ECacheLineSize) std::atomic<size_type> enqueue_pos_;
+    alignas(simd::ECacheLineSize) std::atomic<size_type> dequeue_pos_;
+
+public:
+    allocator_type get_allocator() const {
+        return allocator_type(static_cast<const cell_alloc_type&>(impl_));
+    }
+
+    // 容量向上取整为 2 的幂，至少为 2
+    explicit mpmc_queue(size_type capacity, const allocator_type& a = allocator_type());
+
+    mpmc_queue(const mpmc_queue&) = delete;
+    mpmc_queue& operator=(const mpmc_queue&) = delete;
+
+    ~mpmc_queue();
+
+public:
+    // 容量相关操作
+    size_type capacity() const noexcept {
+        return impl_.mask_ + 1;
+    }
+
+    // 其他线程同时在操作时只是一个近似值
+    size_type size_approx() const noexcept {
+        const size_type head = dequeue_pos_.load(std::memory_order_acquire);
+        const size_type tail = enqueue_pos_.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    // 入队
+
+    // 队列满时不构造元素，返回 false
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        return emplace_cat(std::is_nothrow_constructible<T, Args&&...>{},
+            mystl::forward<Args>(args)...);
+    }
+
+    bool try_push(const value_type& value) {
+        return try_emplace(value);
+    }
+
+    bool try_push(value_type&& value) {
+        return try_emplace(mystl::move(value));
+    }
+
+    // 队列满时一直等待
+    template <typename... Args>
+    void emplace(Args&&... args);
+
+    void push(const value_type& value) {
+        emplace(value);
+    }
+
+    void push(value_type&& value) {
+        emplace(mystl::move(value));
+    }
+
+    // 出队
+
+    // 把队首元素移动赋值给 value，队列为空时返回 false
+    bool try_pop(value_type& value) {
+        cell* c = acquire_for_pop();
+        if (c == nullptr)
+            return false;
+        value = take(c);
+        return true;
+    }
+
+    // 队列为空时一直等待
+    void pop(value_type& value);
+
+private:
+    // helper functions
+
+    // 领取一个空槽位，队列满时返回 nullptr
+    cell* acquire_for_push() noexcept;
+
+    // 领取一个有元素的槽位，队列为空时返回 nullptr
+    cell* acquire_for_pop() noexcept;
+
+    // 发布已经写入的槽位
+    void publish(cell* c, size_type pos) noexcept {
+        c->seq.store(pos + 1, std::memory_order_release);
+    }
+
+    // 移出槽位中的元素并析构，然后把槽位交还给生产者
+    value_type take(cell* c) noexcept {
+        value_type result(mystl::move(*c->value()));
+        mystl::destroy(c->value());
+        const size_type pos = c->seq.load(std::memory_order_relaxed) - 1;
+        c->seq.store(pos + capacity(), std::memory_order_release);
+        return result;
+    }
+
+    // 反复调用 fn 直到返回 true，自旋 EMpmcSpinCount 次之后每次重试前让出 CPU
+    template <typename Fn>
+    static void retry(Fn fn) {
+        for (size_type spin = 0; !fn(); ++spin) {
+            if (spin >= static_cast<size_type>(EMpmcSpinCount))
+                std::this_thread::yield();
+        }
+    }
+
+    // 构造不会抛出异常，领到位置后就地构造
+    template <typename... Args>
+    bool emplace_cat(std::true_type, Args&&... args) {
+        cell* c = acquire_for_push();
+        if (c == nullptr)
+            return false;
+        mystl::construct(c->value(), mystl::forward<Args>(args)...);
+        publish(c, c->seq.load(std::memory_order_relaxed));
+        return true;
+    }
+
+    // 构造可能抛出异常，先构造好再领取位置
+    template <typename... Args>
+    bool emplace_cat(std::false_type, Args&&... args) {
+        value_type tmp(mystl::forward<Args>(args)...);
+        return emplace_cat(std::true_type{}, mystl::move(tmp));
+    }
+};
+
+/*****************************************************************************************/
+
+template <typename T, typename Alloc>
+mpmc_queue<T, Alloc>::mpmc_queue(size_type capacity, const allocator_type& a)
+    : impl_(a)
+    , enqueue_pos_(0)
+    , dequeue_pos_(0) {
+    THROW_LENGTH_ERROR_IF(capacity > cell_traits::max_size(impl_) / 2,
+        "mpmc_queue<T>'s capacity too big");
+    size_type cap = 2;
+    while (cap < capacity) {
+        cap <<= 1;
+    }
+    impl_.cells_ = cell_traits::allocate(impl_, cap);
+    impl_.mask_ = cap - 1;
+    for (size_type i = 0; i < cap; ++i) {
+        mystl::construct(&impl_.cells_[i].seq, i);
+    }
+}
+
+// 析构时没有其他线程在访问，剩下的元素都在 [dequeue_pos_, enqueue_pos_) 中
+template <typename T, typename Alloc>
+mpmc_queue<T, Alloc>::~mpmc_queue() {
+    const size_type head = dequeue_pos_.load(std::memory_order_relaxed);
+    const size_type tail = enqueue_pos_.load(std::memory_order_relaxed);
+    for (size_type pos = head; pos != tail; ++pos) {
+        mystl::destroy(impl_.cells_[pos & impl_.mask_].value());
+    }
+    for (size_type i = 0; i < capacity(); ++i) {
+        mystl::destroy(&impl_.cells_[i].seq);
+    }
+    cell_traits::deallocate(impl_, impl_.cells_, capacity());
+}
+
+template <typename T, typename Alloc>
+template <typename... Args>
+void mpmc_queue<T, Alloc>::emplace(Args&&... args) {
+    if (std::is_nothrow_constructible<T, Args&&...>::value) {
+        // 参数只在领到位置后才被使用，失败的重试不会移走参数
+        retry([&] { return emplace_cat(std::true_type{}, mystl::forward<Args>(args)...); });
+    } else {
+        value_type tmp(mystl::forward<Args>(args)...);
+        retry([&] { return emplace_cat(std::true_type{}, mystl::move(tmp)); });
+    }
+}
+
+template <typename T, typename Alloc>
+void mpmc_queue<T, Alloc>::pop(value_type& value) {
+    retry([&] { return try_pop(value); });
+}
+
+/*****************************************************************************************/
+// helper function
+
+// seq 与 pos 的差按有符号数比较，计数回绕后仍然正确
+template <typename T, typename Alloc>
+typename mpmc_queue<T, Alloc>::cell* mpmc_queue<T, Alloc>::acquire_for_push() noexcept {
+    size_type pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+        cell* c = impl_.cells_ + (pos & impl_.mask_);
+        const size_type seq = c->seq.load(std::memory_order_acquire);
+        const auto diff = static_cast<ptrdiff_t>(seq - pos);
+        if (diff == 0) {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                return c;
+        } else if (diff < 0) {
+            return nullptr;
+        } else {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template <typename T, typename Alloc>
+typename mpmc_queue<T, Alloc>::cell* mpmc_queue<T, Alloc>::acquire_for_pop() noexcept {
+    size_type pos = dequeue_pos_.load(std::memory_order_relaxed);
+    for (;;) {
+        cell* c = impl_.cells_ + (pos & impl_.mask_);
+        const size_type seq = c->seq.load(std::memory_order_acquire);
+        const auto diff = static_cast<ptrdiff_t>(seq - (pos + 1));
+        if (diff == 0) {
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                return c;
+        } else if (diff < 0) {
+            return nullptr;
+        } else {
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+namespace pmr {
+
+// 使用 polymorphic_allocator 的 mpmc_queue
+template <typename T>
+using mpmc_queue = mystl::mpmc_queue<T, polymorphic_allocator<T>>;
+
+} // namespace pmr
+
+} // namespace mystl
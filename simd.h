@@ -0,0 +1,203 @@
+#pragma once
+
+// 这个头文件包含 mystl 算法使用的 SIMD 比较内核
+//
+// mismatch_bytes 返回两段内存中第一个不同字节的偏移，全部相同时返回长度。
+// x86-64 上在第一次调用时根据 CPU 选择 AVX2 或 SSE2 版本；其他平台，或者定义了
+// MYSTL_NO_SIMD 时，使用每次比较一个机器字的标量版本。
+//
+// stream_copy_bytes 使用非临时（流式）写入复制内存，写入的数据不经过 cache，
+// 用于远大于 cache 的批量复制，避免把其他线程的工作集挤出 LLC。写完后要调用 stream_fence。
+// 是否使用流式写入由 stream_threshold 决定，默认为 LLC 大小的一半，
+// 可以在编译时用 MYSTL_STREAM_THRESHOLD 指定，或用 set_stream_threshold 在运行时调整。
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if !defined(MYSTL_NO_SIMD) && defined(__x86_64__) && defined(__GNUC__)
+#define MYSTL_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace mystl {
+namespace simd {
+
+enum { ESimdMinBytes = 16 }; // 短于该长度时直接使用标量版本
+
+// 标量版本
+inline size_t mismatch_bytes_scalar(
+    const unsigned char* a, const unsigned char* b, size_t n) noexcept {
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t)) {
+        uint64_t x, y;
+        std::memcpy(&x, a + i, sizeof(x));
+        std::memcpy(&y, b + i, sizeof(y));
+        if (x != y)
+            break;
+    }
+    for (; i < n; ++i) {
+        if (a[i] != b[i])
+            return i;
+    }
+    return n;
+}
+
+#ifdef MYSTL_SIMD_X86
+
+// SSE2 版本，x86-64 上总是可用
+inline size_t mismatch_bytes_sse2(
+    const unsigned char* a, const unsigned char* b, size_t n) noexcept {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        const __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        const auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)));
+        if (mask != 0xffffu)
+            return i + static_cast<size_t>(__builtin_ctz(~mask));
+    }
+    return i + mismatch_bytes_scalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline __m256i avx2_cmpeq(
+    const unsigned char* a, const unsigned char* b) noexcept {
+    const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+    const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b));
+    return _mm256_cmpeq_epi8(x, y);
+}
+
+// AVX2 版本，每轮比较 64 bytes，尾部交给 SSE2 版本
+__attribute__((target("avx2"))) inline size_t mismatch_bytes_avx2(
+    const unsigned char* a, const unsigned char* b, size_t n) noexcept {
+    size_t i = 0;
+    for (; i + 64 <= n; i += 64) {
+        const __m256i lo = avx2_cmpeq(a + i, b + i);
+        const __m256i hi = avx2_cmpeq(a + i + 32, b + i + 32);
+        if (static_cast<unsigned>(_mm256_movemask_epi8(_mm256_and_si256(lo, hi))) !=
+            0xffffffffu)
+            break;
+    }
+    for (; i + 32 <= n; i += 32) {
+        const __m256i eq = avx2_cmpeq(a + i, b + i);
+        const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(eq));
+        if (mask != 0xffffffffu)
+            return i + static_cast<size_t>(__builtin_ctz(~mask));
+    }
+    return i + mismatch_bytes_sse2(a + i, b + i, n - i);
+}
+
+#endif // MYSTL_SIMD_X86
+
+using mismatch_bytes_fn = size_t (*)(const unsigned char*, const unsigned char*, size_t);
+
+inline mismatch_bytes_fn select_mismatch_bytes() noexcept {
+#ifdef MYSTL_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return &mismatch_bytes_avx2;
+    return &mismatch_bytes_sse2;
+#else
+    return &mismatch_bytes_scalar;
+#endif
+}
+
+inline size_t mismatch_bytes(const void* a, const void* b, size_t n) noexcept {
+    const auto pa = static_cast<const unsigned char*>(a);
+    const auto pb = static_cast<const unsigned char*>(b);
+    if (n < static_cast<size_t>(ESimdMinBytes))
+        return mismatch_bytes_scalar(pa, pb, n);
+    static const mismatch_bytes_fn fn = select_mismatch_bytes();
+    return fn(pa, pb, n);
+}
+
+/*****************************************************************************************/
+// cache 行
+/*****************************************************************************************/
+// 并发容器中由不同线程写入的数据按 cache 行对齐，避免伪共享
+enum { ECacheLineSize = 64 };
+
+/*****************************************************************************************/
+// 流式写入
+/*****************************************************************************************/
+enum { EDefaultCacheBytes = 8 << 20 }; // 无法取得 cache 大小时假定的 LLC 大小
+
+// 最后一级 cache 的大小，取不到 L3 时使用 L2
+inline size_t last_level_cache_bytes() noexcept {
+#if defined(_SC_LEVEL3_CACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE)
+    long bytes = ::sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (bytes <= 0)
+        bytes = ::sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if (bytes > 0)
+        return static_cast<size_t>(bytes);
+#endif
+    return static_cast<size_t>(EDefaultCacheBytes);
+}
+
+inline std::atomic<size_t>& stream_threshold_holder() noexcept {
+#ifdef MYSTL_STREAM_THRESHOLD
+    static std::atomic<size_t> threshold(MYSTL_STREAM_THRESHOLD);
+#else
+    static std::atomic<size_t> threshold(last_level_cache_bytes() / 2);
+#endif
+    return threshold;
+}
+
+// 写入的字节数不小于该值时使用流式写入
+inline size_t stream_threshold() noexcept {
+    return stream_threshold_holder().load(std::memory_order_relaxed);
+}
+
+// 设置流式写入的阈值，返回原来的阈值
+inline size_t set_stream_threshold(size_t bytes) noexcept {
+    return stream_threshold_holder().exchange(bytes, std::memory_order_relaxed);
+}
+
+// 把 src 上 n 个字节流式写入 dst，两者不能重叠。
+// 目标先用普通写入对齐到 16 bytes，中间部分每次写 16 bytes，尾部不足 16 bytes 的用普通写入
+inline void stream_copy_bytes(void* dst, const void* src, size_t n) noexcept {
+#ifdef MYSTL_SIMD_X86
+    auto d = static_cast<unsigned char*>(dst);
+    auto s = static_cast<const unsigned char*>(src);
+    const size_t head = (16 - (reinterpret_cast<uintptr_t>(d) & 15)) & 15;
+    if (n < head + 16) {
+        std::memcpy(d, s, n);
+        return;
+    }
+    std::memcpy(d, s, head);
+    d += head;
+    s += head;
+    n -= head;
+    for (; n >= 64; n -= 64, d += 64, s += 64) {
+        const __m128i x0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+        const __m128i x1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+        const __m128i x2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+        const __m128i x3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d), x0);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), x1);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), x2);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), x3);
+    }
+    for (; n >= 16; n -= 16, d += 16, s += 16) {
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d),
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+    }
+    std::memcpy(d, s, n);
+#else
+    std::memcpy(dst, src, n);
+#endif
+}
+
+// 流式写入是弱序的，之后的写入（例如发布数据的原子操作）之前必须调用
+inline void stream_fence() noexcept {
+#ifdef MYSTL_SIMD_X86
+    _mm_sfence();
+#endif
+}
+
+} // namespace simd
+} // namespace mystl
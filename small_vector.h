@@ -0,0 +1,57 @@
+#pragma once
+
+// 这个头文件包含一个模板类 small_vector
+// small_vector : 带有内联缓冲区的 vector，不超过 N 个元素时不申请堆空间，
+// 超出后按 vector 的增长策略搬到堆上。接口与 mystl::vector 相同，两者可以直接替换。
+// small_vector 就是以 vector_inline_storage 为存储方式的 vector，全部操作都由 vector 实现
+
+#include <initializer_list>
+
+#include "vector.h"
+
+namespace mystl {
+
+template <typename T, size_t N, typename Alloc = mystl::allocator<T>,
+    typename Growth = mystl::vector_growth_2x>
+class small_vector : public vector<T, Alloc, Growth, vector_inline_storage<T, N>> {
+    static_assert(N > 0, "small_vector needs at least one inline element");
+
+    using base_type = vector<T, Alloc, Growth, vector_inline_storage<T, N>>;
+
+public:
+    using typename base_type::size_type;
+    using typename base_type::value_type;
+
+    using base_type::base_type;
+
+    small_vector() = default;
+
+    small_vector& operator=(std::initializer_list<value_type> ilist) {
+        base_type::operator=(ilist);
+        return *this;
+    }
+
+    // 内联缓冲区能容纳的元素个数
+    static constexpr size_type inline_capacity() noexcept {
+        return N;
+    }
+
+    // 元素是否保存在内联缓冲区中
+    using base_type::is_inline;
+};
+
+// 重载 mystl 的 swap
+template <typename T, size_t N, typename Alloc, typename Growth>
+void swap(small_vector<T, N, Alloc, Growth>& lhs,
+    small_vector<T, N, Alloc, Growth>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+namespace pmr {
+
+template <typename T, size_t N>
+using small_vector = mystl::small_vector<T, N, polymorphic_allocator<T>>;
+
+} // namespace pmr
+
+} // namespace mystl
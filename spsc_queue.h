@@ -0,0 +1,317 @@
+#pragma once
+
+// 这个头文件包含一个模板类 spsc_queue
+// spsc_queue : 单生产者单消费者的有界无锁队列，所有操作都是 wait-free 的。
+//
+// 元素存放在一段大小为 2 的幂的环形空间中，head 和 tail 是不回绕的计数，下标与掩码按位与得到。
+// head 只由消费者写、tail 只由生产者写，两者放在不同的 cache 行上；
+// 每一方还缓存了对方上一次读到的计数，只有按缓存的值看起来满 (或空) 时才去读对方的原子变量，
+// 平时一次操作只访问自己的 cache 行。
+//
+// 同一时刻最多只能有一个线程调用生产者一侧的函数 (try_push 等)，
+// 最多一个线程调用消费者一侧的函数 (try_pop、front 等)。
+
+#include <atomic>
+
+#include "exceptdef.h"
+#include "memory.h"
+#include "memory_resource.h"
+#include "simd.h"
+#include "util.h"
+
+namespace mystl {
+
+template <typename T, typename Alloc = mystl::allocator<T>>
+class alignas(simd::ECacheLineSize) spsc_queue {
+    static_assert(std::is_same<T, typename Alloc::value_type>::value,
+        "Alloc::value_type must be the same as T");
+
+public:
+    // clang-format off
+    using allocator_type    = Alloc;
+    using alloc_traits      = mystl::allocator_traits<allocator_type>;
+
+    using value_type        = T;
+    using pointer           = typename alloc_traits::pointer;
+    using reference         = value_type&;
+    using const_reference   = const value_type&;
+    using size_type         = typename alloc_traits::size_type;
+    // clang-format on
+
+    allocator_type get_allocator() const {
+        return impl_;
+    }
+
+private:
+    // 构造后不再修改的部分，两个线程都只读
+    struct queue_impl : public allocator_type {
+        pointer buf_;     // 存放元素的空间
+        size_type mask_;  // 元素个数 - 1
+
+        explicit queue_impl(const allocator_type& a) noexcept
+            : allocator_type(a)
+            , buf_(nullptr)
+            , mask_(0) {}
+    };
+
+    queue_impl impl_;
+
+    // 消费者一侧
+    alignas(simd::ECacheLineSize) std::atomic<size_type> head_;
+    size_type tail_cache_;
+
+    // 生产者一侧
+    alignas(simd::ECacheLineSize) std::atomic<size_type> tail_;
+    size_type head_cache_;
+
+public:
+    // 容量向上取整为 2 的幂，至少为 1
+    explicit spsc_queue(size_type capacity, const allocator_type& a = allocator_type())
+        : impl_(a)
+        , head_(0)
+        , tail_cache_(0)
+        , tail_(0)
+        , head_cache_(0) {
+        THROW_LENGTH_ERROR_IF(capacity > alloc_traits::max_size(impl_) / 2,
+            "spsc_queue<T>'s capacity too big");
+        size_type cap = 1;
+        while (cap < capacity) {
+            cap <<= 1;
+        }
+        impl_.buf_ = alloc_traits::allocate(impl_, cap);
+        impl_.mask_ = cap - 1;
+    }
+
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+
+    ~spsc_queue() {
+        const size_type head = head_.load(std::memory_order_relaxed);
+        const size_type tail = tail_.load(std::memory_order_relaxed);
+        for (size_type i = head; i != tail; ++i) {
+            alloc_traits::destroy(impl_, impl_.buf_ + (i & impl_.mask_));
+        }
+        alloc_traits::deallocate(impl_, impl_.buf_, impl_.mask_ + 1);
+    }
+
+public:
+    // 容量相关操作
+    size_type capacity() const noexcept {
+        return impl_.mask_ + 1;
+    }
+
+    // 另一个线程同时在操作时只是一个近似值
+    size_type size_approx() const noexcept {
+        const size_type head = head_.load(std::memory_order_acquire);
+        const size_type tail = tail_.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    bool empty_approx() const noexcept {
+        return size_approx() == 0;
+    }
+
+    // 生产者一侧
+
+    // 队列满时不构造元素，返回 false
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        const size_type tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_cache_ == capacity()) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            if (tail - head_cache_ == capacity())
+                return false;
+        }
+        alloc_traits::construct(
+            impl_, impl_.buf_ + (tail & impl_.mask_), mystl::forward<Args>(args)...);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(const value_type& value) {
+        return try_emplace(value);
+    }
+
+    bool try_push(value_type&& value) {
+        return try_emplace(mystl::move(value));
+    }
+
+    // 复制 [first, first + n) 中能放下的前一部分，返回放入的个数。
+    // 元素最多分两段用 alloc_traits::construct 构造，全部构造完才一次发布给消费者
+    template <typename ForwardIter>
+    size_type try_push_n(ForwardIter first, size_type n);
+
+    // 消费者一侧
+
+    // 队首元素的地址，队列为空时返回 nullptr
+    value_type* front() noexcept {
+        const size_type head = head_.load(std::memory_order_relaxed);
+        if (head == tail_cache_) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            if (head == tail_cache_)
+                return nullptr;
+        }
+        return impl_.buf_ + (head & impl_.mask_);
+    }
+
+    // 弹出队首元素，队列不能为空 (front() 不为 nullptr)
+    void pop() noexcept {
+        const size_type head = head_.load(std::memory_order_relaxed);
+        MYSTL_DEBUG(head != tail_.load(std::memory_order_acquire));
+        alloc_traits::destroy(impl_, impl_.buf_ + (head & impl_.mask_));
+        head_.store(head + 1, std::memory_order_release);
+    }
+
+    // 把队首元素移动赋值给 value 后弹出，队列为空时返回 false
+    bool try_pop(value_type& value) {
+        value_type* p = front();
+        if (p == nullptr)
+            return false;
+        value = mystl::move(*p);
+        pop();
+        return true;
+    }
+
+    // 最多弹出 n 个元素，移动赋值到以 result 为起始处的区间，返回弹出的个数
+    template <typename OutputIter>
+    size_type try_pop_n(OutputIter result, size_type n);
+
+    // 最多弹出 n 个元素，搬到以 result 为起始处的未初始化空间，返回弹出的个数。
+    // 使用 uninitialized_relocate，可平凡重定位的类型按 memmove 搬动；
+    // 第二段抛出异常时，已经搬出的第一段被析构，只弹出第一段
+    size_type try_pop_uninitialized_n(value_type* result, size_type n);
+
+private:
+    // helper functions
+
+    // 队列中的元素都经过 alloc_traits::construct / alloc_traits::destroy 构造和析构
+
+    // 在 dst 开始的 n 个位置上复制 first 开始的元素，返回下一个输入位置，
+    // 抛出异常时析构已经构造的元素
+    template <typename ForwardIter>
+    ForwardIter construct_n(ForwardIter first, size_type n, pointer dst) {
+        size_type i = 0;
+        try {
+            for (; i < n; ++i, ++first) {
+                alloc_traits::construct(impl_, dst + i, *first);
+            }
+        } catch (...) {
+            destroy_range(dst, dst + i);
+            throw;
+        }
+        return first;
+    }
+
+    void destroy_range(pointer first, pointer last) noexcept {
+        for (; first != last; ++first) {
+            alloc_traits::destroy(impl_, first);
+        }
+    }
+
+    // 把 [first, last) 搬到 result 开始的未初始化空间，可平凡重定位的类型按 memmove 搬动
+    value_type* relocate_out(pointer first, pointer last, value_type* result) {
+        if (mystl::is_trivially_relocatable<T>::value)
+            return mystl::uninitialized_relocate(first, last, result);
+        value_type* cur = mystl::uninitialized_move(first, last, result);
+        destroy_range(first, last);
+        return cur;
+    }
+
+    // 生产者最多可以写入的个数
+    size_type free_for_push(size_type tail, size_type n) noexcept {
+        if (capacity() - (tail - head_cache_) < n)
+            head_cache_ = head_.load(std::memory_order_acquire);
+        const size_type room = capacity() - (tail - head_cache_);
+        return n < room ? n : room;
+    }
+
+    // 消费者最多可以读出的个数
+    size_type ready_for_pop(size_type head, size_type n) noexcept {
+        if (tail_cache_ - head < n)
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+        const size_type ready = tail_cache_ - head;
+        return n < ready ? n : ready;
+    }
+
+    // 从 pos 开始的 n 个元素在空间中的第一段的长度
+    size_type first_span(size_type pos, size_type n) const noexcept {
+        const size_type to_end = capacity() - (pos & impl_.mask_);
+        return n < to_end ? n : to_end;
+    }
+};
+
+/*****************************************************************************************/
+
+template <typename T, typename Alloc>
+template <typename ForwardIter>
+typename spsc_queue<T, Alloc>::size_type spsc_queue<T, Alloc>::try_push_n(
+    ForwardIter first, size_type n) {
+    const size_type tail = tail_.load(std::memory_order_relaxed);
+    n = free_for_push(tail, n);
+    if (n == 0)
+        return 0;
+    const size_type n1 = first_span(tail, n);
+    pointer dst = impl_.buf_ + (tail & impl_.mask_);
+    first = construct_n(first, n1, dst);
+    if (n1 != n) {
+        try {
+            construct_n(first, n - n1, impl_.buf_);
+        } catch (...) {
+            destroy_range(dst, dst + n1);
+            throw;
+        }
+    }
+    tail_.store(tail + n, std::memory_order_release);
+    return n;
+}
+
+// 移动赋值抛出异常时不弹出任何元素，已经移动过的元素留在队列中
+template <typename T, typename Alloc>
+template <typename OutputIter>
+typename spsc_queue<T, Alloc>::size_type spsc_queue<T, Alloc>::try_pop_n(
+    OutputIter result, size_type n) {
+    const size_type head = head_.load(std::memory_order_relaxed);
+    n = ready_for_pop(head, n);
+    if (n == 0)
+        return 0;
+    const size_type n1 = first_span(head, n);
+    pointer src = impl_.buf_ + (head & impl_.mask_);
+    result = mystl::move(src, src + n1, result);
+    mystl::move(impl_.buf_, impl_.buf_ + (n - n1), result);
+    destroy_range(src, src + n1);
+    destroy_range(impl_.buf_, impl_.buf_ + (n - n1));
+    head_.store(head + n, std::memory_order_release);
+    return n;
+}
+
+template <typename T, typename Alloc>
+typename spsc_queue<T, Alloc>::size_type spsc_queue<T, Alloc>::try_pop_uninitialized_n(
+    value_type* result, size_type n) {
+    const size_type head = head_.load(std::memory_order_relaxed);
+    n = ready_for_pop(head, n);
+    if (n == 0)
+        return 0;
+    const size_type n1 = first_span(head, n);
+    pointer src = impl_.buf_ + (head & impl_.mask_);
+    value_type* mid = relocate_out(src, src + n1, result);
+    try {
+        relocate_out(impl_.buf_, impl_.buf_ + (n - n1), mid);
+    } catch (...) {
+        // 第一段已经离开队列，丢弃后只弹出第一段
+        destroy_range(result, mid);
+        head_.store(head + n1, std::memory_order_release);
+        throw;
+    }
+    head_.store(head + n, std::memory_order_release);
+    return n;
+}
+
+namespace pmr {
+
+// 使用 polymorphic_allocator 的 spsc_queue
+template <typename T>
+using spsc_queue = mystl::spsc_queue<T, polymorphic_allocator<T>>;
+
+} // namespace pmr
+
+} // namespace mystl
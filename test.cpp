@@ -1,12 +1,106 @@
+#include <cassert>
 #include <cstddef>
 #include <iostream>
 #include <new>
+#include <string>
 #include <vector>
 
+#include "concurrent_vector.h"
+#include "small_vector.h"
+#include "vector.h"
+
 using namespace std;
 
+// vector / small_vector::erase 传入空区间时不应改变任何元素
+template <class Vec>
+void test_vector_erase_empty_range() {
+    const string a(40, 'a'), b(40, 'b'), c(40, 'c');
+    Vec v;
+    v.push_back(a);
+    v.push_back(b);
+    v.push_back(c);
+    auto it = v.erase(v.begin() + 1, v.begin() + 1);
+    assert(it == v.begin() + 1);
+    assert(v.size() == 3 && v[0] == a && v[1] == b && v[2] == c);
+    it = v.erase(v.end(), v.end());
+    assert(it == v.end() && v.size() == 3);
+}
+
+// 剩余的申请次数，为负时不限制，为 0 时 allocate 抛出 bad_alloc
+int alloc_budget = -1;
+
+template <class T>
+struct budget_allocator {
+    using value_type = T;
+
+    budget_allocator() = default;
+
+    template <class U>
+    budget_allocator(const budget_allocator<U>&) noexcept {}
+
+    T* allocate(size_t n) {
+        if (alloc_budget == 0)
+            throw bad_alloc();
+        if (alloc_budget > 0)
+            --alloc_budget;
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, size_t) noexcept {
+        ::operator delete(p);
+    }
+
+    bool operator==(const budget_allocator&) const noexcept {
+        return true;
+    }
+    bool operator!=(const budget_allocator&) const noexcept {
+        return false;
+    }
+};
+
+// concurrent_vector 追加时段分配失败，size() 不变，容器仍然可以使用和析构
+void test_concurrent_vector_alloc_failure() {
+    const string y(30, 'y');
+    mystl::concurrent_vector<string, budget_allocator<string>> v;
+    v.push_back("a");
+
+    alloc_budget = 1; // 只够 grow_by 的临时 vector
+    try {
+        v.grow_by(100, y);
+        assert(false);
+    } catch (const bad_alloc&) {
+    }
+    assert(v.size() == 1);
+
+    alloc_budget = 0;
+    try {
+        v.grow_to_at_least(100);
+        assert(false);
+    } catch (const bad_alloc&) {
+    }
+    assert(v.size() == 1);
+
+    while (v.size() < 16) {
+        v.push_back(y); // 第 0 段中还有位置，不需要申请
+    }
+    try {
+        v.push_back(y);
+        assert(false);
+    } catch (const bad_alloc&) {
+    }
+    assert(v.size() == 16);
+
+    alloc_budget = -1;
+    v.grow_by(100, y);
+    assert(v.size() == 116 && v[0] == "a" && v[115] == y);
+}
+
 int main() {
     vector<int> a{};
 
+    test_vector_erase_empty_range<mystl::vector<string>>();
+    test_vector_erase_empty_range<mystl::small_vector<string, 4>>();
+    test_vector_erase_empty_range<mystl::small_vector<string, 2>>();
+    test_concurrent_vector_alloc_failure();
     return 0;
 }
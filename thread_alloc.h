@@ -0,0 +1,165 @@
+#pragma once
+
+// 这个头文件包含一个类 thread_alloc，作为 alloc 内存池的线程缓存前端
+//
+// 每个线程为每个大小级别保存一条私有的自由链表，分配和回收都只访问本线程的缓存，
+// 不需要加锁。缓存为空时一次从 alloc 批量取出一批块；缓存过长时把一批块归还 alloc，
+// 线程退出时把缓存的块全部归还。
+// 块在各个线程之间没有归属关系，其他线程分配的块直接挂到当前线程的缓存上，
+// 跨线程释放同样不需要加锁，多出来的块会在缓存过长时回到 alloc 供其他线程使用。
+
+#include <cstddef>
+#include <cstring>
+#include <new>
+
+#include "alloc.h"
+
+namespace mystl {
+
+class thread_alloc {
+private:
+    struct cache_list {
+        FreeList* head;    // 缓存的块
+        size_t length;     // 缓存的块数
+    };
+
+    struct thread_cache {
+        cache_list lists[EFreeListsNumber];
+
+        thread_cache() noexcept {
+            std::memset(lists, 0, sizeof(lists));
+        }
+
+        ~thread_cache() {
+            thread_alloc::M_release_all(*this);
+            thread_alloc::M_dead() = true;
+        }
+    };
+
+public:
+    static void* allocate(size_t n);
+    static void deallocate(void* p, size_t n);
+    static void* reallocate(void* p, size_t old_size, size_t new_size);
+
+    // 分配清零的空间，含义同 alloc::allocate_zeroed
+    static void* allocate_zeroed(size_t n);
+
+    static size_t usable_size(void* p, size_t n) noexcept {
+        return alloc::usable_size(p, n);
+    }
+
+    // 把当前线程缓存的块全部归还给 alloc
+    static void flush();
+
+private:
+    static thread_cache& M_cache();
+    static bool& M_dead();
+    static void M_release(cache_list& list, size_t size, size_t count);
+    static void M_release_all(thread_cache& cache);
+};
+
+// 线程缓存在线程退出时析构，之后同一线程上的请求直接交给 alloc
+inline thread_alloc::thread_cache& thread_alloc::M_cache() {
+    static thread_local thread_cache cache;
+    return cache;
+}
+
+inline bool& thread_alloc::M_dead() {
+    static thread_local bool dead = false;
+    return dead;
+}
+
+// 分配大小为 n 的空间
+inline void* thread_alloc::allocate(size_t n) {
+    if (!alloc::is_small(n) || M_dead())
+        return alloc::allocate(n);
+
+    cache_list& list = M_cache().lists[alloc::freelist_index(n)];
+    if (list.head == nullptr) {
+        list.length = alloc::allocate_batch(n, alloc::refill_number(n), list.head);
+    }
+    FreeList* result = list.head;
+    list.head = result->next;
+    --list.length;
+    return result;
+}
+
+inline void* thread_alloc::allocate_zeroed(size_t n) {
+    if (!alloc::is_small(n))
+        return alloc::allocate_zeroed(n);
+    void* p = allocate(n);
+    std::memset(p, 0, alloc::round_up(n));
+    return p;
+}
+
+// 释放 p 指向的大小为 n 的空间
+inline void thread_alloc::deallocate(void* p, size_t n) {
+    if (p == nullptr)
+        return;
+    if (!alloc::is_small(n) || M_dead()) {
+        alloc::deallocate(p, n);
+        return;
+    }
+
+    cache_list& list = M_cache().lists[alloc::freelist_index(n)];
+    FreeList* q = static_cast<FreeList*>(p);
+    q->next = list.head;
+    list.head = q;
+    ++list.length;
+
+    // 缓存超过两批时归还一批，避免只释放不分配的线程囤积内存
+    const size_t batch = alloc::refill_number(n);
+    if (list.length > batch * 2) {
+        M_release(list, n, batch);
+    }
+}
+
+// 重新分配空间，参数含义同 alloc::reallocate
+inline void* thread_alloc::reallocate(void* p, size_t old_size, size_t new_size) {
+    if (p == nullptr)
+        return allocate(new_size);
+    if (!alloc::is_small(old_size) && !alloc::is_small(new_size))
+        return alloc::reallocate(p, old_size, new_size);
+    if (alloc::is_small(old_size) && alloc::is_small(new_size) &&
+        alloc::round_up(old_size) == alloc::round_up(new_size))
+        return p;
+
+    void* result = allocate(new_size);
+    std::memcpy(result, p, old_size < new_size ? old_size : new_size);
+    deallocate(p, old_size);
+    return result;
+}
+
+inline void thread_alloc::flush() {
+    if (!M_dead())
+        M_release_all(M_cache());
+}
+
+// 从链表头部摘下 count 个块归还给 alloc
+inline void thread_alloc::M_release(cache_list& list, size_t size, size_t count) {
+    if (count > list.length)
+        count = list.length;
+    if (count == 0)
+        return;
+    FreeList* head = list.head;
+    FreeList* tail = head;
+    for (size_t i = 1; i < count; ++i) {
+        tail = tail->next;
+    }
+    list.head = tail->next;
+    list.length -= count;
+    alloc::deallocate_batch(size, head, tail);
+}
+
+inline void thread_alloc::M_release_all(thread_cache& cache) {
+    // 第 i 条链表中任意一块的大小都落在同一级别，用该级别的最小值即可定位
+    size_t size = 1;
+    for (size_t i = 0; i < EFreeListsNumber; ++i) {
+        while (alloc::freelist_index(size) < i) {
+            ++size;
+        }
+        M_release(cache.lists[i], size, cache.lists[i].length);
+    }
+}
+
+} // namespace mystl
@@ -1,7 +1,27 @@
 #pragma once
 
+#include <type_traits>
+
+// C++20 起容器和算法可以在常量表达式中使用，更早的标准下 MYSTL_CONSTEXPR20 为空
+#if __cplusplus >= 202002L && defined(__cpp_constexpr_dynamic_alloc) && \
+    defined(__cpp_lib_is_constant_evaluated)
+#define MYSTL_HAS_CONSTEXPR20 1
+#define MYSTL_CONSTEXPR20 constexpr
+#else
+#define MYSTL_CONSTEXPR20
+#endif
+
 namespace mystl {
 
+// 是否处于常量求值中，常量求值时不能使用 memmove 等函数、内存池和 SIMD 指令
+constexpr bool is_constant_evaluated() noexcept {
+#ifdef MYSTL_HAS_CONSTEXPR20
+    return std::is_constant_evaluated();
+#else
+    return false;
+#endif
+}
+
 template <typename T, T v>
 struct m_integral_constant {
     static constexpr T value = v;
@@ -13,6 +33,51 @@ using m_bool_constant = m_integral_constant<bool, b>;
 using m_true_type = m_bool_constant<true>;
 using m_false_type = m_bool_constant<false>;
 
+// 任意类型映射为 void，用于检测某个成员类型或表达式是否合法
+template <typename... Ts>
+struct m_make_void {
+    using type = void;
+};
+
+template <typename... Ts>
+using m_void_t = typename m_make_void<Ts...>::type;
+
+// is_trivially_relocatable
+// 对象可以按字节搬到新的地址，并且搬动后不需要再调用原对象的析构函数
+// 平凡可复制的类型天然满足；其他类型（如只持有一个指针的句柄类）可以特化为 m_true_type 来开启
+template <typename T>
+struct is_trivially_relocatable : m_bool_constant<std::is_trivially_copyable<T>::value> {};
+
+// is_zero_initializable
+// 值初始化的结果是全 0 字节，可以直接使用清零的内存而不需要逐个构造
+// 默认只包括算术、枚举和普通指针类型（成员指针的空值不是全 0）；
+// 只由这些成员组成的平凡类可以特化为 m_true_type 来开启
+template <typename T>
+struct is_zero_initializable
+    : m_bool_constant<std::is_scalar<T>::value && !std::is_member_pointer<T>::value> {};
+
+// is_transparent
+// 比较函数或哈希函数定义了 is_transparent 时，关联容器的查找类函数可以接受与键类型不同的参数
+template <typename T, typename = void>
+struct is_transparent : m_false_type {};
+
+template <typename T>
+struct is_transparent<T, m_void_t<typename T::is_transparent>> : m_true_type {};
+
+// key_arg_helper<Transparent>::type<K, Key> 在 Transparent 为真时为 K，否则为 Key
+// 使用别名模板而不是嵌套类型，查找函数的参数 const type<K, Key>& 仍然可以推导出 K
+template <bool Transparent>
+struct key_arg_helper {
+    template <typename K, typename Key>
+    using type = Key;
+};
+
+template <>
+struct key_arg_helper<true> {
+    template <typename K, typename Key>
+    using type = K;
+};
+
 template <typename T1, typename T2>
 struct pair;
 
@@ -1,25 +1,96 @@
 #pragma once
 
+#include <cstring>
+#include <memory>
+
 #include "algobase.h"
 #include "construct.h"
 #include "iterator.h"
+#include "simd.h"
 #include "type_traits.h"
 #include "util.h"
 
 namespace mystl {
 
+/*******************************************************************************/
+// 流式写入
+// 可平凡复制类型的指针区间，写入的字节数不小于 simd::stream_threshold() 时
+// 使用不经过 cache 的流式写入，新构造的大块数据不会把 LLC 中其他线程的数据挤出去
+/*******************************************************************************/
+template <class InputIter, class ForwardIter>
+struct is_stream_copyable : m_false_type {};
+
+template <class Tp, class Up>
+struct is_stream_copyable<Tp*, Up*>
+    : m_bool_constant<std::is_same<typename std::remove_const<Tp>::type, Up>::value &&
+                      std::is_trivially_copyable<Up>::value> {};
+
+// 填充的值与元素类型相同，或者都是算术类型
+template <class ForwardIter, class T>
+struct is_stream_fillable : m_false_type {};
+
+template <class Up, class T>
+struct is_stream_fillable<Up*, T>
+    : m_bool_constant<std::is_trivially_copyable<Up>::value &&
+                      !std::is_const<Up>::value &&
+                      (std::is_same<typename std::remove_cv<T>::type, Up>::value ||
+                          (std::is_arithmetic<T>::value && std::is_arithmetic<Up>::value))> {};
+
+template <class T>
+bool use_stream_store(size_t n) noexcept {
+    return n >= simd::stream_threshold() / sizeof(T);
+}
+
+template <class Tp, class Up>
+Up* stream_uninit_copy(Tp* first, size_t n, Up* result) noexcept {
+    simd::stream_copy_bytes(result, first, n * sizeof(Up));
+    simd::stream_fence();
+    return result + n;
+}
+
+// 先用普通写入填好开头的一段，再把这一段反复流式复制到后面。
+// 这一段的字节数是 16 的倍数，所以每次复制的目标与 first 的对齐方式相同
+template <class Up>
+Up* stream_uninit_fill_n(Up* first, size_t n, const Up& value) noexcept {
+    const size_t seed = 16 * (sizeof(Up) < 256 ? 256 / sizeof(Up) : 1);
+    if (n <= seed)
+        return mystl::fill_n(first, n, value);
+    mystl::fill_n(first, seed, value);
+    for (size_t i = seed; i < n; i += seed) {
+        const size_t m = n - i < seed ? n - i : seed;
+        simd::stream_copy_bytes(first + i, first, m * sizeof(Up));
+    }
+    simd::stream_fence();
+    return first + n;
+}
+
 /*******************************************************************************/
 // uninitialized_copy
 // 把 [first, last) 上的内容复制到以 result 为起始处的空间，返回复制结束的位置
 /*******************************************************************************/
 template <typename InputIter, typename ForwardIter>
-ForwardIter unchecked_uninit_copy(
-    InputIter first, InputIter last, ForwardIter result, std::true_type) {
+ForwardIter uninit_copy_stream_cat(
+    InputIter first, InputIter last, ForwardIter result, m_false_type) {
+    return mystl::copy(first, last, result);
+}
+
+template <typename Tp, typename Up>
+Up* uninit_copy_stream_cat(Tp* first, Tp* last, Up* result, m_true_type) {
+    const auto n = static_cast<size_t>(last - first);
+    if (n != 0 && use_stream_store<Up>(n))
+        return mystl::stream_uninit_copy(first, n, result);
     return mystl::copy(first, last, result);
 }
 
 template <typename InputIter, typename ForwardIter>
 ForwardIter unchecked_uninit_copy(
+    InputIter first, InputIter last, ForwardIter result, std::true_type) {
+    return mystl::uninit_copy_stream_cat(
+        first, last, result, is_stream_copyable<InputIter, ForwardIter>{});
+}
+
+template <typename InputIter, typename ForwardIter>
+MYSTL_CONSTEXPR20 ForwardIter unchecked_uninit_copy(
     InputIter first, InputIter last, ForwardIter result, std::false_type) {
     auto cur = result;
     try {
@@ -30,12 +101,16 @@ ForwardIter unchecked_uninit_copy(
         for (; result != cur; ++result) {
             mystl::destroy(&(*result));
         }
+        throw;
     }
     return cur;
 }
 
 template <class InputIter, class ForwardIter>
-ForwardIter uninitialized_copy(InputIter first, InputIter last, ForwardIter result) {
+MYSTL_CONSTEXPR20 ForwardIter uninitialized_copy(
+    InputIter first, InputIter last, ForwardIter result) {
+    if (mystl::is_constant_evaluated())
+        return mystl::unchecked_uninit_copy(first, last, result, std::false_type{});
     return mystl::unchecked_uninit_copy(first, last, result,
         std::is_trivially_copy_assignable<
             typename iterator_traits<ForwardIter>::value_type>{});
@@ -45,14 +120,28 @@ ForwardIter uninitialized_copy(InputIter first, InputIter last, ForwardIter resu
 // uninitialized_copy_n
 // 把 [first, first + n) 上的内容复制到以 result 为起始处的空间，返回复制结束的位置
 /******************************************************************************/
+template <typename InputIter, typename Size, typename ForwardIter>
+ForwardIter uninit_copy_n_stream_cat(
+    InputIter first, Size n, ForwardIter result, m_false_type) {
+    return mystl::copy_n(first, n, result).second;
+}
+
+template <typename Tp, typename Size, typename Up>
+Up* uninit_copy_n_stream_cat(Tp* first, Size n, Up* result, m_true_type) {
+    if (n > 0 && use_stream_store<Up>(static_cast<size_t>(n)))
+        return mystl::stream_uninit_copy(first, static_cast<size_t>(n), result);
+    return mystl::copy_n(first, n, result).second;
+}
+
 template <typename InputIter, typename Size, typename ForwardIter>
 ForwardIter unchecked_uninit_copy_n(
     InputIter first, Size n, ForwardIter result, std::true_type) {
-    return mystl::copy_n(first, n, result);
+    return mystl::uninit_copy_n_stream_cat(
+        first, n, result, is_stream_copyable<InputIter, ForwardIter>{});
 }
 
 template <typename InputIter, typename Size, typename ForwardIter>
-ForwardIter unchecked_uninit_copy_n(
+MYSTL_CONSTEXPR20 ForwardIter unchecked_uninit_copy_n(
     InputIter first, Size n, ForwardIter result, std::false_type) {
     auto cur = result;
     try {
@@ -63,11 +152,16 @@ ForwardIter unchecked_uninit_copy_n(
         for (; result != cur; ++result) {
             mystl::destroy(&(*result));
         }
+        throw;
     }
+    return cur;
 }
 
 template <typename InputIter, typename Size, typename ForwardIter>
-ForwardIter uninitialized_copy_n(InputIter first, Size n, ForwardIter result) {
+MYSTL_CONSTEXPR20 ForwardIter uninitialized_copy_n(
+    InputIter first, Size n, ForwardIter result) {
+    if (mystl::is_constant_evaluated())
+        return mystl::unchecked_uninit_copy_n(first, n, result, std::false_type{});
     return mystl::unchecked_uninit_copy_n(first, n, result,
         std::is_trivially_copy_assignable<
             typename iterator_traits<ForwardIter>::value_type>{});
@@ -78,13 +172,30 @@ ForwardIter uninitialized_copy_n(InputIter first, Size n, ForwardIter result) {
 // 在 [first, last) 区间内填充元素值
 /*******************************************************************************/
 template <typename ForwardIter, typename T>
-void unchecked_uninit_fill(
-    ForwardIter first, ForwardIter last, const T& value, std::true_type) {
+void uninit_fill_stream_cat(
+    ForwardIter first, ForwardIter last, const T& value, m_false_type) {
+    mystl::fill(first, last, value);
+}
+
+template <typename Up, typename T>
+void uninit_fill_stream_cat(Up* first, Up* last, const T& value, m_true_type) {
+    const auto n = static_cast<size_t>(last - first);
+    if (n != 0 && use_stream_store<Up>(n)) {
+        mystl::stream_uninit_fill_n(first, n, static_cast<Up>(value));
+        return;
+    }
     mystl::fill(first, last, value);
 }
 
 template <typename ForwardIter, typename T>
 void unchecked_uninit_fill(
+    ForwardIter first, ForwardIter last, const T& value, std::true_type) {
+    mystl::uninit_fill_stream_cat(
+        first, last, value, is_stream_fillable<ForwardIter, T>{});
+}
+
+template <typename ForwardIter, typename T>
+MYSTL_CONSTEXPR20 void unchecked_uninit_fill(
     ForwardIter first, ForwardIter last, const T& value, std::false_type) {
     auto cur = first;
     try {
@@ -95,11 +206,17 @@ void unchecked_uninit_fill(
         for (; first != cur; ++first) {
             mystl::destroy(&(*first));
         }
+        throw;
     }
 }
 
 template <typename ForwardIter, typename T>
-void uninitialized_fill(ForwardIter first, ForwardIter last, const T& value) {
+MYSTL_CONSTEXPR20 void uninitialized_fill(
+    ForwardIter first, ForwardIter last, const T& value) {
+    if (mystl::is_constant_evaluated()) {
+        mystl::unchecked_uninit_fill(first, last, value, std::false_type{});
+        return;
+    }
     mystl::unchecked_uninit_fill(first, last, value,
         std::is_trivially_copy_assignable<
             typename iterator_traits<ForwardIter>::value_type>{});
@@ -110,13 +227,29 @@ void uninitialized_fill(ForwardIter first, ForwardIter last, const T& value) {
 // 从 first 位置开始，填充 n 个元素值，返回填充结束的位置
 /******************************************************************************/
 template <typename ForwardIter, typename Size, typename T>
-ForwardIter unchecked_uninit_fill_n(
-    ForwardIter first, Size n, const T& value, std::true_type) {
+ForwardIter uninit_fill_n_stream_cat(
+    ForwardIter first, Size n, const T& value, m_false_type) {
+    return mystl::fill_n(first, n, value);
+}
+
+template <typename Up, typename Size, typename T>
+Up* uninit_fill_n_stream_cat(Up* first, Size n, const T& value, m_true_type) {
+    if (n > 0 && use_stream_store<Up>(static_cast<size_t>(n))) {
+        return mystl::stream_uninit_fill_n(
+            first, static_cast<size_t>(n), static_cast<Up>(value));
+    }
     return mystl::fill_n(first, n, value);
 }
 
 template <typename ForwardIter, typename Size, typename T>
 ForwardIter unchecked_uninit_fill_n(
+    ForwardIter first, Size n, const T& value, std::true_type) {
+    return mystl::uninit_fill_n_stream_cat(
+        first, n, value, is_stream_fillable<ForwardIter, T>{});
+}
+
+template <typename ForwardIter, typename Size, typename T>
+MYSTL_CONSTEXPR20 ForwardIter unchecked_uninit_fill_n(
     ForwardIter first, Size n, const T& value, std::false_type) {
     auto cur = first;
     try {
@@ -127,13 +260,17 @@ ForwardIter unchecked_uninit_fill_n(
         for (; first != cur; ++first) {
             mystl::destroy(&(*first));
         }
+        throw;
     }
 
     return cur;
 }
 
 template <typename ForwardIter, typename Size, typename T>
-ForwardIter uninitialized_fill_n(ForwardIter first, Size n, const T& value) {
+MYSTL_CONSTEXPR20 ForwardIter uninitialized_fill_n(
+    ForwardIter first, Size n, const T& value) {
+    if (mystl::is_constant_evaluated())
+        return mystl::unchecked_uninit_fill_n(first, n, value, std::false_type{});
     return unchecked_uninit_fill_n(first, n, value,
         std::is_trivially_copy_assignable<
             typename iterator_traits<ForwardIter>::value_type>{});
@@ -150,24 +287,30 @@ ForwardIter unchecked_uninit_move(
 }
 
 template <typename InputIter, typename ForwardIter>
-ForwardIter unchecked_uninit_move(
+MYSTL_CONSTEXPR20 ForwardIter unchecked_uninit_move(
     InputIter first, InputIter last, ForwardIter result, std::false_type) {
     auto cur = result;
     try {
-        for (; first != last; ++first) {
+        for (; first != last; ++first, ++cur) {
             mystl::construct(&(*cur), mystl::move(*first));
         }
     } catch (...) {
         for (; result != cur; ++result) {
             mystl::destroy(&(*result));
         }
+        throw;
     }
+    return cur;
 }
 
 template <typename InputIter, typename ForwardIter>
-ForwardIter uninitialized_move(InputIter first, InputIter last, ForwardIter result) {
+MYSTL_CONSTEXPR20 ForwardIter uninitialized_move(
+    InputIter first, InputIter last, ForwardIter result) {
+    if (mystl::is_constant_evaluated())
+        return mystl::unchecked_uninit_move(first, last, result, std::false_type{});
     return mystl::unchecked_uninit_move(first, last, result,
-        std::is_trivially_move_assignable<typename iterator_traits<InputIter>::value>{});
+        std::is_trivially_move_assignable<
+            typename iterator_traits<InputIter>::value_type>{});
 }
 
 /*******************************************************************************/
@@ -181,7 +324,7 @@ ForwardIter unchecked_uninit_move_n(
 }
 
 template <typename InputIter, typename Size, typename ForwardIter>
-ForwardIter unchecked_uninit_move_n(
+MYSTL_CONSTEXPR20 ForwardIter unchecked_uninit_move_n(
     InputIter first, Size n, ForwardIter result, std::false_type) {
     auto cur = result;
     try {
@@ -191,18 +334,264 @@ ForwardIter unchecked_uninit_move_n(
     } catch (...) {
         for (; result != cur; ++result) {
             mystl::destroy(&(*result));
-            throw;
         }
+        throw;
     }
 
     return cur;
 }
 
 template <typename InputIter, typename Size, typename ForwardIter>
-ForwardIter uninitialized_move_n(InputIter first, Size n, ForwardIter result) {
-    return mystl::unchecked_uninit_move(first, n, result,
+MYSTL_CONSTEXPR20 ForwardIter uninitialized_move_n(
+    InputIter first, Size n, ForwardIter result) {
+    if (mystl::is_constant_evaluated())
+        return mystl::unchecked_uninit_move_n(first, n, result, std::false_type{});
+    return mystl::unchecked_uninit_move_n(first, n, result,
         std::is_trivially_move_assignable<
             typename iterator_traits<InputIter>::value_type>{});
 }
 
+/*******************************************************************************/
+// uninitialized_default_construct_n
+// 从 first 位置开始默认初始化 n 个对象，返回结束的位置。
+// 可平凡默认构造的类型不写入任何内容，对象的值不确定
+/*******************************************************************************/
+template <typename ForwardIter, typename Size>
+ForwardIter unchecked_uninit_default_n(ForwardIter first, Size n, std::true_type) {
+    mystl::advance(first, n);
+    return first;
+}
+
+template <typename ForwardIter, typename Size>
+MYSTL_CONSTEXPR20 ForwardIter unchecked_uninit_default_n(
+    ForwardIter first, Size n, std::false_type) {
+    using value_type = typename iterator_traits<ForwardIter>::value_type;
+    auto cur = first;
+    try {
+        for (; n > 0; --n, ++cur) {
+            // 常量求值中不能使用 placement new，也不允许读取不确定的值，改为值初始化
+            if (mystl::is_constant_evaluated())
+                mystl::construct(&(*cur));
+            else
+                ::new (static_cast<void*>(&(*cur))) value_type;
+        }
+    } catch (...) {
+        for (; first != cur; ++first) {
+            mystl::destroy(&(*first));
+        }
+        throw;
+    }
+    return cur;
+}
+
+template <typename ForwardIter, typename Size>
+MYSTL_CONSTEXPR20 ForwardIter uninitialized_default_construct_n(ForwardIter first, Size n) {
+    if (mystl::is_constant_evaluated())
+        return mystl::unchecked_uninit_default_n(first, n, std::false_type{});
+    return mystl::unchecked_uninit_default_n(first, n,
+        std::is_trivially_default_constructible<
+            typename iterator_traits<ForwardIter>::value_type>{});
+}
+
+/*******************************************************************************/
+// uninitialized_relocate
+// 把 [first, last) 上的对象搬到以 result 为起始处的未初始化空间，原对象的生命期随之结束，
+// 返回搬运结束的位置。可平凡重定位的类型直接按字节搬动，此时两段空间允许重叠
+/*******************************************************************************/
+template <typename T>
+T* unchecked_uninit_relocate(T* first, T* last, T* result, std::true_type) {
+    const auto n = static_cast<size_t>(last - first);
+    if (n != 0)
+        std::memmove(static_cast<void*>(result), static_cast<const void*>(first),
+            n * sizeof(T));
+    return result + n;
+}
+
+template <typename T>
+MYSTL_CONSTEXPR20 T* unchecked_uninit_relocate(
+    T* first, T* last, T* result, std::false_type) {
+    auto cur = mystl::uninitialized_move(first, last, result);
+    mystl::destroy(first, last);
+    return cur;
+}
+
+template <typename T>
+MYSTL_CONSTEXPR20 T* uninitialized_relocate(T* first, T* last, T* result) {
+    if (mystl::is_constant_evaluated())
+        return mystl::unchecked_uninit_relocate(first, last, result, std::false_type{});
+    return mystl::unchecked_uninit_relocate(first, last, result,
+        std::integral_constant<bool, mystl::is_trivially_relocatable<T>::value>{});
+}
+
+/*******************************************************************************/
+// 带执行策略的 uninitialized_copy / uninitialized_copy_n / uninitialized_fill /
+// uninitialized_fill_n / uninitialized_move / uninitialized_move_n
+// 策略允许并行且迭代器都是随机访问迭代器时分段并行构造，否则使用顺序版本
+/*******************************************************************************/
+
+// 按 split 并行构造 [result, result + n)，construct(b, e) 构造其中的 [result + b, result + e)
+// 某一段抛出异常时，把其他已经构造好的段析构后重新抛出
+template <class ForwardIter, class Construct>
+void par_uninit_construct(
+    ForwardIter result, const execution::range_split& split, Construct construct) {
+    std::unique_ptr<bool[]> built(new bool[split.count]());
+    try {
+        execution::thread_pool::instance().parallel_for(split.count, [&](size_t i) {
+            construct(split.begin(i), split.end(i));
+            built[i] = true;
+        });
+    } catch (...) {
+        for (size_t i = 0; i < split.count; ++i) {
+            if (built[i])
+                mystl::destroy(result + split.begin(i), result + split.end(i));
+        }
+        throw;
+    }
+}
+
+template <class ForwardIter>
+execution::range_split par_uninit_split(ForwardIter, size_t n) {
+    return execution::split_range(
+        n, sizeof(typename iterator_traits<ForwardIter>::value_type));
+}
+
+// uninitialized_copy
+template <class InputIter, class ForwardIter>
+ForwardIter par_uninit_copy(
+    InputIter first, InputIter last, ForwardIter result, m_false_type) {
+    return mystl::uninitialized_copy(first, last, result);
+}
+
+template <class RandomIter, class ForwardIter>
+ForwardIter par_uninit_copy(
+    RandomIter first, RandomIter last, ForwardIter result, m_true_type) {
+    const auto n = static_cast<size_t>(last - first);
+    const auto split = mystl::par_uninit_split(result, n);
+    if (split.count == 1)
+        return mystl::uninitialized_copy(first, last, result);
+    mystl::par_uninit_construct(result, split, [&](size_t b, size_t e) {
+        mystl::uninitialized_copy(first + b, first + e, result + b);
+    });
+    return result + n;
+}
+
+template <class ExecutionPolicy, class InputIter, class ForwardIter>
+execution::enable_if_execution_policy<ExecutionPolicy, ForwardIter> uninitialized_copy(
+    ExecutionPolicy&&, InputIter first, InputIter last, ForwardIter result) {
+    return mystl::par_uninit_copy(
+        first, last, result, use_parallel<ExecutionPolicy, InputIter, ForwardIter>{});
+}
+
+// uninitialized_copy_n
+template <class InputIter, class Size, class ForwardIter>
+ForwardIter par_uninit_copy_n(InputIter first, Size n, ForwardIter result, m_false_type) {
+    return mystl::uninitialized_copy_n(first, n, result);
+}
+
+template <class RandomIter, class Size, class ForwardIter>
+ForwardIter par_uninit_copy_n(RandomIter first, Size n, ForwardIter result, m_true_type) {
+    if (n <= 0)
+        return result;
+    return mystl::par_uninit_copy(
+        first, first + static_cast<size_t>(n), result, m_true_type{});
+}
+
+template <class ExecutionPolicy, class InputIter, class Size, class ForwardIter>
+execution::enable_if_execution_policy<ExecutionPolicy, ForwardIter> uninitialized_copy_n(
+    ExecutionPolicy&&, InputIter first, Size n, ForwardIter result) {
+    return mystl::par_uninit_copy_n(
+        first, n, result, use_parallel<ExecutionPolicy, InputIter, ForwardIter>{});
+}
+
+// uninitialized_fill_n
+template <class ForwardIter, class Size, class T>
+ForwardIter par_uninit_fill_n(ForwardIter first, Size n, const T& value, m_false_type) {
+    return mystl::uninitialized_fill_n(first, n, value);
+}
+
+template <class RandomIter, class Size, class T>
+RandomIter par_uninit_fill_n(RandomIter first, Size n, const T& value, m_true_type) {
+    if (n <= 0)
+        return first;
+    const auto split = mystl::par_uninit_split(first, static_cast<size_t>(n));
+    if (split.count == 1)
+        return mystl::uninitialized_fill_n(first, n, value);
+    mystl::par_uninit_construct(first, split, [&](size_t b, size_t e) {
+        mystl::uninitialized_fill_n(first + b, e - b, value);
+    });
+    return first + static_cast<size_t>(n);
+}
+
+template <class ExecutionPolicy, class ForwardIter, class Size, class T>
+execution::enable_if_execution_policy<ExecutionPolicy, ForwardIter> uninitialized_fill_n(
+    ExecutionPolicy&&, ForwardIter first, Size n, const T& value) {
+    return mystl::par_uninit_fill_n(
+        first, n, value, use_parallel<ExecutionPolicy, ForwardIter>{});
+}
+
+// uninitialized_fill
+template <class ForwardIter, class T>
+void par_uninit_fill(ForwardIter first, ForwardIter last, const T& value, m_false_type) {
+    mystl::uninitialized_fill(first, last, value);
+}
+
+template <class RandomIter, class T>
+void par_uninit_fill(RandomIter first, RandomIter last, const T& value, m_true_type) {
+    mystl::par_uninit_fill_n(first, last - first, value, m_true_type{});
+}
+
+template <class ExecutionPolicy, class ForwardIter, class T>
+execution::enable_if_execution_policy<ExecutionPolicy, void> uninitialized_fill(
+    ExecutionPolicy&&, ForwardIter first, ForwardIter last, const T& value) {
+    mystl::par_uninit_fill(first, last, value, use_parallel<ExecutionPolicy, ForwardIter>{});
+}
+
+// uninitialized_move
+template <class InputIter, class ForwardIter>
+ForwardIter par_uninit_move(
+    InputIter first, InputIter last, ForwardIter result, m_false_type) {
+    return mystl::uninitialized_move(first, last, result);
+}
+
+template <class RandomIter, class ForwardIter>
+ForwardIter par_uninit_move(
+    RandomIter first, RandomIter last, ForwardIter result, m_true_type) {
+    const auto n = static_cast<size_t>(last - first);
+    const auto split = mystl::par_uninit_split(result, n);
+    if (split.count == 1)
+        return mystl::uninitialized_move(first, last, result);
+    mystl::par_uninit_construct(result, split, [&](size_t b, size_t e) {
+        mystl::uninitialized_move(first + b, first + e, result + b);
+    });
+    return result + n;
+}
+
+template <class ExecutionPolicy, class InputIter, class ForwardIter>
+execution::enable_if_execution_policy<ExecutionPolicy, ForwardIter> uninitialized_move(
+    ExecutionPolicy&&, InputIter first, InputIter last, ForwardIter result) {
+    return mystl::par_uninit_move(
+        first, last, result, use_parallel<ExecutionPolicy, InputIter, ForwardIter>{});
+}
+
+// uninitialized_move_n
+template <class InputIter, class Size, class ForwardIter>
+ForwardIter par_uninit_move_n(InputIter first, Size n, ForwardIter result, m_false_type) {
+    return mystl::uninitialized_move_n(first, n, result);
+}
+
+template <class RandomIter, class Size, class ForwardIter>
+ForwardIter par_uninit_move_n(RandomIter first, Size n, ForwardIter result, m_true_type) {
+    if (n <= 0)
+        return result;
+    return mystl::par_uninit_move(
+        first, first + static_cast<size_t>(n), result, m_true_type{});
+}
+
+template <class ExecutionPolicy, class InputIter, class Size, class ForwardIter>
+execution::enable_if_execution_policy<ExecutionPolicy, ForwardIter> uninitialized_move_n(
+    ExecutionPolicy&&, InputIter first, Size n, ForwardIter result) {
+    return mystl::par_uninit_move_n(
+        first, n, result, use_parallel<ExecutionPolicy, InputIter, ForwardIter>{});
+}
+
 } // namespace mystl
@@ -3,6 +3,7 @@
 // 工具头文件，包含 move、forward、swap等函数，以及 pair 结构
 
 #include <cstddef>
+#include <tuple>
 #include <type_traits>
 
 #include "type_traits.h"
@@ -11,32 +12,33 @@ namespace mystl {
 
 // move
 template <typename T>
-typename std::remove_reference<T>::type&& move(T&& arg) noexcept {
+constexpr typename std::remove_reference<T>::type&& move(T&& arg) noexcept {
     return static_cast<typename std::remove_reference<T>::type&&>(arg);
 }
 
 // forward
 template <typename T>
-T&& forward(typename std::remove_reference<T>::type& arg) noexcept {
+constexpr T&& forward(typename std::remove_reference<T>::type& arg) noexcept {
     return static_cast<T&&>(arg);
 }
 
 template <typename T>
-T&& forward(typename std::remove_reference<T>::type&& arg) noexcept {
+constexpr T&& forward(typename std::remove_reference<T>::type&& arg) noexcept {
     static_assert(!std::is_lvalue_reference<T>::value, "bad forward");
     return static_cast<T&&>(arg);
 }
 
 // swap
 template <typename T>
-void swap(T& lhs, T& rhs) {
+MYSTL_CONSTEXPR20 void swap(T& lhs, T& rhs) {
     auto tmp(mystl::move(lhs));
     lhs = mystl::move(rhs);
     rhs = mystl::move(tmp);
 }
 
 template <typename ForwardIter1, typename ForwardIter2>
-ForwardIter2 swap_range(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2) {
+MYSTL_CONSTEXPR20 ForwardIter2 swap_range(
+    ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 first2) {
     for (; first1 != last1; ++first1, ++first2) {
         mystl::swap(*first1, *first2);
     }
@@ -45,10 +47,26 @@ ForwardIter2 swap_range(ForwardIter1 first1, ForwardIter1 last1, ForwardIter2 fi
 }
 
 template <typename T, size_t N>
-void swap(T (&a)[N], T (&b)[N]) {
+MYSTL_CONSTEXPR20 void swap(T (&a)[N], T (&b)[N]) {
     mystl::swap_range(a, a + N, b);
 }
 
+// index_sequence，C++11 中没有 std::index_sequence，展开 tuple 时使用
+template <size_t... I>
+struct index_sequence {};
+
+template <size_t N, size_t... I>
+struct make_index_sequence : make_index_sequence<N - 1, N - 1, I...> {};
+
+template <size_t... I>
+struct make_index_sequence<0, I...> {
+    using type = index_sequence<I...>;
+};
+
+// sorted_unique_t，告诉 flat_map / flat_set 输入已经按键排好序并且没有重复的键
+struct sorted_unique_t {};
+constexpr sorted_unique_t sorted_unique{};
+
 /******************************************************************************/
 // pair
 template <typename T1, typename T2>
@@ -89,8 +107,92 @@ struct pair {
         : first(a)
         , second(b) {}
 
+    // 由可以转换为 T1、T2 的参数构造，参数被完美转发
+    template <typename U1, typename U2,
+        typename std::enable_if<std::is_constructible<T1, U1&&>::value &&
+                                    std::is_constructible<T2, U2&&>::value &&
+                                    std::is_convertible<U1&&, T1>::value &&
+                                    std::is_convertible<U2&&, T2>::value,
+            int>::type = 0>
+    constexpr pair(U1&& a, U2&& b)
+        : first(mystl::forward<U1>(a))
+        , second(mystl::forward<U2>(b)) {}
+
+    template <typename U1, typename U2,
+        typename std::enable_if<std::is_constructible<T1, U1&&>::value &&
+                                    std::is_constructible<T2, U2&&>::value &&
+                                    (!std::is_convertible<U1&&, T1>::value ||
+                                        !std::is_convertible<U2&&, T2>::value),
+            int>::type = 0>
+    explicit constexpr pair(U1&& a, U2&& b)
+        : first(mystl::forward<U1>(a))
+        , second(mystl::forward<U2>(b)) {}
+
+    // 由其他类型的 pair 构造
+    template <typename U1, typename U2,
+        typename std::enable_if<std::is_constructible<T1, const U1&>::value &&
+                                    std::is_constructible<T2, const U2&>::value,
+            int>::type = 0>
+    constexpr pair(const pair<U1, U2>& other)
+        : first(other.first)
+        , second(other.second) {}
+
+    template <typename U1, typename U2,
+        typename std::enable_if<std::is_constructible<T1, U1&&>::value &&
+                                    std::is_constructible<T2, U2&&>::value,
+            int>::type = 0>
+    constexpr pair(pair<U1, U2>&& other)
+        : first(mystl::forward<U1>(other.first))
+        , second(mystl::forward<U2>(other.second)) {}
+
+    // 分段构造：first 与 second 分别由两个 tuple 中的参数就地构造
+    template <typename... Args1, typename... Args2>
+    MYSTL_CONSTEXPR20 pair(
+        std::piecewise_construct_t, std::tuple<Args1...> a, std::tuple<Args2...> b)
+        : pair(a, b, typename make_index_sequence<sizeof...(Args1)>::type{},
+              typename make_index_sequence<sizeof...(Args2)>::type{}) {}
+
     pair(const pair&) = default;
     pair(pair&&) = default;
+
+    pair& operator=(const pair&) = default;
+    pair& operator=(pair&&) = default;
+
+private:
+    template <typename... Args1, typename... Args2, size_t... I1, size_t... I2>
+    MYSTL_CONSTEXPR20 pair(std::tuple<Args1...>& a, std::tuple<Args2...>& b,
+        index_sequence<I1...>, index_sequence<I2...>)
+        : first(mystl::forward<Args1>(std::get<I1>(a))...)
+        , second(mystl::forward<Args2>(std::get<I2>(b))...) {}
 };
 
+template <typename T1, typename T2>
+constexpr bool operator==(const pair<T1, T2>& lhs, const pair<T1, T2>& rhs) {
+    return lhs.first == rhs.first && lhs.second == rhs.second;
+}
+
+template <typename T1, typename T2>
+constexpr bool operator!=(const pair<T1, T2>& lhs, const pair<T1, T2>& rhs) {
+    return !(lhs == rhs);
+}
+
+template <typename T1, typename T2>
+constexpr bool operator<(const pair<T1, T2>& lhs, const pair<T1, T2>& rhs) {
+    return lhs.first < rhs.first || (!(rhs.first < lhs.first) && lhs.second < rhs.second);
+}
+
+// 比通用的 swap 更特化，与 std 的算法一起使用时不会和 std::swap 产生歧义
+template <typename T1, typename T2>
+MYSTL_CONSTEXPR20 void swap(pair<T1, T2>& lhs, pair<T1, T2>& rhs) {
+    mystl::swap(lhs.first, rhs.first);
+    mystl::swap(lhs.second, rhs.second);
+}
+
+template <typename T1, typename T2>
+constexpr pair<typename std::decay<T1>::type, typename std::decay<T2>::type> make_pair(
+    T1&& a, T2&& b) {
+    return pair<typename std::decay<T1>::type, typename std::decay<T2>::type>(
+        mystl::forward<T1>(a), mystl::forward<T2>(b));
+}
+
 } // namespace mystl
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <cstring>
 #include <initializer_list>
+#include <iterator>
 
 #include "exceptdef.h"
 #include "iterator.h"
 #include "memory.h"
+#include "memory_resource.h"
 #include "util.h"
 
 namespace mystl {
@@ -19,22 +22,134 @@ namespace mystl {
 #undef min
 #endif // min
 
+/*****************************************************************************************/
+// vector 的增长策略
+// next_capacity(cap, required, elem_size, max_size) 返回扩容后的容量，不小于 required
+// 作为 vector 的第三个模板参数传入，默认按 2 倍增长
+/*****************************************************************************************/
+enum { EGrowthMinBytes = 64 };        // 第一次分配至少占用的字节数
+enum { EGrowthPageSize = 4096 };      // 按页对齐的页大小
+enum { EGrowthPageThreshold = 65536 }; // 超过该字节数后按页对齐
+
+// 按 factor_num / factor_den 增长，并处理第一次分配、溢出和 required 更大的情况
+template <size_t Num, size_t Den>
+MYSTL_CONSTEXPR20 size_t vector_grow_by_factor(
+    size_t cap, size_t required, size_t elem_size, size_t max_size) noexcept {
+    size_t new_cap = 0;
+    if (cap == 0) {
+        new_cap = EGrowthMinBytes / elem_size;
+    } else if (cap > max_size / Num * Den) {
+        new_cap = max_size;
+    } else {
+        new_cap = cap / Den * Num + cap % Den * Num / Den;
+    }
+    return new_cap < required ? required : new_cap;
+}
+
+struct vector_growth_2x {
+    static MYSTL_CONSTEXPR20 size_t next_capacity(
+        size_t cap, size_t required, size_t elem_size, size_t max_size) noexcept {
+        return vector_grow_by_factor<2, 1>(cap, required, elem_size, max_size);
+    }
+};
+
+struct vector_growth_1_5x {
+    static MYSTL_CONSTEXPR20 size_t next_capacity(
+        size_t cap, size_t required, size_t elem_size, size_t max_size) noexcept {
+        return vector_grow_by_factor<3, 2>(cap, required, elem_size, max_size);
+    }
+};
+
+// 小缓冲区按 2 倍增长；大缓冲区按 1.5 倍增长，并把字节数上调为整页，减少零头和浪费
+struct vector_growth_page {
+    static MYSTL_CONSTEXPR20 size_t next_capacity(
+        size_t cap, size_t required, size_t elem_size, size_t max_size) noexcept {
+        if (cap * elem_size < EGrowthPageThreshold)
+            return vector_grow_by_factor<2, 1>(cap, required, elem_size, max_size);
+        const size_t new_cap =
+            vector_grow_by_factor<3, 2>(cap, required, elem_size, max_size);
+        const size_t bytes = new_cap * elem_size;
+        if (bytes > static_cast<size_t>(-1) - EGrowthPageSize)
+            return new_cap;
+        const size_t page_cap =
+            ((bytes + EGrowthPageSize - 1) & ~static_cast<size_t>(EGrowthPageSize - 1)) /
+            elem_size;
+        return page_cap < max_size ? page_cap : max_size;
+    }
+};
+
+/*****************************************************************************************/
+// vector 的存储方式，作为第四个模板参数传入
+// vector_heap_storage   : 元素总是放在分配器申请的空间中，没有申请空间时三个指针都为空
+// vector_inline_storage : 另有一块能容纳 N 个元素的内联缓冲区，不超过 N 个元素时不申请空间，
+//                         small_vector 即使用这种存储方式的 vector
+/*****************************************************************************************/
 template <typename T>
+struct vector_heap_storage {
+    static constexpr size_t inline_size() noexcept {
+        return 0;
+    }
+
+    MYSTL_CONSTEXPR20 T* inline_data() noexcept {
+        return nullptr;
+    }
+
+    MYSTL_CONSTEXPR20 bool is_inline(const T*) const noexcept {
+        return false;
+    }
+};
+
+template <typename T, size_t N>
+struct vector_inline_storage {
+    alignas(T) unsigned char buffer_[N * sizeof(T)];
+
+    static constexpr size_t inline_size() noexcept {
+        return N;
+    }
+
+    T* inline_data() noexcept {
+        return reinterpret_cast<T*>(buffer_);
+    }
+
+    bool is_inline(const T* p) const noexcept {
+        return p == reinterpret_cast<const T*>(buffer_);
+    }
+};
+
+template <typename T, typename Alloc = mystl::allocator<T>,
+    typename Growth = mystl::vector_growth_2x,
+    typename Storage = mystl::vector_heap_storage<T>>
 class vector {
     static_assert(!std::is_same<bool, T>::value, "vector bool is abandoned in mystl");
+    static_assert(std::is_same<T, typename Alloc::value_type>::value,
+        "Alloc::value_type must be the same as T");
 
 public:
     // clang-format off
-    using allocator_type = mystl::allocator<T>;
-    using data_allocator = mystl::allocator<T>;
-
-    using value_type                = typename allocator_type::value_type;
-    using pointer                   = typename allocator_type::pointer;
-    using const_pointer             = typename allocator_type::const_pointer;
-    using reference                 = typename allocator_type::reference;
-    using const_reference           = typename allocator_type::const_reference;
-    using size_type                 = typename allocator_type::size_type;
-    using difference_type           = typename allocator_type::difference_type;
+    using allocator_type            = Alloc;
+    using growth_policy             = Growth;
+    using alloc_traits              = mystl::allocator_traits<allocator_type>;
+
+    // 可平凡重定位的元素按字节搬动；分配器还支持 reallocate 时扩容可以原地进行
+    using relocatable               = m_bool_constant<
+                                          mystl::is_trivially_relocatable<T>::value>;
+    using can_realloc               = m_bool_constant<relocatable::value &&
+                                          alloc_traits::has_reallocate::value>;
+    // 值初始化为全 0 字节的元素直接使用分配器清零的空间，不逐个构造
+    using zero_init                 = m_bool_constant<
+                                          mystl::is_zero_initializable<T>::value &&
+                                          alloc_traits::has_allocate_zeroed::value>;
+    // 接管另一个容器的元素是否不抛出异常：内联缓冲区中的元素只能逐个搬动
+    using nothrow_take              = m_bool_constant<Storage::inline_size() == 0 ||
+                                          std::is_nothrow_move_constructible<T>::value>;
+
+    using value_type                = T;
+    using pointer                   = typename alloc_traits::pointer;
+    using const_pointer             = typename alloc_traits::const_pointer;
+    using reference                 = value_type&;
+    using const_reference           = const value_type&;
+    using size_type                 = typename alloc_traits::size_type;
+    using difference_type           = typename alloc_traits::difference_type;
 
     using iterator                  = value_type*;
     using const_iterator            = const value_type*;
@@ -42,398 +157,1367 @@ public:
     using const_reverse_iterator    = mystl::reverse_iterator<const_iterator>;
     // clang-format on
 
-    allocator_type get_allocator() {
-        return data_allocator();
+    MYSTL_CONSTEXPR20 allocator_type get_allocator() const {
+        return alloc_ref();
     }
 
 private:
-    iterator begin_;
-    iterator end_;
-    iterator cap_;
+    // 分配器和存储方式作为基类保存，无状态的分配器和 vector_heap_storage
+    // 借助空基类优化不占用额外空间
+    struct vector_impl : public allocator_type, public Storage {
+        iterator begin_; // 表示目前使用空间的头部
+        iterator end_;   // 表示目前使用空间的尾部
+        iterator cap_;   // 表示目前储存空间的尾部
+
+        MYSTL_CONSTEXPR20 vector_impl() noexcept(
+            std::is_nothrow_default_constructible<allocator_type>::value)
+            : allocator_type()
+            , begin_(nullptr)
+            , end_(nullptr)
+            , cap_(nullptr) {
+            reset();
+        }
+
+        MYSTL_CONSTEXPR20 explicit vector_impl(const allocator_type& a) noexcept
+            : allocator_type(a)
+            , begin_(nullptr)
+            , end_(nullptr)
+            , cap_(nullptr) {
+            reset();
+        }
+
+        MYSTL_CONSTEXPR20 explicit vector_impl(allocator_type&& a) noexcept
+            : allocator_type(mystl::move(a))
+            , begin_(nullptr)
+            , end_(nullptr)
+            , cap_(nullptr) {
+            reset();
+        }
+
+        // 回到没有申请空间的状态：空指针，或者空的内联缓冲区
+        MYSTL_CONSTEXPR20 void reset() noexcept {
+            begin_ = end_ = this->inline_data();
+            cap_ = begin_ + Storage::inline_size();
+        }
+    };
+
+    vector_impl impl_;
 
 public:
-    vector() noexcept {
+    MYSTL_CONSTEXPR20 vector() noexcept(
+        std::is_nothrow_default_constructible<allocator_type>::value)
+        : impl_() {
         try_init();
     }
 
-    explicit vector(size_type n) {
-        fill_init(n, value_type{});
+    MYSTL_CONSTEXPR20 explicit vector(const allocator_type& a) noexcept
+        : impl_(a) {
+        try_init();
+    }
+
+    MYSTL_CONSTEXPR20 explicit vector(
+        size_type n, const allocator_type& a = allocator_type())
+        : impl_(a) {
+        value_init(n, zero_init{});
     }
 
-    vector(size_type n, const value_type& value) {
+    MYSTL_CONSTEXPR20 vector(
+        size_type n, const value_type& value, const allocator_type& a = allocator_type())
+        : impl_(a) {
         fill_init(n, value);
     }
 
     template <typename Iter,
         typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type = 0>
-    vector(Iter first, Iter last) {
-        MYSTL_DEBUG(!(last < first));
+    MYSTL_CONSTEXPR20 vector(
+        Iter first, Iter last, const allocator_type& a = allocator_type())
+        : impl_(a) {
         range_init(first, last);
     }
 
-    vector(const vector& rhs) {
+    MYSTL_CONSTEXPR20 vector(const vector& rhs)
+        : impl_(alloc_traits::select_on_container_copy_construction(rhs.alloc_ref())) {
         range_init(rhs.begin(), rhs.end());
     }
 
-    vector(vector&& rhs) noexcept
-        : begin_(rhs.begin())
-        , end_(rhs.end())
-        , cap_(rhs.cap_) {
-        rhs.begin() = nullptr;
-        rhs.end() = nullptr;
-        rhs.cap_ = nullptr;
+    MYSTL_CONSTEXPR20 vector(const vector& rhs, const allocator_type& a)
+        : impl_(a) {
+        range_init(rhs.begin(), rhs.end());
+    }
+
+    MYSTL_CONSTEXPR20 vector(vector&& rhs) noexcept(nothrow_take::value)
+        : impl_(mystl::move(rhs.alloc_ref())) {
+        take_storage(rhs);
+    }
+
+    // 分配器不同时不能直接接管 rhs 的空间，只能逐个移动元素
+    MYSTL_CONSTEXPR20 vector(vector&& rhs, const allocator_type& a)
+        : impl_(a) {
+        if (alloc_ref() == rhs.alloc_ref()) {
+            take_storage(rhs);
+        } else if (!rhs.empty()) {
+            init_space(0, rhs.size());
+            try {
+                impl_.end_ =
+                    mystl::uninitialized_move(rhs.begin(), rhs.end(), impl_.begin_);
+            } catch (...) {
+                deallocate_space(impl_.begin_, capacity());
+                throw;
+            }
+        }
     }
 
-    vector(std::initializer_list<value_type> ilist) {
+    MYSTL_CONSTEXPR20 vector(std::initializer_list<value_type> ilist,
+        const allocator_type& a = allocator_type())
+        : impl_(a) {
         range_init(ilist.begin(), ilist.end());
     }
 
-    vector& operator=(const vector& rhs) {
+    MYSTL_CONSTEXPR20 vector& operator=(const vector& rhs) {
         if (this != &rhs) {
+            copy_assign_alloc(rhs,
+                typename alloc_traits::propagate_on_container_copy_assignment{});
             const auto len = rhs.size();
             if (len > capacity()) {
-                vector tmp(rhs.begin(), rhs.end());
-                swap(tmp);
+                vector tmp(rhs.begin(), rhs.end(), alloc_ref());
+                replace_storage(tmp);
             } else if (size() >= len) {
                 // 如果已有的数据多余赋值的数据，就需要把多余的半部分删除
                 // 将前面的部分拷贝到目标位置
                 auto iter = mystl::copy(rhs.begin(), rhs.end(), begin());
                 // 将后续多余的数据删除掉
-                data_allocator::destroy(iter, end());
-                end() = begin() + len;
+                mystl::destroy(iter, end());
+                impl_.end_ = impl_.begin_ + len;
             } else {
                 mystl::copy(rhs.begin(), rhs.begin() + size(), begin());
                 mystl::uninitialized_copy(rhs.begin() + size(), rhs.end(), end());
-                end() = begin() + len;
-                cap_ = end();
+                impl_.end_ = impl_.begin_ + len;
             }
         }
 
         return *this;
     }
 
-    vector& operator=(vector&& rhs) {
-        destroy_and_recover(begin(), end(), capacity());
-        begin() = rhs.begin();
-        end() = rhs.end();
-        cap_ = rhs.cap_;
-        rhs.begin() = nullptr;
-        rhs.end() = nullptr;
-        rhs.cap_ = nullptr;
+    MYSTL_CONSTEXPR20 vector& operator=(vector&& rhs) noexcept(
+        nothrow_take::value &&
+        (alloc_traits::propagate_on_container_move_assignment::value ||
+            alloc_traits::is_always_equal::value)) {
+        if (this != &rhs) {
+            move_assign(rhs,
+                m_bool_constant<
+                    alloc_traits::propagate_on_container_move_assignment::value ||
+                    alloc_traits::is_always_equal::value>{});
+        }
         return *this;
     }
 
-    vector& operator=(std::initializer_list<value_type> ilist) {
-        vector tmp(ilist.begin(), ilist.end());
-        swap(tmp);
+    MYSTL_CONSTEXPR20 vector& operator=(std::initializer_list<value_type> ilist) {
+        vector tmp(ilist.begin(), ilist.end(), alloc_ref());
+        replace_storage(tmp);
         return *this;
     }
 
-    ~vector() {
-        destroy_and_recover(begin(), end(), capacity());
-        begin() = nullptr;
-        end() = nullptr;
-        cap_ = nullptr;
+    MYSTL_CONSTEXPR20 ~vector() {
+        destroy_and_recover(impl_.begin_, impl_.end_, capacity());
+        impl_.begin_ = impl_.end_ = impl_.cap_ = nullptr;
     }
 
 public:
     // 迭代器相关操作
-    iterator begin() {
-        return begin_;
+    MYSTL_CONSTEXPR20 iterator begin() noexcept {
+        return impl_.begin_;
     }
-    const_iterator begin() const {
-        return begin_;
+    MYSTL_CONSTEXPR20 const_iterator begin() const noexcept {
+        return impl_.begin_;
     }
-    iterator end() {
-        return end_;
+    MYSTL_CONSTEXPR20 iterator end() noexcept {
+        return impl_.end_;
     }
-    const_iterator end() const {
-        return end_;
+    MYSTL_CONSTEXPR20 const_iterator end() const noexcept {
+        return impl_.end_;
     }
 
-    reverse_iterator rbegin() {
+    MYSTL_CONSTEXPR20 reverse_iterator rbegin() noexcept {
         return reverse_iterator(end());
     }
 
-    const_reverse_iterator rbegin() const {
+    MYSTL_CONSTEXPR20 const_reverse_iterator rbegin() const noexcept {
         return const_reverse_iterator(end());
     }
 
-    reverse_iterator rend() {
+    MYSTL_CONSTEXPR20 reverse_iterator rend() noexcept {
         return reverse_iterator(begin());
     }
 
-    const_reverse_iterator rend() const {
+    MYSTL_CONSTEXPR20 const_reverse_iterator rend() const noexcept {
         return const_reverse_iterator(begin());
     }
 
-    const_iterator cbegin() {
+    MYSTL_CONSTEXPR20 const_iterator cbegin() const noexcept {
         return begin();
     }
 
-    const_iterator cend() {
+    MYSTL_CONSTEXPR20 const_iterator cend() const noexcept {
         return end();
     }
 
-    const_reverse_iterator crbegin() {
+    MYSTL_CONSTEXPR20 const_reverse_iterator crbegin() const noexcept {
         return rbegin();
     }
 
-    const_reverse_iterator crend() {
+    MYSTL_CONSTEXPR20 const_reverse_iterator crend() const noexcept {
         return rend();
     }
 
     // 容量相关操作
-    bool empty() const {
-        return begin() == end();
+    MYSTL_CONSTEXPR20 bool empty() const noexcept {
+        return impl_.begin_ == impl_.end_;
     }
 
-    size_type size() const {
-        return static_cast<size_type>(end() - begin());
+    MYSTL_CONSTEXPR20 size_type size() const noexcept {
+        return static_cast<size_type>(impl_.end_ - impl_.begin_);
     }
 
-    size_type max_size() const {
-        return static_cast<size_type>(-1) / sizeof(T);
+    MYSTL_CONSTEXPR20 size_type max_size() const noexcept {
+        return alloc_traits::max_size(alloc_ref());
     }
 
-    size_type capacity() const {
-        return static_cast<size_type>(cap_ - begin());
+    MYSTL_CONSTEXPR20 size_type capacity() const noexcept {
+        return static_cast<size_type>(impl_.cap_ - impl_.begin_);
     }
 
-    void reserve(size_type n) {
+    MYSTL_CONSTEXPR20 void reserve(size_type n) {
         if (capacity() < n) {
             THROW_LENGTH_ERROR_IF(n > max_size(),
                 "n can not larger than max_size() in vector<T>::reverse(n)");
-            const auto old_size = size();
-            auto tmp = data_allocator::allocate(n);
-            mystl::uninitialized_move(begin(), end(), tmp);
-            data_allocator::deallocate(begin(), capacity());
-            begin() = tmp;
-            end() = tmp + old_size;
-            cap_ = begin() + n;
+            relocate_storage(n, size(), 0, can_realloc{});
         }
     }
 
-    void shrink_to_fit() {
-        if (end() < cap_) {
+    MYSTL_CONSTEXPR20 void shrink_to_fit() {
+        if (impl_.end_ < impl_.cap_ && !is_inline()) {
             reinsert(size());
         }
     }
 
     // 访问元素相关操作
-    reference operator[](size_type n) {
+    MYSTL_CONSTEXPR20 reference operator[](size_type n) {
         MYSTL_DEBUG(n < size());
-        return *(begin() + n);
+        return *(impl_.begin_ + n);
     }
 
-    const_reference operator[](size_type n) const {
+    MYSTL_CONSTEXPR20 const_reference operator[](size_type n) const {
         MYSTL_DEBUG(n < size());
-        return *(begin() + n);
+        return *(impl_.begin_ + n);
     }
 
-    reference at(size_type n) {
-        THROW_LENGTH_ERROR_IF(!(n < size()), "vertor<T>::at() subscript out of range");
+    MYSTL_CONSTEXPR20 reference at(size_type n) {
+        THROW_OUT_OF_RANGE_IF(!(n < size()), "vector<T>::at() subscript out of range");
         return (*this)[n];
     }
 
-    const_reference at(size_type n) const {
-        THROW_LENGTH_ERROR_IF(!(n < size()), "vertor<T>::at() subscript out of range");
+    MYSTL_CONSTEXPR20 const_reference at(size_type n) const {
+        THROW_OUT_OF_RANGE_IF(!(n < size()), "vector<T>::at() subscript out of range");
         return (*this)[n];
     }
 
-    reference front() {
+    MYSTL_CONSTEXPR20 reference front() {
         MYSTL_DEBUG(!empty());
-        return *begin();
+        return *impl_.begin_;
     }
 
-    const_reference front() const {
+    MYSTL_CONSTEXPR20 const_reference front() const {
         MYSTL_DEBUG(!empty());
-        return *begin();
+        return *impl_.begin_;
     }
 
-    reference back() {
+    MYSTL_CONSTEXPR20 reference back() {
         MYSTL_DEBUG(!empty());
-        return *(end() - 1);
+        return *(impl_.end_ - 1);
     }
 
-    const_reference back() const {
+    MYSTL_CONSTEXPR20 const_reference back() const {
         MYSTL_DEBUG(!empty());
-        return *(end() - 1);
+        return *(impl_.end_ - 1);
     }
 
-    pointer data() {
-        return begin();
+    MYSTL_CONSTEXPR20 pointer data() noexcept {
+        return impl_.begin_;
     }
 
-    const_pointer data() const {
-        return begin();
+    MYSTL_CONSTEXPR20 const_pointer data() const noexcept {
+        return impl_.begin_;
     }
 
     // 修改容器相关操作
 
     // asign
-    void assign(size_type n, const value_type& value) {
+    MYSTL_CONSTEXPR20 void assign(size_type n, const value_type& value) {
         fill_assign(n, value);
     }
 
     template <typename Iter,
-        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::value = 0>
-    void assign(Iter first, Iter last) {
-        MYSTL_DEBUG(!(last < first));
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type = 0>
+    MYSTL_CONSTEXPR20 void assign(Iter first, Iter last) {
         copy_assign(first, last, iterator_category(first));
     }
 
-    void assign(std::initializer_list<value_type> ilist) {
-        copy_assign(ilist.first, ilist.end(), mystl::forward_iterator_tag{});
+    MYSTL_CONSTEXPR20 void assign(std::initializer_list<value_type> ilist) {
+        copy_assign(ilist.begin(), ilist.end(), mystl::forward_iterator_tag{});
     }
 
     // emplace / emplace_back
     template <typename... Args>
-    iterator emplace(const_iterator pos, Args&&... args) {
+    MYSTL_CONSTEXPR20 iterator emplace(const_iterator pos, Args&&... args) {
         MYSTL_DEBUG(pos >= begin() && pos <= end());
         iterator xpos = const_cast<iterator>(pos);
-        const size_type n = xpos - begin();
-        if (end() != cap_ && xpos == end()) {
-            data_allocator::construct(
-                mystl::address_of(*end()), mystl::forward<Args>(args)...);
-            ++end();
-        } else if (end() != cap_) {
-            auto new_end = end();
-            data_allocator::construct(mystl::address_of(*end()), *(end() - 1));
-            ++new_end;
-            mystl::copy_backward(xpos, end() - 1, end());
-            *xpos = value_type(mystl::forward<Args>(args)...);
+        const size_type n = xpos - impl_.begin_;
+        if (impl_.end_ != impl_.cap_ && xpos == impl_.end_) {
+            alloc_traits::construct(alloc_ref(), mystl::address_of(*impl_.end_),
+                mystl::forward<Args>(args)...);
+            ++impl_.end_;
+        } else if (use_relocate()) {
+            relocate_emplace(xpos, mystl::forward<Args>(args)...);
+        } else if (impl_.end_ != impl_.cap_) {
+            value_type value_copy(mystl::forward<Args>(args)...);
+            alloc_traits::construct(alloc_ref(), mystl::address_of(*impl_.end_),
+                mystl::move(*(impl_.end_ - 1)));
+            mystl::move_backward(xpos, impl_.end_ - 1, impl_.end_);
+            ++impl_.end_;
+            *xpos = mystl::move(value_copy);
         } else {
             reallocate_emplace(xpos, mystl::forward<Args>(args)...);
         }
 
-        return begin() + n;
+        return impl_.begin_ + n;
     }
 
     template <typename... Args>
-    iterator emplace_back(Args&&... args) {
-        if (end() < cap_) {
-            data_allocator::construct(
-                mystl::address_of(*end()), mystl::forward<Args>(args)...);
-            ++end();
+    MYSTL_CONSTEXPR20 reference emplace_back(Args&&... args) {
+        if (impl_.end_ < impl_.cap_) {
+            alloc_traits::construct(alloc_ref(), mystl::address_of(*impl_.end_),
+                mystl::forward<Args>(args)...);
+            ++impl_.end_;
         } else {
-            reallocate_emplace(end(), mystl::forward<Args>(args)...);
+            reallocate_emplace(impl_.end_, mystl::forward<Args>(args)...);
         }
+        return back();
     }
 
     // push_back / pop_back
-    void push_back(const value_type& value) {
-        if (end() != cap_) {
-            data_allocator::construct(mystl::address_of(*end()), value);
-            ++end();
+    MYSTL_CONSTEXPR20 void push_back(const value_type& value) {
+        if (impl_.end_ != impl_.cap_) {
+            alloc_traits::construct(alloc_ref(), mystl::address_of(*impl_.end_), value);
+            ++impl_.end_;
         } else {
-            reallocate_insert(end(), value);
+            reallocate_insert(impl_.end_, value);
         }
     }
-    void push_back(value_type&& value) {
+
+    MYSTL_CONSTEXPR20 void push_back(value_type&& value) {
         emplace_back(mystl::move(value));
     }
 
-    void pop_back() {
+    MYSTL_CONSTEXPR20 void pop_back() {
         MYSTL_DEBUG(!empty());
-        data_allocator::destroy(end() - 1);
-        --end();
+        alloc_traits::destroy(alloc_ref(), impl_.end_ - 1);
+        --impl_.end_;
     }
 
     // insert
-    iterator insert(const_iterator pos, const value_type& value) {
+    MYSTL_CONSTEXPR20 iterator insert(const_iterator pos, const value_type& value) {
         MYSTL_DEBUG(pos >= begin() && pos <= end());
         iterator xpos = const_cast<iterator>(pos);
-        const size_type n = pos - begin();
-        if (end() != cap_ && xpos == end()) {
-            data_allocator::construct(mystl::address_of(*end()), value);
-            ++end();
-        } else if (end() != cap_) {
-            auto new_end = end();
-            data_allocator::construct(mystl::address_of(*end()), *(end() - 1));
-            ++new_end;
+        const size_type n = pos - impl_.begin_;
+        if (impl_.end_ != impl_.cap_ && xpos == impl_.end_) {
+            alloc_traits::construct(alloc_ref(), mystl::address_of(*impl_.end_), value);
+            ++impl_.end_;
+        } else if (use_relocate()) {
+            relocate_emplace(xpos, value);
+        } else if (impl_.end_ != impl_.cap_) {
             auto value_copy = value; // 避免元素被下面的复制操作改变
-            mystl::copy_backward(xpos, end() - 1, end());
+            alloc_traits::construct(alloc_ref(), mystl::address_of(*impl_.end_),
+                mystl::move(*(impl_.end_ - 1)));
+            mystl::move_backward(xpos, impl_.end_ - 1, impl_.end_);
+            ++impl_.end_;
             *xpos = mystl::move(value_copy);
         } else {
             reallocate_insert(xpos, value);
         }
 
-        return begin() + n;
+        return impl_.begin_ + n;
     }
 
-    iterator insert(const_iterator pos, value_type&& value) {
+    MYSTL_CONSTEXPR20 iterator insert(const_iterator pos, value_type&& value) {
         return emplace(pos, mystl::move(value));
     }
 
-    iterator insert(const_iterator pos, size_type n, const value_type& value) {
+    MYSTL_CONSTEXPR20 iterator insert(
+        const_iterator pos, size_type n, const value_type& value) {
         MYSTL_DEBUG(pos >= begin() && pos <= end());
         return fill_insert(const_cast<iterator>(pos), n, value);
     }
 
     template <typename Iter,
-        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::value = 0>
-    void insert(const_iterator pos, Iter first, Iter last) {
-        MYSTL_DEBUG(pos >= begin() && pos <= end() && !(last < first));
-        copy_insert(const_cast<iterator>(pos), first, last);
+        typename std::enable_if<mystl::is_input_iterator<Iter>::value, int>::type = 0>
+    MYSTL_CONSTEXPR20 iterator insert(const_iterator pos, Iter first, Iter last) {
+        MYSTL_DEBUG(pos >= begin() && pos <= end());
+        return copy_insert(const_cast<iterator>(pos), first, last);
+    }
+
+    MYSTL_CONSTEXPR20 iterator insert(
+        const_iterator pos, std::initializer_list<value_type> ilist) {
+        return insert(pos, ilist.begin(), ilist.end());
+    }
+
+    // 把 rg 中的元素插入到 pos 之前 / 追加到尾部，insert_range 返回指向第一个新元素的迭代器。
+    // 前向迭代器的区间最多重新分配一次，新元素直接构造在新空间中；
+    // 输入迭代器的区间逐个追加，按增长策略扩容。rg 不能引用容器自身的元素
+    template <typename Range>
+    MYSTL_CONSTEXPR20 iterator insert_range(const_iterator pos, Range&& rg) {
+        MYSTL_DEBUG(pos >= begin() && pos <= end());
+        return copy_insert(const_cast<iterator>(pos), std::begin(rg), std::end(rg));
+    }
+
+    template <typename Range>
+    MYSTL_CONSTEXPR20 void append_range(Range&& rg) {
+        copy_insert(impl_.end_, std::begin(rg), std::end(rg));
     }
 
     // erase / clear
-    iterator erase(const_iterator pos);
-    iterator erase(const_iterator first, const_iterator last);
+    MYSTL_CONSTEXPR20 iterator erase(const_iterator pos);
+    MYSTL_CONSTEXPR20 iterator erase(const_iterator first, const_iterator last);
 
-    void clear();
+    MYSTL_CONSTEXPR20 void clear() noexcept;
 
     // resize / reverse
-    void resize(size_type new_size);
-    void resize(size_type new_size, const value_type& value);
+    MYSTL_CONSTEXPR20 void resize(size_type new_size);
+    MYSTL_CONSTEXPR20 void resize(size_type new_size, const value_type& value);
+
+    // 以下三个函数新增的元素只做默认初始化，可平凡默认构造的元素不会被写入，
+    // 用于随后直接向 data() 写入数据的场合，避免先清零再覆盖
+    MYSTL_CONSTEXPR20 void resize_default_init(size_type new_size);
+
+    // 在尾部追加 n 个默认初始化的元素，返回指向第一个新元素的指针
+    MYSTL_CONSTEXPR20 pointer append_uninitialized(size_type n);
 
-    void reverse();
+    // 保证容量不小于 n，调用 op(data(), n) 写入数据，op 返回最终的元素个数 r (r <= n)，
+    // [size(), n) 上的初值不确定。只用于平凡类型
+    template <typename Op>
+    MYSTL_CONSTEXPR20 void resize_and_overwrite(size_type n, Op op);
+
+    MYSTL_CONSTEXPR20 void reverse();
 
     // swap
-    void swap(vector& rhs);
+    MYSTL_CONSTEXPR20 void swap(vector& rhs) noexcept(nothrow_take::value);
+
+protected:
+    // 元素是否保存在内联缓冲区中，vector_heap_storage 总是返回 false
+    MYSTL_CONSTEXPR20 bool is_inline() const noexcept {
+        return impl_.is_inline(impl_.begin_);
+    }
 
 private:
     // helper functions
 
+    MYSTL_CONSTEXPR20 allocator_type& alloc_ref() noexcept {
+        return impl_;
+    }
+
+    MYSTL_CONSTEXPR20 const allocator_type& alloc_ref() const noexcept {
+        return impl_;
+    }
+
+    // 是否按字节搬动元素，常量求值中不能按字节操作对象，总是逐个移动
+    static MYSTL_CONSTEXPR20 bool use_relocate() noexcept {
+        return relocatable::value && !mystl::is_constant_evaluated();
+    }
+
+    // 申请至少 n 个元素的空间，n 更新为分配器实际给出的元素个数
+    MYSTL_CONSTEXPR20 iterator allocate_space(size_type& n) {
+        auto result = alloc_traits::allocate_at_least(alloc_ref(), n);
+        n = result.count;
+        return result.ptr;
+    }
+
+    // 释放 allocate_space 得到的空间，空指针和内联缓冲区不需要释放
+    MYSTL_CONSTEXPR20 void deallocate_space(iterator p, size_type n) noexcept {
+        if (p != nullptr && !impl_.is_inline(p))
+            alloc_traits::deallocate(alloc_ref(), p, n);
+    }
+
     // initialize / destroy
-    void try_init();
+    MYSTL_CONSTEXPR20 void try_init() noexcept;
 
-    void init_space(size_type n, size_type cap);
+    MYSTL_CONSTEXPR20 void init_space(size_type n, size_type cap);
 
-    void fill_init(size_type n, const value_type& value);
+    MYSTL_CONSTEXPR20 void fill_init(size_type n, const value_type& value);
+
+    MYSTL_CONSTEXPR20 void value_init(size_type n, m_true_type);
+    MYSTL_CONSTEXPR20 void value_init(size_type n, m_false_type);
+
+    template <typename Iter>
+    MYSTL_CONSTEXPR20 void range_init(Iter first, Iter last);
 
     template <typename Iter>
-    void range_init(Iter first, Iter last);
+    MYSTL_CONSTEXPR20 void range_init(Iter first, Iter last, input_iterator_tag);
 
-    void destroy_and_recover(iterator first, iterator last, size_type n);
+    template <typename Iter>
+    MYSTL_CONSTEXPR20 void range_init(Iter first, Iter last, forward_iterator_tag);
+
+    MYSTL_CONSTEXPR20 void destroy_and_recover(iterator first, iterator last, size_type n);
 
     // calculate the growth size
-    size_type get_new_cap(size_type add_size);
+    MYSTL_CONSTEXPR20 size_type get_new_cap(size_type add_size);
 
     // assign
-    void fill_assign(size_type n, const value_type& value);
+    MYSTL_CONSTEXPR20 void fill_assign(size_type n, const value_type& value);
 
     template <typename Iter>
-    void copy_assign(Iter first, Iter last, input_iterator_tag);
+    MYSTL_CONSTEXPR20 void copy_assign(Iter first, Iter last, input_iterator_tag);
 
     template <typename Iter>
-    void copy_assign(Iter first, Iter last, forward_iterator_tag);
+    MYSTL_CONSTEXPR20 void copy_assign(Iter first, Iter last, forward_iterator_tag);
+
+    // 按 propagate_on_container_* 的要求处理分配器
+    MYSTL_CONSTEXPR20 void copy_assign_alloc(const vector& rhs, std::true_type);
+    MYSTL_CONSTEXPR20 void copy_assign_alloc(const vector& rhs, std::false_type);
+
+    MYSTL_CONSTEXPR20 void move_assign(vector& rhs, m_true_type) noexcept(
+        nothrow_take::value);
+    MYSTL_CONSTEXPR20 void move_assign(vector& rhs, m_false_type);
+
+    // 只交换堆上空间的指针，不交换分配器，两者都不能在内联缓冲区中
+    MYSTL_CONSTEXPR20 void swap_data(vector& rhs) noexcept;
+
+    // 接管 rhs 的元素，之后 rhs 为空。调用前本容器为空且没有申请空间。
+    // rhs 在堆上时直接接管空间，在内联缓冲区中时逐个搬到自己的内联缓冲区
+    MYSTL_CONSTEXPR20 void take_storage(vector& rhs) noexcept(nothrow_take::value);
+
+    // 析构自己的元素并释放空间，再接管 tmp 的元素
+    MYSTL_CONSTEXPR20 void replace_storage(vector& tmp) noexcept(nothrow_take::value) {
+        destroy_and_recover(impl_.begin_, impl_.end_, capacity());
+        try_init();
+        take_storage(tmp);
+    }
 
     // reallocate
     template <typename... Args>
-    void reallocate_emplace(iterator pos, Args&&... args);
+    MYSTL_CONSTEXPR20 void reallocate_emplace(iterator pos, Args&&... args);
 
-    void reallocate_insert(iterator pos, const value_type& value);
+    MYSTL_CONSTEXPR20 void reallocate_insert(iterator pos, const value_type& value);
+    MYSTL_CONSTEXPR20 iterator reallocate_around(
+        iterator pos, iterator new_begin, size_type new_size);
 
     // insert
-    iterator fill_insert(iterator pos, size_type n, const value_type& value);
+    MYSTL_CONSTEXPR20 iterator fill_insert(
+        iterator pos, size_type n, const value_type& value);
+
+    // 在尾部追加 n 个默认初始化的元素
+    MYSTL_CONSTEXPR20 void default_append(size_type n);
+
+    // 在尾部追加 n 个值初始化的元素
+    MYSTL_CONSTEXPR20 void value_append(size_type n, m_true_type);
+    MYSTL_CONSTEXPR20 void value_append(size_type n, m_false_type);
 
     template <typename Iter>
-    void copy_insert(iterator pos, Iter first, Iter last);
+    MYSTL_CONSTEXPR20 iterator copy_insert(iterator pos, Iter first, Iter last);
+
+    template <typename Iter>
+    MYSTL_CONSTEXPR20 iterator copy_insert(
+        iterator pos, Iter first, Iter last, input_iterator_tag);
+
+    template <typename Iter>
+    MYSTL_CONSTEXPR20 iterator copy_insert(
+        iterator pos, Iter first, Iter last, forward_iterator_tag);
 
     // shrink to fit
-    void reinsert(size_type n);
+    MYSTL_CONSTEXPR20 void reinsert(size_type n);
+
+    // relocation，以下函数中的按字节搬动只用于可平凡重定位的类型
+
+    // 把元素搬到容量至少为 new_cap 的空间，并在第 off 个元素处留出 gap 个未初始化的位置
+    // gap 不为 0 时要求元素可平凡重定位
+    MYSTL_CONSTEXPR20 void relocate_storage(
+        size_type new_cap, size_type off, size_type gap, m_true_type);
+    MYSTL_CONSTEXPR20 void relocate_storage(
+        size_type new_cap, size_type off, size_type gap, m_false_type);
+
+    // 在容量以内把 [pos, end) 向后搬 n 个位置，或把 [pos + n, end) 搬回 pos
+    MYSTL_CONSTEXPR20 void open_gap(iterator pos, size_type n) noexcept;
+    MYSTL_CONSTEXPR20 void close_gap(iterator pos, size_type n) noexcept;
+
+    // 先在临时空间构造新元素，再腾出位置把它按字节放进去，args 可以引用容器中的元素
+    template <typename... Args>
+    MYSTL_CONSTEXPR20 void relocate_emplace(iterator pos, Args&&... args);
 };
 
+/*****************************************************************************************/
+
+// 删除 pos 位置上的元素
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20
+typename vector<T, Alloc, Growth, Storage>::iterator
+vector<T, Alloc, Growth, Storage>::erase(const_iterator pos) {
+    MYSTL_DEBUG(pos >= begin() && pos < end());
+    iterator xpos = impl_.begin_ + (pos - begin());
+    if (use_relocate()) {
+        alloc_traits::destroy(alloc_ref(), xpos);
+        close_gap(xpos, 1);
+        return xpos;
+    }
+    mystl::move(xpos + 1, impl_.end_, xpos);
+    alloc_traits::destroy(alloc_ref(), impl_.end_ - 1);
+    --impl_.end_;
+    return xpos;
+}
+
+// 删除[first, last)上的元素
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20
+typename vector<T, Alloc, Growth, Storage>::iterator
+vector<T, Alloc, Growth, Storage>::erase(
+    const_iterator first, const_iterator last) {
+    MYSTL_DEBUG(first >= begin() && last <= end() && !(last < first));
+    // 空区间直接返回，否则下面会把 [r, end) 自移动赋值给自己
+    if (first == last)
+        return impl_.begin_ + (first - begin());
+    const auto n = first - begin();
+    iterator r = impl_.begin_ + (first - begin());
+    if (use_relocate()) {
+        mystl::destroy(r, r + (last - first));
+        close_gap(r, static_cast<size_type>(last - first));
+        return r;
+    }
+    mystl::destroy(mystl::move(r + (last - first), impl_.end_, r), impl_.end_);
+    impl_.end_ = impl_.end_ - (last - first);
+    return impl_.begin_ + n;
+}
+
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20 void vector<T, Alloc, Growth, Storage>::clear() noexcept {
+    mystl::destroy(impl_.begin_, impl_.end_);
+    impl_.end_ = impl_.begin_;
+}
+
+// 重置容器大小
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20 void vector<T, Alloc, Growth, Storage>::resize(size_type new_size) {
+    if (new_size < size()) {
+        erase(begin() + new_size, end());
+    } else {
+        value_append(new_size - size(), zero_init{});
+    }
+}
+
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20
+void vector<T, Alloc, Growth, Storage>::resize(
+    size_type new_size, const value_type& value) {
+    if (new_size < size()) {
+        erase(begin() + new_size, end());
+    } else {
+        insert(end(), new_size - size(), value);
+    }
+}
+
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20 void vector<T, Alloc, Growth, Storage>::resize_default_init(
+    size_type new_size) {
+    if (new_size < size()) {
+        erase(begin() + new_size, end());
+    } else {
+        default_append(new_size - size());
+    }
+}
+
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20
+typename vector<T, Alloc, Growth, Storage>::pointer
+vector<T, Alloc, Growth, Storage>::append_uninitialized(
+    size_type n) {
+    const size_type off = size();
+    default_append(n);
+    return impl_.begin_ + off;
+}
+
+template <typename T, typename Alloc, typename Growth, typename Storage>
+template <typename Op>
+MYSTL_CONSTEXPR20 void vector<T, Alloc, Growth, Storage>::resize_and_overwrite(
+    size_type n, Op op) {
+    static_assert(std::is_trivial<T>::value,
+        "resize_and_overwrite requires a trivial value_type");
+    if (capacity() < n)
+        relocate_storage(get_new_cap(n - size()), size(), 0, can_realloc{});
+    const auto r = static_cast<size_type>(op(impl_.begin_, n));
+    MYSTL_DEBUG(r <= n);
+    impl_.end_ = impl_.begin_ + r;
+}
+
+// 与另一个 vector 交换，propagate_on_container_swap 为 false 时要求两者的分配器相等。
+// 内联缓冲区中的元素不能交换指针，借助一个临时容器逐个搬动
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20 void vector<T, Alloc, Growth, Storage>::swap(vector& rhs) noexcept(
+    nothrow_take::value) {
+    if (this == &rhs)
+        return;
+    if (alloc_traits::propagate_on_container_swap::value) {
+        mystl::swap(alloc_ref(), rhs.alloc_ref());
+    } else {
+        MYSTL_DEBUG(alloc_ref() == rhs.alloc_ref());
+    }
+    if (!is_inline() && !rhs.is_inline()) {
+        swap_data(rhs);
+        return;
+    }
+    vector tmp(alloc_ref());
+    tmp.take_storage(rhs);
+    rhs.take_storage(*this);
+    take_storage(tmp);
+}
+
+/*****************************************************************************************/
+// helper function
+
+// try_init 函数，默认构造时不申请空间，第一次插入时再分配
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20 void vector<T, Alloc, Growth, Storage>::try_init() noexcept {
+    impl_.reset();
+}
+
+// init_space 函数，内联缓冲区放得下时不申请空间
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20 void vector<T, Alloc, Growth, Storage>::init_space(
+    size_type n, size_type cap) {
+    if (cap <= Storage::inline_size()) {
+        try_init();
+        impl_.end_ = impl_.begin_ + n;
+        return;
+    }
+    try {
+        impl_.begin_ = allocate_space(cap);
+        impl_.end_ = impl_.begin_ + n;
+        impl_.cap_ = impl_.begin_ + cap;
+    } catch (...) {
+        try_init();
+        throw;
+    }
+}
+
+// fill_init 函数
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20
+void vector<T, Alloc, Growth, Storage>::fill_init(size_type n, const value_type& value) {
+    if (n == 0) {
+        try_init();
+        return;
+    }
+    init_space(0, n);
+    try {
+        impl_.end_ = mystl::uninitialized_fill_n(impl_.begin_, n, value);
+    } catch (...) {
+        deallocate_space(impl_.begin_, capacity());
+        try_init();
+        throw;
+    }
+}
+
+// value_init 函数，分配器给出的空间已经清零，直接作为 n 个值初始化的元素
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20 void vector<T, Alloc, Growth, Storage>::value_init(
+    size_type n, m_true_type) {
+    if (n <= Storage::inline_size()) {
+        fill_init(n, value_type{});
+        return;
+    }
+    auto result = alloc_traits::allocate_zeroed(alloc_ref(), n);
+    impl_.begin_ = result.ptr;
+    impl_.end_ = result.ptr + n;
+    impl_.cap_ = result.ptr + result.count;
+}
+
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20 void vector<T, Alloc, Growth, Storage>::value_init(
+    size_type n, m_false_type) {
+    fill_init(n, value_type{});
+}
+
+// range_init 函数
+template <typename T, typename Alloc, typename Growth, typename Storage>
+template <typename Iter>
+MYSTL_CONSTEXPR20 void vector<T, Alloc, Growth, Storage>::range_init(
+    Iter first, Iter last) {
+    range_init(first, last, iterator_category(first));
+}
+
+template <typename T, typename Alloc, typename Growth, typename Storage>
+template <typename Iter>
+MYSTL_CONSTEXPR20
+void vector<T, Alloc, Growth, Storage>::range_init(
+    Iter first, Iter last, input_iterator_tag) {
+    try_init();
+    try {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+    } catch (...) {
+        destroy_and_recover(impl_.begin_, impl_.end_, capacity());
+        try_init();
+        throw;
+    }
+}
+
+template <typename T, typename Alloc, typename Growth, typename Storage>
+template <typename Iter>
+MYSTL_CONSTEXPR20
+void vector<T, Alloc, Growth, Storage>::range_init(
+    Iter first, Iter last, forward_iterator_tag) {
+    const size_type n = mystl::distance(first, last);
+    if (n == 0) {
+        try_init();
+        return;
+    }
+    init_space(0, n);
+    try {
+        impl_.end_ = mystl::uninitialized_copy(first, last, impl_.begin_);
+    } catch (...) {
+        deallocate_space(impl_.begin_, capacity());
+        try_init();
+        throw;
+    }
+}
+
+// destroy_and_recover 函数
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20
+void vector<T, Alloc, Growth, Storage>::destroy_and_recover(
+    iterator first, iterator last, size_type n) {
+    mystl::destroy(first, last);
+    deallocate_space(first, n);
+}
+
+// get_new_cap 函数，由增长策略决定扩容后的容量
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20
+typename vector<T, Alloc, Growth, Storage>::size_type
+vector<T, Alloc, Growth, Storage>::get_new_cap(
+    size_type add_size) {
+    const auto old_size = size();
+    THROW_LENGTH_ERROR_IF(
+        old_size > max_size() - add_size, "vector<T>'s size too big");
+    return growth_policy::next_capacity(
+        capacity(), old_size + add_size, sizeof(T), max_size());
+}
+
+// fill_assign 函数
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20
+void vector<T, Alloc, Growth, Storage>::fill_assign(
+    size_type n, const value_type& value) {
+    if (n > capacity()) {
+        vector tmp(n, value, alloc_ref());
+        replace_storage(tmp);
+    } else if (n > size()) {
+        mystl::fill(begin(), end(), value);
+        impl_.end_ = mystl::uninitialized_fill_n(impl_.end_, n - size(), value);
+    } else {
+        erase(mystl::fill_n(impl_.begin_, n, value), impl_.end_);
+    }
+}
+
+// copy_assign 函数
+template <typename T, typename Alloc, typename Growth, typename Storage>
+template <typename Iter>
+MYSTL_CONSTEXPR20
+void vector<T, Alloc, Growth, Storage>::copy_assign(
+    Iter first, Iter last, input_iterator_tag) {
+    auto cur = impl_.begin_;
+    for (; first != last && cur != impl_.end_; ++first, ++cur) {
+        *cur = *first;
+    }
+    if (first == last) {
+        erase(cur, impl_.end_);
+    } else {
+        copy_insert(impl_.end_, first, last, input_iterator_tag{});
+    }
+}
+
+template <typename T, typename Alloc, typename Growth, typename Storage>
+template <typename Iter>
+MYSTL_CONSTEXPR20
+void vector<T, Alloc, Growth, Storage>::copy_assign(
+    Iter first, Iter last, forward_iterator_tag) {
+    const size_type len = mystl::distance(first, last);
+    if (len > capacity()) {
+        vector tmp(first, last, alloc_ref());
+        replace_storage(tmp);
+    } else if (size() >= len) {
+        auto new_end = mystl::copy(first, last, impl_.begin_);
+        mystl::destroy(new_end, impl_.end_);
+        impl_.end_ = new_end;
+    } else {
+        auto mid = first;
+        mystl::advance(mid, size());
+        mystl::copy(first, mid, impl_.begin_);
+        impl_.end_ = mystl::uninitialized_copy(mid, last, impl_.end_);
+    }
+}
+
+// copy_assign_alloc 函数
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20
+void vector<T, Alloc, Growth, Storage>::copy_assign_alloc(
+    const vector& rhs, std::true_type) {
+    if (alloc_ref() != rhs.alloc_ref()) {
+        // 旧的空间必须由旧的分配器释放
+        destroy_and_recover(impl_.begin_, impl_.end_, capacity());
+        try_init();
+    }
+    alloc_ref() = rhs.alloc_ref();
+}
+
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20 void vector<T, Alloc, Growth, Storage>::copy_assign_alloc(
+    const vector&, std::false_type) {}
+
+// move_assign 函数，可以直接接管 rhs 的空间
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20 void vector<T, Alloc, Growth, Storage>::move_assign(
+    vector& rhs, m_true_type) noexcept(nothrow_take::value) {
+    destroy_and_recover(impl_.begin_, impl_.end_, capacity());
+    try_init();
+    if (alloc_traits::propagate_on_container_move_assignment::value) {
+        alloc_ref() = mystl::move(rhs.alloc_ref());
+    }
+    take_storage(rhs);
+}
+
+// 分配器不传播且可能不相等时，只有分配器相等才能接管空间，否则逐个移动元素
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20 void vector<T, Alloc, Growth, Storage>::move_assign(
+    vector& rhs, m_false_type) {
+    if (alloc_ref() == rhs.alloc_ref()) {
+        move_assign(rhs, m_true_type{});
+    } else {
+        vector tmp(mystl::move(rhs), alloc_ref());
+        replace_storage(tmp);
+    }
+}
+
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20 void vector<T, Alloc, Growth, Storage>::swap_data(
+    vector& rhs) noexcept {
+    mystl::swap(impl_.begin_, rhs.impl_.begin_);
+    mystl::swap(impl_.end_, rhs.impl_.end_);
+    mystl::swap(impl_.cap_, rhs.impl_.cap_);
+}
+
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20 void vector<T, Alloc, Growth, Storage>::take_storage(
+    vector& rhs) noexcept(nothrow_take::value) {
+    if (!rhs.is_inline()) {
+        impl_.begin_ = rhs.impl_.begin_;
+        impl_.end_ = rhs.impl_.end_;
+        impl_.cap_ = rhs.impl_.cap_;
+        rhs.try_init();
+        return;
+    }
+    impl_.end_ =
+        mystl::uninitialized_relocate(rhs.impl_.begin_, rhs.impl_.end_, impl_.begin_);
+    rhs.impl_.end_ = rhs.impl_.begin_;
+}
+
+// 重新分配空间并在 pos 处就地构造元素
+template <typename T, typename Alloc, typename Growth, typename Storage>
+template <typename... Args>
+MYSTL_CONSTEXPR20
+void vector<T, Alloc, Growth, Storage>::reallocate_emplace(iterator pos, Args&&... args) {
+    if (use_relocate()) {
+        relocate_emplace(pos, mystl::forward<Args>(args)...);
+        return;
+    }
+    const size_type xpos = pos - impl_.begin_;
+    auto new_size = get_new_cap(1);
+    auto new_begin = allocate_space(new_size);
+    try {
+        // 先构造新元素，args 可能引用了旧空间中的元素
+        alloc_traits::construct(alloc_ref(), mystl::address_of(*(new_begin + xpos)),
+            mystl::forward<Args>(args)...);
+    } catch (...) {
+        alloc_traits::deallocate(alloc_ref(), new_begin, new_size);
+        throw;
+    }
+    auto new_end = reallocate_around(pos, new_begin, new_size);
+    destroy_and_recover(impl_.begin_, impl_.end_, capacity());
+    impl_.begin_ = new_begin;
+    impl_.end_ = new_end;
+    impl_.cap_ = new_begin + new_size;
+}
+
+// 新元素已经构造在 new_begin + (pos - begin()) 处，把原有的元素移到它的两侧，返回新的尾部。
+// 移动抛出异常时析构新空间中已经构造的元素 (包括新元素) 并释放新空间
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20 typename vector<T, Alloc, Growth, Storage>::iterator
+vector<T, Alloc, Growth, Storage>::reallocate_around(
+    iterator pos, iterator new_begin, size_type new_size) {
+    const size_type xpos = pos - impl_.begin_;
+    auto front_end = new_begin;
+    try {
+        front_end = mystl::uninitialized_move(impl_.begin_, pos, new_begin);
+        return mystl::uninitialized_move(pos, impl_.end_, front_end + 1);
+    } catch (...) {
+        mystl::destroy(new_begin, front_end);
+        alloc_traits::destroy(alloc_ref(), new_begin + xpos);
+        alloc_traits::deallocate(alloc_ref(), new_begin, new_size);
+        throw;
+    }
+}
+
+// 重新分配空间并在 pos 处插入元素
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20
+void vector<T, Alloc, Growth, Storage>::reallocate_insert(
+    iterator pos, const value_type& value) {
+    if (use_relocate()) {
+        relocate_emplace(pos, value);
+        return;
+    }
+    const size_type xpos = pos - impl_.begin_;
+    auto new_size = get_new_cap(1);
+    auto new_begin = allocate_space(new_size);
+    try {
+        alloc_traits::construct(
+            alloc_ref(), mystl::address_of(*(new_begin + xpos)), value);
+    } catch (...) {
+        alloc_traits::deallocate(alloc_ref(), new_begin, new_size);
+        throw;
+    }
+    auto new_end = reallocate_around(pos, new_begin, new_size);
+    destroy_and_recover(impl_.begin_, impl_.end_, capacity());
+    impl_.begin_ = new_begin;
+    impl_.end_ = new_end;
+    impl_.cap_ = new_begin + new_size;
+}
+
+// fill_insert 函数
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20
+typename vector<T, Alloc, Growth, Storage>::iterator
+vector<T, Alloc, Growth, Storage>::fill_insert(
+    iterator pos, size_type n, const value_type& value) {
+    if (n == 0)
+        return pos;
+    const size_type xpos = pos - impl_.begin_;
+    const value_type value_copy = value; // 避免被覆盖
+    if (use_relocate()) {
+        // 腾出 n 个位置后直接在其中构造，失败时把后面的元素搬回去
+        if (static_cast<size_type>(impl_.cap_ - impl_.end_) >= n) {
+            open_gap(pos, n);
+        } else {
+            relocate_storage(get_new_cap(n), xpos, n, can_realloc{});
+        }
+        iterator gap = impl_.begin_ + xpos;
+        try {
+            mystl::uninitialized_fill_n(gap, n, value_copy);
+        } catch (...) {
+            close_gap(gap, n);
+            throw;
+        }
+        return gap;
+    }
+    if (static_cast<size_type>(impl_.cap_ - impl_.end_) >= n) {
+        // 如果备用空间大于等于增加的空间
+        const size_type after_elems = impl_.end_ - pos;
+        auto old_end = impl_.end_;
+        if (after_elems > n) {
+            mystl::uninitialized_move(impl_.end_ - n, impl_.end_, impl_.end_);
+            impl_.end_ += n;
+            mystl::move_backward(pos, old_end - n, old_end);
+            mystl::fill_n(pos, n, value_copy);
+        } else {
+            impl_.end_ = mystl::uninitialized_fill_n(impl_.end_, n - after_elems, value_copy);
+            impl_.end_ = mystl::uninitialized_move(pos, old_end, impl_.end_);
+            mystl::fill_n(pos, after_elems, value_copy);
+        }
+    } else {
+        // 如果备用空间不足
+        auto new_size = get_new_cap(n);
+        auto new_begin = allocate_space(new_size);
+        auto new_end = new_begin;
+        try {
+            new_end = mystl::uninitialized_move(impl_.begin_, pos, new_begin);
+            new_end = mystl::uninitialized_fill_n(new_end, n, value_copy);
+            new_end = mystl::uninitialized_move(pos, impl_.end_, new_end);
+        } catch (...) {
+            destroy_and_recover(new_begin, new_end, new_size);
+            throw;
+        }
+        destroy_and_recover(impl_.begin_, impl_.end_, capacity());
+        impl_.begin_ = new_begin;
+        impl_.end_ = new_end;
+        impl_.cap_ = impl_.begin_ + new_size;
+    }
+
+    return impl_.begin_ + xpos;
+}
+
+// default_append 函数，容量不足时按增长策略扩容
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20 void vector<T, Alloc, Growth, Storage>::default_append(size_type n) {
+    if (n == 0)
+        return;
+    if (static_cast<size_type>(impl_.cap_ - impl_.end_) < n)
+        relocate_storage(get_new_cap(n), size(), 0, can_realloc{});
+    impl_.end_ = mystl::uninitialized_default_construct_n(impl_.end_, n);
+}
+
+// copy_insert 函数
+template <typename T, typename Alloc, typename Growth, typename Storage>
+template <typename Iter>
+MYSTL_CONSTEXPR20
+typename vector<T, Alloc, Growth, Storage>::iterator
+vector<T, Alloc, Growth, Storage>::copy_insert(
+    iterator pos, Iter first, Iter last) {
+    return copy_insert(pos, first, last, iterator_category(first));
+}
+
+// 元素个数未知：追加到尾部时逐个 emplace_back，插入到中间时先收集到临时的 vector 再一次插入
+template <typename T, typename Alloc, typename Growth, typename Storage>
+template <typename Iter>
+MYSTL_CONSTEXPR20
+typename vector<T, Alloc, Growth, Storage>::iterator
+vector<T, Alloc, Growth, Storage>::copy_insert(
+    iterator pos, Iter first, Iter last, input_iterator_tag) {
+    const size_type xpos = pos - impl_.begin_;
+    if (pos == impl_.end_) {
+        for (; first != last; ++first) {
+            emplace_back(*first);
+        }
+        return impl_.begin_ + xpos;
+    }
+    vector tmp(alloc_ref());
+    for (; first != last; ++first) {
+        tmp.emplace_back(*first);
+    }
+    return copy_insert(pos, tmp.begin(), tmp.end(), forward_iterator_tag{});
+}
+
+// 元素个数已知：容量不足时只扩容一次，新元素直接构造在新空间中
+template <typename T, typename Alloc, typename Growth, typename Storage>
+template <typename Iter>
+MYSTL_CONSTEXPR20
+typename vector<T, Alloc, Growth, Storage>::iterator
+vector<T, Alloc, Growth, Storage>::copy_insert(
+    iterator pos, Iter first, Iter last, forward_iterator_tag) {
+    const size_type xpos = pos - impl_.begin_;
+    const size_type n = mystl::distance(first, last);
+    if (n == 0)
+        return pos;
+    if (use_relocate()) {
+        // 腾出 n 个位置后直接在其中构造，失败时把后面的元素搬回去
+        if (static_cast<size_type>(impl_.cap_ - impl_.end_) >= n) {
+            open_gap(pos, n);
+        } else {
+            relocate_storage(get_new_cap(n), xpos, n, can_realloc{});
+        }
+        iterator gap = impl_.begin_ + xpos;
+        try {
+            mystl::uninitialized_copy(first, last, gap);
+        } catch (...) {
+            close_gap(gap, n);
+            throw;
+        }
+        return gap;
+    }
+    if (static_cast<size_type>(impl_.cap_ - impl_.end_) >= n) {
+        // 如果备用空间大于等于增加的空间
+        const size_type after_elems = impl_.end_ - pos;
+        auto old_end = impl_.end_;
+        if (after_elems > n) {
+            impl_.end_ = mystl::uninitialized_move(impl_.end_ - n, impl_.end_, impl_.end_);
+            mystl::move_backward(pos, old_end - n, old_end);
+            mystl::copy(first, last, pos);
+        } else {
+            auto mid = first;
+            mystl::advance(mid, after_elems);
+            impl_.end_ = mystl::uninitialized_copy(mid, last, impl_.end_);
+            impl_.end_ = mystl::uninitialized_move(pos, old_end, impl_.end_);
+            mystl::copy(first, mid, pos);
+        }
+    } else {
+        // 如果备用空间不足，先在新空间中构造新元素，再把原有的元素移到两侧
+        auto new_cap = get_new_cap(n);
+        auto new_begin = allocate_space(new_cap);
+        auto new_end = new_begin + xpos;
+        try {
+            new_end = mystl::uninitialized_copy(first, last, new_end);
+        } catch (...) {
+            alloc_traits::deallocate(alloc_ref(), new_begin, new_cap);
+            throw;
+        }
+        auto mid_end = new_end;
+        auto front_end = new_begin;
+        try {
+            front_end = mystl::uninitialized_move(impl_.begin_, pos, new_begin);
+            new_end = mystl::uninitialized_move(pos, impl_.end_, new_end);
+        } catch (...) {
+            mystl::destroy(new_begin, front_end);
+            mystl::destroy(new_begin + xpos, mid_end);
+            alloc_traits::deallocate(alloc_ref(), new_begin, new_cap);
+            throw;
+        }
+        destroy_and_recover(impl_.begin_, impl_.end_, capacity());
+        impl_.begin_ = new_begin;
+        impl_.end_ = new_end;
+        impl_.cap_ = new_begin + new_cap;
+    }
+    return impl_.begin_ + xpos;
+}
+
+// value_append 函数，容量足够时清零尾部，否则在清零的新空间上复制原有的元素
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20 void vector<T, Alloc, Growth, Storage>::value_append(
+    size_type n, m_true_type) {
+    if (mystl::is_constant_evaluated()) {
+        value_append(n, m_false_type{});
+        return;
+    }
+    if (n == 0)
+        return;
+    if (static_cast<size_type>(impl_.cap_ - impl_.end_) >= n) {
+        std::memset(static_cast<void*>(impl_.end_), 0, n * sizeof(T));
+        impl_.end_ += n;
+        return;
+    }
+    const size_type old_size = size();
+    auto result = alloc_traits::allocate_zeroed(alloc_ref(), get_new_cap(n));
+    if (old_size != 0) {
+        std::memcpy(static_cast<void*>(result.ptr), static_cast<const void*>(impl_.begin_),
+            old_size * sizeof(T));
+    }
+    deallocate_space(impl_.begin_, capacity());
+    impl_.begin_ = result.ptr;
+    impl_.end_ = result.ptr + old_size + n;
+    impl_.cap_ = result.ptr + result.count;
+}
+
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20 void vector<T, Alloc, Growth, Storage>::value_append(
+    size_type n, m_false_type) {
+    insert(end(), n, value_type{});
+}
+
+// reinsert 函数，n 个元素放得进内联缓冲区时搬回内联缓冲区 (vector 中 n 为 0 时为空指针)
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20 void vector<T, Alloc, Growth, Storage>::reinsert(size_type n) {
+    const bool to_inline = n <= Storage::inline_size();
+    auto new_begin =
+        to_inline ? impl_.inline_data() : alloc_traits::allocate(alloc_ref(), n);
+    try {
+        mystl::uninitialized_relocate(impl_.begin_, impl_.end_, new_begin);
+    } catch (...) {
+        deallocate_space(new_begin, n);
+        throw;
+    }
+    deallocate_space(impl_.begin_, capacity());
+    impl_.begin_ = new_begin;
+    impl_.end_ = new_begin + n;
+    impl_.cap_ = new_begin + (to_inline ? Storage::inline_size() : n);
+}
+
+// 分配器支持 reallocate：原地扩容，再把 off 之后的元素向后搬出 gap 个位置
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20 void vector<T, Alloc, Growth, Storage>::relocate_storage(
+    size_type new_cap, size_type off, size_type gap, m_true_type) {
+    // 内联缓冲区不是分配器给出的空间，不能交给 reallocate
+    if (mystl::is_constant_evaluated() || is_inline()) {
+        relocate_storage(new_cap, off, gap, m_false_type{});
+        return;
+    }
+    const size_type old_size = size();
+    auto result = alloc_traits::reallocate(alloc_ref(), impl_.begin_, capacity(), new_cap);
+    impl_.begin_ = result.ptr;
+    impl_.end_ = result.ptr + old_size;
+    impl_.cap_ = result.ptr + result.count;
+    if (gap != 0)
+        open_gap(impl_.begin_ + off, gap);
+}
+
+// 申请新空间，把 [begin, begin + off) 和 [begin + off, end) 分别搬到空位的两侧
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20 void vector<T, Alloc, Growth, Storage>::relocate_storage(
+    size_type new_cap, size_type off, size_type gap, m_false_type) {
+    const size_type old_size = size();
+    auto new_begin = allocate_space(new_cap);
+    try {
+        mystl::uninitialized_relocate(impl_.begin_, impl_.begin_ + off, new_begin);
+        mystl::uninitialized_relocate(
+            impl_.begin_ + off, impl_.end_, new_begin + off + gap);
+    } catch (...) {
+        alloc_traits::deallocate(alloc_ref(), new_begin, new_cap);
+        throw;
+    }
+    deallocate_space(impl_.begin_, capacity());
+    impl_.begin_ = new_begin;
+    impl_.end_ = new_begin + old_size + gap;
+    impl_.cap_ = new_begin + new_cap;
+}
+
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20
+void vector<T, Alloc, Growth, Storage>::open_gap(iterator pos, size_type n) noexcept {
+    const auto count = static_cast<size_t>(impl_.end_ - pos);
+    if (count != 0)
+        std::memmove(static_cast<void*>(pos + n), static_cast<const void*>(pos),
+            count * sizeof(T));
+    impl_.end_ += n;
+}
+
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20
+void vector<T, Alloc, Growth, Storage>::close_gap(iterator pos, size_type n) noexcept {
+    const auto count = static_cast<size_t>(impl_.end_ - (pos + n));
+    if (count != 0)
+        std::memmove(static_cast<void*>(pos), static_cast<const void*>(pos + n),
+            count * sizeof(T));
+    impl_.end_ -= n;
+}
+
+template <typename T, typename Alloc, typename Growth, typename Storage>
+template <typename... Args>
+MYSTL_CONSTEXPR20
+void vector<T, Alloc, Growth, Storage>::relocate_emplace(iterator pos, Args&&... args) {
+    alignas(T) unsigned char buffer[sizeof(T)];
+    T* tmp = reinterpret_cast<T*>(buffer);
+    alloc_traits::construct(alloc_ref(), tmp, mystl::forward<Args>(args)...);
+    const size_type off = pos - impl_.begin_;
+    if (impl_.end_ != impl_.cap_) {
+        open_gap(pos, 1);
+    } else {
+        try {
+            relocate_storage(get_new_cap(1), off, 1, can_realloc{});
+        } catch (...) {
+            alloc_traits::destroy(alloc_ref(), tmp);
+            throw;
+        }
+    }
+    std::memcpy(static_cast<void*>(impl_.begin_ + off), static_cast<const void*>(tmp),
+        sizeof(T));
+}
+
+// 重载 mystl 的 swap
+template <typename T, typename Alloc, typename Growth, typename Storage>
+MYSTL_CONSTEXPR20 void swap(vector<T, Alloc, Growth, Storage>& lhs,
+    vector<T, Alloc, Growth, Storage>& rhs) noexcept(noexcept(lhs.swap(rhs))) {
+    lhs.swap(rhs);
+}
+
+namespace pmr {
+
+// 使用 polymorphic_allocator 的 vector，不同内存资源上的 vector 属于同一类型
+template <typename T>
+using vector = mystl::vector<T, polymorphic_allocator<T>>;
+
+} // namespace pmr
+
 } // namespace mystl